@@ -0,0 +1,273 @@
+/**
+ * @file BCM_LED.c
+ *
+ * @brief Source code for the BCM_LED driver.
+ *
+ * This file contains the function definitions for the BCM_LED driver.
+ * It uses Binary Code Modulation (BCM) with Timer 2A to dim the EduBase Board LEDs (PB0 - PB3)
+ * and the RGB LED (PF1 - PF3) with 8-bit resolution.
+ *
+ * @note The prescale value is derived from the system clock frequency in Clock.h.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "BCM_LED.h"
+#include "Clock.h"
+#include "Interrupts.h"
+#include "HAL.h"
+
+// Timer 2A counts at 1 MHz, and the longest slot must fit in its 16-bit interval load register
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_TICK_VALID(1000000), timer_2a_tick);
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_PERIOD_VALID(BCM_LED_BASE_TICKS << (BCM_LED_BITS - 1)), bcm_longest_slot);
+
+// Pins driven by the BCM_LED driver on Port B and Port F
+static uint8_t port_b_enable = 0x00;
+static uint8_t port_f_enable = 0x00;
+
+// Channel levels, fade state and the flag indicating that the bit planes must be rebuilt
+static volatile uint8_t channel_level[BCM_LED_CHANNEL_COUNT];
+static volatile uint16_t fade_level_q8[BCM_LED_CHANNEL_COUNT];
+static volatile int16_t fade_step_q8[BCM_LED_CHANNEL_COUNT];
+static volatile uint8_t fade_target[BCM_LED_CHANNEL_COUNT];
+static volatile uint16_t fade_frames[BCM_LED_CHANNEL_COUNT];
+static volatile uint8_t planes_dirty = 0;
+
+// Double-buffered bit planes: plane k holds bit k of every channel level
+static uint8_t port_b_planes[2][BCM_LED_BITS];
+static uint8_t port_f_planes[2][BCM_LED_BITS];
+static uint8_t active_planes = 0;
+
+// Slot currently being output
+static uint8_t current_slot = 0;
+
+static void BCM_LED_Rebuild_Planes(void)
+{
+	uint8_t next_planes = active_planes ^ 1;
+
+	for (int k = 0; k < BCM_LED_BITS; k++)
+	{
+		uint8_t port_b_bits = 0x00;
+		uint8_t port_f_bits = 0x00;
+
+		// PB0 - PB3 use channels 0 to 3, PF1 - PF3 use channels 4 to 6
+		for (int channel = 0; channel < BCM_LED_CHANNEL_PF1; channel++)
+		{
+			if ((channel_level[channel] >> k) & 0x01)
+			{
+				port_b_bits |= (1 << channel);
+			}
+		}
+		for (int channel = BCM_LED_CHANNEL_PF1; channel < BCM_LED_CHANNEL_COUNT; channel++)
+		{
+			if ((channel_level[channel] >> k) & 0x01)
+			{
+				port_f_bits |= (1 << (channel - 3));
+			}
+		}
+
+		port_b_planes[next_planes][k] = port_b_bits & port_b_enable;
+		port_f_planes[next_planes][k] = port_f_bits & port_f_enable;
+	}
+
+	// The new planes are used starting with slot 0 of the next frame
+	active_planes = next_planes;
+}
+
+static void BCM_LED_Update_Frame(void)
+{
+	// Advance the fades by one frame
+	for (int channel = 0; channel < BCM_LED_CHANNEL_COUNT; channel++)
+	{
+		if (fade_frames[channel] > 0)
+		{
+			fade_frames[channel]--;
+
+			if (fade_frames[channel] == 0)
+			{
+				fade_level_q8[channel] = (uint16_t)(fade_target[channel] << 8);
+			}
+			else
+			{
+				fade_level_q8[channel] = (uint16_t)(fade_level_q8[channel] + fade_step_q8[channel]);
+			}
+
+			channel_level[channel] = (uint8_t)(fade_level_q8[channel] >> 8);
+			planes_dirty = 1;
+		}
+	}
+
+	if (planes_dirty)
+	{
+		planes_dirty = 0;
+		BCM_LED_Rebuild_Planes();
+	}
+}
+
+void BCM_LED_Init(uint8_t channel_mask)
+{
+	port_b_enable = channel_mask & BCM_LED_MASK_HUNGER_BAR;
+	port_f_enable = (channel_mask >> 3) & 0x0E;
+
+	for (int channel = 0; channel < BCM_LED_CHANNEL_COUNT; channel++)
+	{
+		channel_level[channel] = BCM_LED_LEVEL_OFF;
+		fade_frames[channel] = 0;
+	}
+	BCM_LED_Rebuild_Planes();
+
+	// Configure the selected EduBase Board LED pins (PB0 - PB3) as digital outputs
+	if (port_b_enable)
+	{
+		SYSCTL->RCGCGPIO |= 0x02;
+		GPIOB->DIR |= port_b_enable;
+		GPIOB->AFSEL &= ~port_b_enable;
+		GPIOB->DEN |= port_b_enable;
+		GPIOB->DATA &= ~port_b_enable;
+	}
+
+	// Configure the selected RGB LED pins (PF1 - PF3) as digital outputs
+	if (port_f_enable)
+	{
+		SYSCTL->RCGCGPIO |= 0x20;
+		GPIOF->DIR |= port_f_enable;
+		GPIOF->AFSEL &= ~port_f_enable;
+		GPIOF->DEN |= port_f_enable;
+		GPIOF->DATA &= ~port_f_enable;
+	}
+
+	// Set the R2 bit (Bit 2) in the RCGCTIMER register to enable the clock for Timer 2A
+	SYSCTL->RCGCTIMER |= 0x04;
+
+	// Clear the TAEN bit (Bit 0) of the GPTMCTL register to disable Timer 2A
+	TIMER2->CTL &= ~0x01;
+
+	// 0x4 = Select the 16-bit timer configuration
+	TIMER2->CFG |= 0x04;
+
+	// 0x2 = Periodic Timer Mode
+	// Set the TAILD bit (Bit 8) so that a new load value only takes effect at the next time-out.
+	// This lets the handler preload the duration of the following slot without adding jitter.
+	TIMER2->TAMR |= 0x102;
+
+	// New timer clock frequency = (CLOCK_SYSTEM_HZ / (prescale value + 1)) = 1 MHz
+	TIMER2->TAPR &= ~0x000000FF;
+	TIMER2->TAPR = CLOCK_TIMER_PRESCALE(1000000);
+
+	// Slot 0 is loaded when the timer is enabled
+	current_slot = 0;
+	TIMER2->TAILR = BCM_LED_BASE_TICKS - 1;
+
+	// Clear the time-out flag and enable the Timer 2A time-out interrupt
+	TIMER2->ICR |= 0x01;
+	TIMER2->IMR |= 0x01;
+
+	// The priority of IRQ 23 is set and the IRQ is enabled by Interrupts_Init (Interrupts.h)
+
+	// Enable Timer 2A and preload the duration of slot 1
+	TIMER2->CTL |= 0x01;
+	TIMER2->TAILR = (BCM_LED_BASE_TICKS << 1) - 1;
+}
+
+INTERRUPTS_RAMFUNC void BCM_LED_Set_Level(uint8_t channel, uint8_t level)
+{
+	if (channel >= BCM_LED_CHANNEL_COUNT)
+	{
+		return;
+	}
+
+	fade_frames[channel] = 0;
+	channel_level[channel] = level;
+	planes_dirty = 1;
+}
+
+uint8_t BCM_LED_Get_Level(uint8_t channel)
+{
+	if (channel >= BCM_LED_CHANNEL_COUNT)
+	{
+		return BCM_LED_LEVEL_OFF;
+	}
+
+	return channel_level[channel];
+}
+
+void BCM_LED_Fade(uint8_t channel, uint8_t target_level, uint16_t duration_ms)
+{
+	if (channel >= BCM_LED_CHANNEL_COUNT)
+	{
+		return;
+	}
+
+	if (duration_ms == 0)
+	{
+		BCM_LED_Set_Level(channel, target_level);
+		return;
+	}
+
+	// Stop any fade in progress before changing the fade parameters
+	fade_frames[channel] = 0;
+
+	fade_level_q8[channel] = (uint16_t)(channel_level[channel] << 8);
+	fade_step_q8[channel] = (int16_t)((((int32_t)target_level - channel_level[channel]) << 8) / duration_ms);
+	fade_target[channel] = target_level;
+
+	// Start the fade last so that the handler never sees half-updated parameters
+	fade_frames[channel] = duration_ms;
+}
+
+void BCM_LED_Set_Hunger_Bar(uint8_t led_value)
+{
+	for (int channel = BCM_LED_CHANNEL_PB0; channel <= BCM_LED_CHANNEL_PB3; channel++)
+	{
+		if (led_value & (1 << channel))
+		{
+			BCM_LED_Set_Level(channel, BCM_LED_LEVEL_FULL);
+		}
+		else
+		{
+			BCM_LED_Set_Level(channel, BCM_LED_LEVEL_OFF);
+		}
+	}
+}
+
+void BCM_LED_Set_RGB(uint8_t red, uint8_t green, uint8_t blue)
+{
+	if (port_f_enable & 0x02)
+	{
+		BCM_LED_Set_Level(BCM_LED_CHANNEL_PF1, red);
+	}
+	if (port_f_enable & 0x04)
+	{
+		BCM_LED_Set_Level(BCM_LED_CHANNEL_PF2, blue);
+	}
+	if (port_f_enable & 0x08)
+	{
+		BCM_LED_Set_Level(BCM_LED_CHANNEL_PF3, green);
+	}
+}
+
+INTERRUPTS_RAMFUNC void TIMER2A_Handler(void)
+{
+	// Read the Timer 2A time-out interrupt flag
+	if (HAL_Timer_Pending(HAL_TIMER_2A))
+	{
+		// Acknowledge the Timer 2A interrupt and clear it
+		HAL_Timer_Clear(HAL_TIMER_2A);
+
+		// The timer has already reloaded with the duration of the next slot
+		current_slot = (current_slot + 1) & (BCM_LED_BITS - 1);
+
+		// Output the bit plane of the new slot without affecting the other pins
+		HAL_GPIO_Write(HAL_PIN_PORT(HAL_PIN_HUNGER_LEDS), port_b_enable, port_b_planes[active_planes][current_slot]);
+		HAL_GPIO_Write(HAL_PIN_PORT(HAL_PIN_RGB_LED), port_f_enable, port_f_planes[active_planes][current_slot]);
+
+		// Preload the duration of the slot after this one
+		TIMER2->TAILR = (BCM_LED_BASE_TICKS << ((current_slot + 1) & (BCM_LED_BITS - 1))) - 1;
+
+		// Slot 7 is the longest slot, so the per-frame work is done here
+		if (current_slot == (BCM_LED_BITS - 1))
+		{
+			BCM_LED_Update_Frame();
+		}
+	}
+}
@@ -0,0 +1,150 @@
+/**
+ * @file BCM_LED.h
+ *
+ * @brief Header file for the BCM_LED driver.
+ *
+ * This file contains the function definitions for the BCM_LED driver.
+ * It uses Binary Code Modulation (BCM) to dim a set of GPIO outputs with 8-bit resolution:
+ *  - EduBase Board LEDs (LED0 - LED3)     PB0 - PB3
+ *  - User LED (RGB) LaunchPad            PF1 - PF3
+ *
+ * Each frame is split into 8 slots. Slot k lasts (BCM_LED_BASE_TICKS << k) timer ticks and
+ * outputs bit k of every channel level, so an 8-bit level only needs 8 interrupts per frame
+ * instead of the 256 interrupts that a counter-based software PWM would need.
+ *
+ * Timer 2A is used as the slot timer. With a 1 us timer tick and a 4 us base slot,
+ * the frame period is (4 us * 255) = 1.02 ms (about 980 Hz, flicker-free).
+ *
+ * ISR rate and estimated CPU load (80 MHz system clock):
+ *  - ISR rate: 8 interrupts per frame = ~7840 interrupts per second, independent of the channel count
+ *  - Slot ISR: ~60 cycles including entry and exit, since the bit planes are precomputed
+ *  - Frame ISR (slot 7): ~60 cycles + ~50 cycles per enabled channel when a level or fade changes
+ *
+ *  Channels    CPU load (idle levels)    CPU load (all channels fading)
+ *  1           ~0.6 %                    ~0.7 %
+ *  4           ~0.6 %                    ~0.8 %
+ *  7           ~0.6 %                    ~1.0 %
+ *
+ * For comparison, a counter-based software PWM with the same 8-bit resolution and frame rate
+ * would need a 250 kHz interrupt (about 20 % CPU load) for any number of channels.
+ *
+ * @note The figures above are cycle estimates derived from the instruction count of the handler.
+ *
+ * @note The timer tick is derived from the system clock frequency in Clock.h.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+// Channel numbers used by the BCM_LED driver
+#define BCM_LED_CHANNEL_PB0     0
+#define BCM_LED_CHANNEL_PB1     1
+#define BCM_LED_CHANNEL_PB2     2
+#define BCM_LED_CHANNEL_PB3     3
+#define BCM_LED_CHANNEL_PF1     4
+#define BCM_LED_CHANNEL_PF2     5
+#define BCM_LED_CHANNEL_PF3     6
+#define BCM_LED_CHANNEL_COUNT   7
+
+// Channel masks used to select which channels are driven by the BCM_LED driver
+#define BCM_LED_MASK_HUNGER_BAR 0x0F
+#define BCM_LED_MASK_RED        0x10
+#define BCM_LED_MASK_BLUE       0x20
+#define BCM_LED_MASK_GREEN      0x40
+#define BCM_LED_MASK_ALL        0x7F
+
+// Number of bits per channel level and duration of the shortest slot in timer ticks (1 us)
+#define BCM_LED_BITS            8
+#define BCM_LED_BASE_TICKS      4
+
+#define BCM_LED_LEVEL_OFF       0
+#define BCM_LED_LEVEL_FULL      255
+
+/**
+ * @brief Initializes the BCM_LED driver and starts Timer 2A.
+ *
+ * This function configures the selected channels as digital outputs, clears all channel levels
+ * and starts Timer 2A in periodic mode to generate the BCM slot interrupts. Channels that are
+ * not selected are never written by the driver, so they can still be used by other drivers.
+ * The interrupt has the highest priority in Interrupts.h, so that the slot boundaries have the lowest
+ * possible jitter.
+ *
+ * @param channel_mask A bit mask of the channels to drive (for example, BCM_LED_MASK_HUNGER_BAR).
+ *
+ * @return None
+ */
+void BCM_LED_Init(uint8_t channel_mask);
+
+/**
+ * @brief Sets the brightness level of a single channel.
+ *
+ * Any fade in progress on the channel is cancelled. The new level is applied at the next frame.
+ *
+ * @param channel The channel number (BCM_LED_CHANNEL_PB0 - BCM_LED_CHANNEL_PF3).
+ * @param level The brightness level from 0 (off) to 255 (fully on).
+ *
+ * @return None
+ */
+void BCM_LED_Set_Level(uint8_t channel, uint8_t level);
+
+/**
+ * @brief Returns the current brightness level of a single channel.
+ *
+ * @param channel The channel number (BCM_LED_CHANNEL_PB0 - BCM_LED_CHANNEL_PF3).
+ *
+ * @return The brightness level from 0 (off) to 255 (fully on).
+ */
+uint8_t BCM_LED_Get_Level(uint8_t channel);
+
+/**
+ * @brief Fades a single channel from its current level to a target level.
+ *
+ * The fade is advanced once per frame inside the Timer 2A interrupt, so it continues
+ * while the main loop is blocked in a delay.
+ *
+ * @param channel The channel number (BCM_LED_CHANNEL_PB0 - BCM_LED_CHANNEL_PF3).
+ * @param target_level The brightness level reached at the end of the fade.
+ * @param duration_ms The duration of the fade in milliseconds (one frame is about 1 ms).
+ *
+ * @return None
+ */
+void BCM_LED_Fade(uint8_t channel, uint8_t target_level, uint16_t duration_ms);
+
+/**
+ * @brief Sets the EduBase Board LEDs (PB0 - PB3) fully on or off from a bit mask.
+ *
+ * This is the BCM equivalent of EduBase_LEDs_Output. Bits that are set turn the LED fully on
+ * and bits that are cleared turn the LED off.
+ *
+ * @param led_value A 4-bit value where each bit represents one EduBase Board LED.
+ *
+ * @return None
+ */
+void BCM_LED_Set_Hunger_Bar(uint8_t led_value);
+
+/**
+ * @brief Sets the color of the RGB LED (PF1 - PF3).
+ *
+ * Only the RGB channels that were selected in BCM_LED_Init are updated.
+ *
+ * @param red The brightness level of the red LED (PF1).
+ * @param green The brightness level of the green LED (PF3).
+ * @param blue The brightness level of the blue LED (PF2).
+ *
+ * @return None
+ */
+void BCM_LED_Set_RGB(uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief The interrupt service routine (ISR) for Timer 2A.
+ *
+ * This function outputs the bit plane of the slot that has just started and preloads
+ * the duration of the following slot. At the start of the longest slot it also advances
+ * the fades and rebuilds the bit planes if any channel level has changed.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void TIMER2A_Handler(void);
@@ -0,0 +1,74 @@
+/**
+ * @file Clock.c
+ *
+ * @brief Source code for the system clock configuration.
+ *
+ * This file contains the function definitions for the system clock configuration. RCC2 is used
+ * instead of RCC, since only RCC2 has the DIV400 divider needed for 80 MHz. With DIV400 set,
+ * SYSDIV2 and SYSDIV2LSB form a 7-bit field that holds the PLL divisor minus 1.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Clock.h"
+
+// RCC: MOSCDIS (Bit 0) disables the main oscillator, and XTAL (Bits 10 to 6) = 0x15 selects a 16 MHz crystal
+#define RCC_MOSCDIS             0x00000001
+#define RCC_XTAL_MASK           0x000007C0
+#define RCC_XTAL_16MHZ          (0x15 << 6)
+
+// RCC2: OSCSRC2 (Bits 6 to 4), BYPASS2 (Bit 11), PWRDN2 (Bit 13), SYSDIV2 and SYSDIV2LSB (Bits 28 to 22),
+// DIV400 (Bit 30) and USERCC2 (Bit 31)
+#define RCC2_OSCSRC2_MASK       0x00000070
+#define RCC2_OSCSRC2_PIOSC      (0x1 << 4)
+#define RCC2_BYPASS2            0x00000800
+#define RCC2_PWRDN2             0x00002000
+#define RCC2_SYSDIV_MASK        0x1FC00000
+#define RCC2_SYSDIV_SHIFT       22
+#define RCC2_DIV400             0x40000000
+#define RCC2_USERCC2            0x80000000
+
+// PLLSTAT: LOCK (Bit 0) is set once the PLL has locked
+#define PLLSTAT_LOCK            0x01
+
+CLOCK_STATIC_ASSERT((CLOCK_PLL_HZ % CLOCK_SYSTEM_HZ) == 0, system_clock_divides_pll);
+CLOCK_STATIC_ASSERT(CLOCK_PLL_DIVISOR >= 5 && CLOCK_PLL_DIVISOR <= 128, pll_divisor_range);
+
+void Clock_Init(void)
+{
+	// Use RCC2, and run the system from the oscillator while the PLL is configured
+	SYSCTL->RCC2 |= RCC2_USERCC2 | RCC2_BYPASS2;
+	
+	// Enable the main oscillator with the 16 MHz crystal
+	SYSCTL->RCC = (SYSCTL->RCC & ~(RCC_XTAL_MASK | RCC_MOSCDIS)) | RCC_XTAL_16MHZ;
+	
+	// Divide the 400 MHz PLL output by CLOCK_PLL_DIVISOR
+	SYSCTL->RCC2 = (SYSCTL->RCC2 & ~RCC2_SYSDIV_MASK) | RCC2_DIV400 |
+		((uint32_t)(CLOCK_PLL_DIVISOR - 1) << RCC2_SYSDIV_SHIFT);
+	
+	Clock_Start_PLL();
+	Clock_Select_PLL();
+}
+
+void Clock_Start_PLL(void)
+{
+	// Select the main oscillator (OSCSRC2 = 0) and power up the PLL
+	SYSCTL->RCC2 &= ~(RCC2_OSCSRC2_MASK | RCC2_PWRDN2);
+	
+	// Wait until the PLL has locked
+	while (!(SYSCTL->PLLSTAT & PLLSTAT_LOCK));
+}
+
+void Clock_Select_PLL(void)
+{
+	SYSCTL->RCC2 &= ~RCC2_BYPASS2;
+	SystemCoreClock = CLOCK_SYSTEM_HZ;
+}
+
+void Clock_Select_PIOSC(void)
+{
+	// Run the system from the PIOSC, then power down the PLL that no longer clocks it
+	SYSCTL->RCC2 = (SYSCTL->RCC2 & ~RCC2_OSCSRC2_MASK) | RCC2_BYPASS2 | RCC2_OSCSRC2_PIOSC;
+	SYSCTL->RCC2 |= RCC2_PWRDN2;
+	SystemCoreClock = CLOCK_PIOSC_HZ;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file Clock.h
+ *
+ * @brief Header file for the system clock configuration.
+ *
+ * The system clock is divided from the 400 MHz output of the PLL, which runs from the 16 MHz
+ * crystal of the LaunchPad. CLOCK_SYSTEM_HZ selects the frequency, and every driver derives its
+ * prescalers, reload values and dividers from the definitions in this file at compile time:
+ *  - General-purpose timers: prescaled from the system clock (CLOCK_TIMER_PRESCALE)
+ *  - Timebase and PMOD ENC capture (Wide Timers 0 and 2): the system clock
+ *  - SysTick: PIOSC / 4 (CLOCK_SYSTICK_HZ), independent of the system clock
+ *  - SSI2: PIOSC (CLOCK_PIOSC_HZ), independent of the system clock
+ *
+ * Each driver checks with CLOCK_STATIC_ASSERT that its periods can be reached exactly with the
+ * selected frequency, so a frequency that does not suit a driver stops the build.
+ *
+ * The system clock can also be switched at run time between the PLL (CLOCK_SYSTEM_HZ) and the
+ * PIOSC (CLOCK_PIOSC_HZ) with the PLL powered down. The switch itself does not update the drivers
+ * that count the system clock: Power.h does that for the clock profiles of the game.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+// Main oscillator (LaunchPad crystal) and precision internal oscillator frequencies
+#define CLOCK_MOSC_HZ           16000000UL
+#define CLOCK_PIOSC_HZ          16000000UL
+
+// PLL output frequency, which is divided by 5 to 128 with the DIV400 divider of RCC2
+#define CLOCK_PLL_HZ            400000000UL
+
+// System clock frequency. It can be set from the compiler command line (-DCLOCK_SYSTEM_HZ=50000000),
+// and it must be 400 MHz divided by a whole number from 5 (80 MHz) to 128.
+#ifndef CLOCK_SYSTEM_HZ
+#define CLOCK_SYSTEM_HZ         80000000UL
+#endif
+
+#define CLOCK_PLL_DIVISOR       (CLOCK_PLL_HZ / CLOCK_SYSTEM_HZ)
+
+// SysTick alternate clock source: PIOSC divided by 4
+#define CLOCK_SYSTICK_HZ        (CLOCK_PIOSC_HZ / 4)
+
+// Prescale value (GPTMTnPR) that makes a general-purpose timer count at tick_hz from a system clock of clock_hz
+#define CLOCK_TIMER_PRESCALE_AT(clock_hz, tick_hz)  (((clock_hz) / (tick_hz)) - 1)
+#define CLOCK_TIMER_PRESCALE(tick_hz)       CLOCK_TIMER_PRESCALE_AT(CLOCK_SYSTEM_HZ, tick_hz)
+
+// A timer can count at tick_hz if the system clock is a multiple of it and the 8-bit prescaler reaches it
+#define CLOCK_TIMER_TICK_VALID_AT(clock_hz, tick_hz) \
+	(((clock_hz) % (tick_hz)) == 0 && CLOCK_TIMER_PRESCALE_AT(clock_hz, tick_hz) <= 0xFF)
+#define CLOCK_TIMER_TICK_VALID(tick_hz)     CLOCK_TIMER_TICK_VALID_AT(CLOCK_SYSTEM_HZ, tick_hz)
+
+// Number of 1 MHz ticks of a period, which must fit in the 16-bit interval load register
+#define CLOCK_TIMER_PERIOD_VALID(period_us) ((period_us) >= 1 && (period_us) <= 0x10000)
+
+// SSI prescale divisor (CPSDVSR) from the SSI clock source to SCLK with SCR = 0
+#define CLOCK_SSI_DIVISOR(source_hz, sclk_hz) ((source_hz) / (sclk_hz))
+
+// CPSDVSR must be an even number from 2 to 254, and it must divide the source clock exactly
+#define CLOCK_SSI_DIVISOR_VALID(source_hz, sclk_hz) \
+	(((source_hz) % (sclk_hz)) == 0 && (CLOCK_SSI_DIVISOR(source_hz, sclk_hz) % 2) == 0 && \
+	CLOCK_SSI_DIVISOR(source_hz, sclk_hz) >= 2 && CLOCK_SSI_DIVISOR(source_hz, sclk_hz) <= 254)
+
+// Stops the build with a negative array size when the condition is false.
+// It is used once per check in a source file, with a name that is unique in that file.
+#define CLOCK_STATIC_ASSERT(condition, name) typedef char clock_static_assert_##name[(condition) ? 1 : -1]
+
+/**
+ * @brief Starts the PLL from the 16 MHz crystal and clocks the system at CLOCK_SYSTEM_HZ.
+ *
+ * The system runs from the crystal while the PLL locks, and from the PLL once it has locked.
+ * SystemCoreClock is updated to CLOCK_SYSTEM_HZ. It must be called before any other driver
+ * is initialized.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Clock_Init(void);
+
+/**
+ * @brief Powers up the PLL from the crystal and waits until it has locked.
+ *
+ * If the system runs from the PIOSC, it is moved to the crystal first. Both oscillators run at
+ * 16 MHz, so the system clock frequency does not change while the PLL locks.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Clock_Start_PLL(void);
+
+/**
+ * @brief Clocks the system from the PLL at CLOCK_SYSTEM_HZ.
+ *
+ * The PLL must have been started with Clock_Start_PLL. SystemCoreClock is updated.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Clock_Select_PLL(void);
+
+/**
+ * @brief Clocks the system from the PIOSC at CLOCK_PIOSC_HZ and powers down the PLL.
+ *
+ * SystemCoreClock is updated.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Clock_Select_PIOSC(void);
@@ -0,0 +1,38 @@
+/**
+ * @file Debounce.c
+ *
+ * @brief Source code for the vertical counter debounce engine.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Debounce.h"
+
+void Debounce_Init(Debounce_Type *debounce, uint8_t initial_state)
+{
+	debounce->count0 = 0x00;
+	debounce->count1 = 0x00;
+	debounce->state = initial_state;
+}
+
+uint8_t Debounce_Update(Debounce_Type *debounce, uint8_t sample)
+{
+	// Inputs that currently differ from their debounced state
+	uint8_t delta = sample ^ debounce->state;
+	
+	// Increment the 2-bit counters of the differing inputs and clear the others.
+	// The counters count 0 -> 1 -> 2 -> 3 -> 0, and wrap back to 0 on the fourth sample.
+	debounce->count1 = (debounce->count1 ^ debounce->count0) & delta;
+	debounce->count0 = ~debounce->count0 & delta;
+	
+	// An input toggles when it differs and its counter has wrapped back to 0
+	uint8_t toggle = delta & ~(debounce->count0 | debounce->count1);
+	debounce->state ^= toggle;
+	
+	return toggle;
+}
+
+uint8_t Debounce_Is_Settled(const Debounce_Type *debounce)
+{
+	return (debounce->count0 | debounce->count1) == 0x00;
+}
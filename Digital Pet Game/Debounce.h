@@ -0,0 +1,54 @@
+/**
+ * @file Debounce.h
+ *
+ * @brief Header file for the vertical counter debounce engine.
+ *
+ * Up to eight inputs (one GPIO port) are debounced in parallel with a 2-bit vertical counter.
+ * Each bit position has its own counter made of one bit in count0 and one bit in count1.
+ * A counter is cleared whenever its input matches the debounced state, and the debounced state
+ * of an input only toggles after it has differed for DEBOUNCE_SAMPLES consecutive samples.
+ * An update of all eight inputs takes about ten instructions.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+// Number of consecutive samples needed to accept a new input level
+#define DEBOUNCE_SAMPLES 4
+
+typedef struct
+{
+	uint8_t count0;
+	uint8_t count1;
+	uint8_t state;
+} Debounce_Type;
+
+/**
+ * @brief Sets the debounced state and clears all counters.
+ *
+ * @param debounce A pointer to the debounce engine.
+ * @param initial_state The input levels to start from.
+ *
+ * @return None
+ */
+void Debounce_Init(Debounce_Type *debounce, uint8_t initial_state);
+
+/**
+ * @brief Processes one sample of all inputs.
+ *
+ * @param debounce A pointer to the debounce engine.
+ * @param sample The raw input levels.
+ *
+ * @return A bit mask of the inputs whose debounced state toggled with this sample.
+ */
+uint8_t Debounce_Update(Debounce_Type *debounce, uint8_t sample);
+
+/**
+ * @brief Indicates whether all inputs have settled.
+ *
+ * @param debounce A pointer to the debounce engine.
+ *
+ * @return 1 if no counter is running (every input matched its debounced state on the last sample), 0 otherwise.
+ */
+uint8_t Debounce_Is_Settled(const Debounce_Type *debounce);
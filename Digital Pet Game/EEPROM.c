@@ -0,0 +1,53 @@
+/**
+ * @file EEPROM.c
+ *
+ * @brief Source code for the on-chip EEPROM driver.
+ *
+ * This file contains the function definitions for the EEPROM driver. Words are read and written
+ * through the EERDWR register after selecting the block in EEBLOCK and the word in EEOFFSET.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "EEPROM.h"
+
+// EEDONE: WORKING bit (Bit 0) is set while a write is in progress
+#define EEPROM_WORKING      0x01
+
+// EESUPP: ERETRY (Bit 2) and PRETRY (Bit 3) are set if the EEPROM failed to power up
+#define EEPROM_RETRY_ERROR  0x0C
+
+uint8_t EEPROM_Init(void)
+{
+	// Enable the clock to the EEPROM module by setting the R0 bit (Bit 0) in the RCGCEEPROM register
+	SYSCTL->RCGCEEPROM |= 0x01;
+	
+	// The EEPROM needs at least 6 clock cycles after its clock is enabled
+	for (volatile int delay = 0; delay < 6; delay++);
+	
+	// Wait until the EEPROM has finished powering up
+	while (EEPROM->EEDONE & EEPROM_WORKING);
+	
+	return (EEPROM->EESUPP & EEPROM_RETRY_ERROR) ? 0 : 1;
+}
+
+uint8_t EEPROM_Is_Busy(void)
+{
+	return (EEPROM->EEDONE & EEPROM_WORKING) ? 1 : 0;
+}
+
+uint32_t EEPROM_Read(uint32_t address)
+{
+	EEPROM->EEBLOCK = address / EEPROM_BLOCK_WORDS;
+	EEPROM->EEOFFSET = address % EEPROM_BLOCK_WORDS;
+	return EEPROM->EERDWR;
+}
+
+void EEPROM_Write(uint32_t address, uint32_t word)
+{
+	EEPROM->EEBLOCK = address / EEPROM_BLOCK_WORDS;
+	EEPROM->EEOFFSET = address % EEPROM_BLOCK_WORDS;
+	
+	// Writing EERDWR starts the write, and EEDONE reports WORKING until it is done
+	EEPROM->EERDWR = word;
+}
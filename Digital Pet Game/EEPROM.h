@@ -0,0 +1,59 @@
+/**
+ * @file EEPROM.h
+ *
+ * @brief Header file for the on-chip EEPROM driver.
+ *
+ * The TM4C123GH6PM has 2 KB of EEPROM organized as 32 blocks of 16 words. This driver addresses
+ * it by word, from 0 to (EEPROM_WORDS - 1): the block is the address divided by 16 and the offset
+ * is the remainder.
+ *
+ * A word write starts in the background and takes from tens of microseconds up to several
+ * milliseconds when the EEPROM has to copy its internal buffers, so EEPROM_Write never waits.
+ * The EEPROM must not be read or written again until EEPROM_Is_Busy returns 0.
+ *
+ * @note The EEPROM endurance is 500,000 writes per word.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+#define EEPROM_WORDS         512
+#define EEPROM_BLOCK_WORDS   16
+
+/**
+ * @brief Enables the EEPROM and waits until it is ready.
+ *
+ * @param None
+ *
+ * @return 1 if the EEPROM is ready, or 0 if it reported an error while powering up.
+ */
+uint8_t EEPROM_Init(void);
+
+/**
+ * @brief Checks if a write is still in progress.
+ *
+ * @param None
+ *
+ * @return 1 if a write is in progress, 0 otherwise.
+ */
+uint8_t EEPROM_Is_Busy(void);
+
+/**
+ * @brief Reads one word. No write may be in progress.
+ *
+ * @param address The word address, from 0 to (EEPROM_WORDS - 1).
+ *
+ * @return The word.
+ */
+uint32_t EEPROM_Read(uint32_t address);
+
+/**
+ * @brief Starts writing one word and returns without waiting. No write may be in progress.
+ *
+ * @param address The word address, from 0 to (EEPROM_WORDS - 1).
+ * @param word The word to write.
+ *
+ * @return None
+ */
+void EEPROM_Write(uint32_t address, uint32_t word);
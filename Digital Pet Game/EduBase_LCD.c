@@ -13,6 +13,10 @@
  *	- LCD Enable      [E]   (PC6)
  *  - Register Select [RS]  (PE0)
  *
+ * The power-on sequence can run in the background: EduBase_LCD_Init_Start sets up the pins, and each
+ * call to EduBase_LCD_Init_Step sends the next command of the sequence once the wait required
+ * after the previous one has passed on the Timebase.
+ *
  * @note For more information regarding the LCD, refer to the HD44780 LCD Controller Datasheet.
  * Link: https://www.sparkfun.com/datasheets/LCD/HD44780.pdf
  *
@@ -20,10 +24,19 @@
  */
  
 #include "EduBase_LCD.h"
+#include "Timebase.h"
+#include "HAL.h"
+
+// Steps of the power-on sequence sent by EduBase_LCD_Init_Step
+#define LCD_INIT_STEP_COUNT 9
 
 static uint8_t display_control = 0x00;
 static uint8_t display_mode = 0x00;
 
+// Next step of the power-on sequence, and the Timebase time from which it can be sent
+static uint8_t init_step = LCD_INIT_STEP_COUNT;
+static uint32_t init_step_us = 0;
+
 void EduBase_LCD_Ports_Init(void)
 {
 	SYSCTL->RCGCGPIO |= 0x01;
@@ -47,30 +60,31 @@ void EduBase_LCD_Ports_Init(void)
 
 void EduBase_LCD_Pulse_Enable(void)
 {
-	GPIOC->DATA &= ~0x40;
+	HAL_GPIO_Clear(HAL_PIN_LCD_E);
 	SysTick_Delay1us(1);
 	
-	GPIOC->DATA |= 0x40;
+	HAL_GPIO_Set(HAL_PIN_LCD_E);
 	SysTick_Delay1us(1);
-	GPIOC->DATA &= ~0x40;
+	HAL_GPIO_Clear(HAL_PIN_LCD_E);
 }
 
 void EduBase_LCD_Write_4_Bits(uint8_t data, uint8_t control_flag)
 {
-	GPIOA->DATA |= (data & 0xF0) >> 0x2;
+	// D4 - D7 are cleared after every write, so the upper nibble is written as it is
+	HAL_GPIO_Write(HAL_PIN_LCD_DATA, (data & 0xF0) >> 0x2);
 	
 	if (control_flag & 0x01)
 	{
-		GPIOE->DATA |= 0x01;
+		HAL_GPIO_Set(HAL_PIN_LCD_RS);
 	}
 	else
 	{
-		GPIOE->DATA &= ~0x01;
+		HAL_GPIO_Clear(HAL_PIN_LCD_RS);
 	}
 	
 	EduBase_LCD_Pulse_Enable();
 	
-	GPIOA->DATA &= ~0x3C;
+	HAL_GPIO_Clear(HAL_PIN_LCD_DATA);
 	SysTick_Delay1us(1000);
 }
 
@@ -100,33 +114,76 @@ void EduBase_LCD_Send_Data(uint8_t data)
 
 void EduBase_LCD_Init(void)
 {
-	EduBase_LCD_Ports_Init();
-	
-	SysTick_Delay1us(500000);
-	
-	EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
-	SysTick_Delay1us(4500);
-	
-	EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
-	SysTick_Delay1us(4500);
-	
-	EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
-	SysTick_Delay1us(150);
-	
-	EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_FOUR_BIT_MODE, SEND_COMMAND_FLAG);
-	
-	EduBase_LCD_Send_Command(FUNCTION_SET | CONFIG_5x8_DOTS | CONFIG_TWO_LINES);
-	
-	EduBase_LCD_Enable_Display();
+	EduBase_LCD_Init_Start();
 	
-	EduBase_LCD_Return_Home();
+	while (!EduBase_LCD_Init_Step());
+}
+
+void EduBase_LCD_Init_Start(void)
+{
+	EduBase_LCD_Ports_Init();
 	
-	EduBase_LCD_Clear_Display();
+	// The LCD powers up at reset, so its power-up time is counted from the start of the Timebase
+	init_step = 0;
+	init_step_us = EDUBASE_LCD_POWER_UP_US;
+}
+
+uint8_t EduBase_LCD_Init_Step(void)
+{
+	uint32_t wait_us = 0;
 	
-	EduBase_LCD_Disable_Cursor_Blink();
-	EduBase_LCD_Disable_Cursor();
+	if (init_step >= LCD_INIT_STEP_COUNT)
+	{
+		return 1;
+	}
+	if ((int32_t)(Timebase_Get_Us() - init_step_us) < 0)
+	{
+		return 0;
+	}
 	
+	switch (init_step)
+	{
+		// Function set in 8-bit mode three times, then 4-bit mode (pages 45-46 of the datasheet)
+		case 0:
+		case 1:
+			EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
+			wait_us = 4500;
+			break;
+		
+		case 2:
+			EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_EIGHT_BIT_MODE, SEND_COMMAND_FLAG);
+			wait_us = 150;
+			break;
+		
+		case 3:
+			EduBase_LCD_Write_4_Bits(FUNCTION_SET | CONFIG_FOUR_BIT_MODE, SEND_COMMAND_FLAG);
+			break;
+		
+		case 4:
+			EduBase_LCD_Send_Command(FUNCTION_SET | CONFIG_5x8_DOTS | CONFIG_TWO_LINES);
+			break;
+		
+		case 5:
+			EduBase_LCD_Enable_Display();
+			break;
+		
+		case 6:
+			EduBase_LCD_Return_Home();
+			break;
+		
+		case 7:
+			EduBase_LCD_Clear_Display();
+			break;
+		
+		default:
+			EduBase_LCD_Disable_Cursor_Blink();
+			EduBase_LCD_Disable_Cursor();
+			break;
+	}
 	
+	init_step++;
+	init_step_us = Timebase_Get_Us() + wait_us;
+	return (init_step >= LCD_INIT_STEP_COUNT);
 }
 // Sends the clear display command to the LCD
 void EduBase_LCD_Clear_Display(void)
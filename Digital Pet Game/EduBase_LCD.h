@@ -24,6 +24,10 @@
 #include <string.h>
 #include <stdio.h>
 
+// Time after reset before the first command of the power-on sequence. The HD44780 needs
+// more than 40 ms after its supply has risen.
+#define EDUBASE_LCD_POWER_UP_US 50000
+
 static uint8_t dog_shape1[8] = {
   0x03,
   0x0C,
@@ -523,17 +527,47 @@ void EduBase_LCD_Send_Data(uint8_t data);
  *
  * This function initializes the LCD module by performing the following steps:
  * - Initializes the required GPIO pins for interfacing with the LCD.
- * - Waits for 50 ms to allow the LCD to power up.
+ * - Waits until EDUBASE_LCD_POWER_UP_US after Timebase_Init to allow the LCD to power up.
  * - Sends the function commands several times as part of the LCD initialization sequence
  *   specified in pages 45-46 of the HD44780 LCD Controller datasheet.
  * - Sets up the LCD configuration
  *
+ * It blocks until the LCD is ready. EduBase_LCD_Init_Start and EduBase_LCD_Init_Step run the same
+ * sequence without blocking.
+ *
+ * @note Timebase_Init must be called before this function.
+ *
  * @param None
  *
  * @return None
  */
 void EduBase_LCD_Init(void);
 
+/**
+ * @brief Initializes the GPIO pins of the LCD and starts the power-on sequence in the background.
+ *
+ * The sequence is sent by EduBase_LCD_Init_Step, and the LCD must not be used before it is ready.
+ *
+ * @note Timebase_Init must be called before this function.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void EduBase_LCD_Init_Start(void);
+
+/**
+ * @brief Sends the next command of the power-on sequence if the wait after the previous one has passed.
+ *
+ * It returns at once while waiting, and otherwise takes the time of one command (at most about 3.5 ms).
+ * It must be called repeatedly after EduBase_LCD_Init_Start until it returns 1.
+ *
+ * @param None
+ *
+ * @return 1 once the LCD is ready, 0 otherwise.
+ */
+uint8_t EduBase_LCD_Init_Step(void);
+
 /**
  * @brief Clears the display of the LCD.
  *
@@ -0,0 +1,53 @@
+/**
+ * @file Flash.c
+ *
+ * @brief Source code for the on-chip flash memory programming driver.
+ *
+ * This file contains the function definitions for the flash memory driver. An operation is started
+ * by writing the address to FMA, the data to FMD and the write key with the command to FMC, and
+ * is done when the command bit of FMC reads 0 again.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Flash.h"
+
+// FMC: the write key in Bits 31 to 16 (0xA442 while the KEY bit of BOOTCFG is set, as shipped),
+// WRITE (Bit 0) programs a word and ERASE (Bit 1) erases a page
+#define FLASH_WRITE_KEY     0xA4420000
+#define FLASH_WRITE         0x01
+#define FLASH_ERASE         0x02
+
+// FCRIS: ARIS (Bit 0) access violation, VOLTRIS (Bit 9) voltage error, INVDRIS (Bit 10) invalid data,
+// ERRIS (Bit 11) erase verify error and PROGRIS (Bit 13) program verify error
+#define FLASH_ERRORS        0x2E01
+
+// Starts a command, waits until it is done, and clears and returns its error flags
+static uint8_t Flash_Command(uint32_t command)
+{
+	FLASH_CTRL->FMC = FLASH_WRITE_KEY | command;
+	while (FLASH_CTRL->FMC & command);
+	
+	uint32_t errors = FLASH_CTRL->FCRIS & FLASH_ERRORS;
+	FLASH_CTRL->FCMISC = errors;
+	
+	return errors ? 0 : 1;
+}
+
+uint32_t Flash_Read(uint32_t address)
+{
+	return *(const volatile uint32_t *)((uintptr_t)FLASH_MEMORY_BASE + address);
+}
+
+uint8_t Flash_Program(uint32_t address, uint32_t word)
+{
+	FLASH_CTRL->FMA = address;
+	FLASH_CTRL->FMD = word;
+	return Flash_Command(FLASH_WRITE);
+}
+
+uint8_t Flash_Erase_Page(uint32_t address)
+{
+	FLASH_CTRL->FMA = address;
+	return Flash_Command(FLASH_ERASE);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file Flash.h
+ *
+ * @brief Header file for the on-chip flash memory programming driver.
+ *
+ * The TM4C123GH6PM has 256 KB of flash memory erased in pages of 1 KB. An erased word reads
+ * 0xFFFFFFFF, and programming a word can only clear bits, so a word is programmed once
+ * between two erases of its page.
+ *
+ * The CPU fetches its code from the flash memory, so it stalls while a word is programmed
+ * (tens of microseconds) or a page is erased (milliseconds). Both functions return when the
+ * operation is done.
+ *
+ * Addresses are byte addresses from the start of the flash memory.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+#define FLASH_PAGE_SIZE 1024
+
+// Address of the flash memory in the memory map (the host header places it in a RAM array)
+#ifndef FLASH_MEMORY_BASE
+#define FLASH_MEMORY_BASE 0x00000000
+#endif
+
+/**
+ * @brief Reads one word of the flash memory.
+ *
+ * @param address The byte address of the word (a multiple of 4).
+ *
+ * @return The word.
+ */
+uint32_t Flash_Read(uint32_t address);
+
+/**
+ * @brief Programs one erased word.
+ *
+ * @param address The byte address of the word (a multiple of 4).
+ * @param word The word to program.
+ *
+ * @return 1 if the word was programmed, or 0 if the flash memory controller reported an error.
+ */
+uint8_t Flash_Program(uint32_t address, uint32_t word);
+
+/**
+ * @brief Erases one page, which then reads 0xFFFFFFFF.
+ *
+ * @param address The byte address of the page (a multiple of FLASH_PAGE_SIZE).
+ *
+ * @return 1 if the page was erased, or 0 if the flash memory controller reported an error.
+ */
+uint8_t Flash_Erase_Page(uint32_t address);
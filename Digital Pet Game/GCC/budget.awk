@@ -0,0 +1,189 @@
+# Flash and RAM budget of every module from the map file of the GNU linker.
+#
+# Every input section of the memory map is counted for the module that it comes from:
+#  - Code: .text and the vector table, in the flash memory
+#  - Const: .rodata, in the flash memory
+#  - Data: .data, in RAM with its initial values in the flash memory
+#  - BSS: .bss and COMMON, in RAM
+# The code placed in RAM (.ramfunc) is counted as code, in RAM and in the flash memory that it is
+# copied from.
+# The padding between sections and the stack have their own lines. The heap used by sprintf grows
+# at run time and is not counted.
+#
+# With LTO, the linker only sees the objects of the link-time compilation (ltrans). Their sections
+# are then given to a module by the name of their function or variable (-ffunction-sections and
+# -fdata-sections) or, for a section named otherwise, by the first symbol that the map lists in
+# it, looked up in a symbol list made with readelf from the objects of the modules. A function inlined
+# into another one is counted for the module of the caller.
+#
+# Usage: awk -f budget.awk [-v symbols=symbols.txt] firmware.map
+#  symbols  File of "module symbol" lines for the sections of the link-time compilation
+#
+# Authors: Anna Bagdishyan and Mario Perez
+
+BEGIN {
+	if (symbols != "") {
+		while ((getline line < symbols) > 0) {
+			split(line, field, " ")
+			module_of[field[2]] = field[1]
+		}
+		close(symbols)
+	}
+}
+
+# Length of the FLASH and RAM regions from the memory configuration
+!in_map && $1 == "FLASH" { flash_size = Hex($3) }
+!in_map && $1 == "RAM" { ram_size = Hex($3) }
+
+/^Linker script and memory map/ { in_map = 1; next }
+!in_map { next }
+
+# Symbol of a section of the link-time compilation not found by its name
+deferred_size && NF == 2 && $1 ~ /^0x/ {
+	Count(($2 in module_of) ? module_of[$2] : "(LTO)", deferred_kind, deferred_size)
+	deferred_size = 0
+	next
+}
+deferred_size {
+	Count("(LTO)", deferred_kind, deferred_size)
+	deferred_size = 0
+}
+
+# Output section: a name at the start of the line
+/^\.[^ ]/ {
+	output = $1
+	pending = ""
+	if (output == ".stack" && NF >= 3) {
+		stack_size = Hex($3)
+	}
+	next
+}
+
+# Padding between the input sections
+/^ \*fill\*/ {
+	if (NF >= 3) {
+		Count("(padding)", Kind(output, ".fill"), Hex($3))
+	}
+	next
+}
+
+# Input section, with its address, size and object on the same line or, for a long name, on the next one
+/^ [.A-Z]/ {
+	pending = ""
+	if (NF >= 4 && $2 ~ /^0x/) {
+		Input($1, $3, $4)
+	} else if (NF == 1) {
+		pending = $1
+	}
+	next
+}
+
+pending != "" && /^ +0x/ {
+	if (NF >= 3) {
+		Input(pending, $2, $3)
+	}
+	pending = ""
+	next
+}
+
+{ pending = "" }
+
+function Hex(text,    value, i) {
+	value = 0
+	text = tolower(text)
+	sub(/^0x/, "", text)
+	for (i = 1; i <= length(text); i++) {
+		value = value * 16 + index("0123456789abcdef", substr(text, i, 1)) - 1
+	}
+	return value
+}
+
+# Kind of an input section of an output section, or "" for a section that is not loaded
+function Kind(output, section) {
+	if (output == ".text" || output == ".ARM.exidx") {
+		return (section ~ /^\.rodata/) ? "const" : "code"
+	}
+	if (output == ".data") {
+		return (section ~ /^\.ramfunc/) ? "ramcode" : "data"
+	}
+	if (output == ".bss") {
+		return "bss"
+	}
+	return ""
+}
+
+function Module(section, object,    name) {
+	if (object ~ /ltrans/) {
+		name = section
+		sub(/^\.(text|rodata|data|bss)\./, "", name)
+		sub(/\..*$/, "", name)
+		return (name in module_of) ? module_of[name] : "(LTO)"
+	}
+	if (object ~ /\.a\(/) {
+		sub(/\(.*$/, "", object)
+	}
+	sub(/^.*\//, "", object)
+	sub(/\.o$/, "", object)
+	return object
+}
+
+function Count(module, kind, size) {
+	if (kind == "" || size == 0) {
+		return
+	}
+	if (!(module in flash)) {
+		modules[++module_count] = module
+		flash[module] = 0
+		ram[module] = 0
+	}
+	bytes[module, kind] += size
+	total[kind] += size
+	if (kind != "bss") {
+		flash[module] += size
+	}
+	if (kind == "data" || kind == "bss" || kind == "ramcode") {
+		ram[module] += size
+	}
+}
+
+function Input(section, size, object,    module) {
+	module = Module(section, object)
+	if (module == "(LTO)") {
+		deferred_kind = Kind(output, section)
+		deferred_size = Hex(size)
+		return
+	}
+	Count(module, Kind(output, section), Hex(size))
+}
+
+function Row(name, code, rodata, data, bss, flash_bytes, ram_bytes) {
+	printf "%-22s %8s %8s %8s %8s %9s %8s\n", name, code, rodata, data, bss, flash_bytes, ram_bytes
+}
+
+END {
+	if (deferred_size) {
+		Count("(LTO)", deferred_kind, deferred_size)
+	}
+
+	# Largest flash use first
+	for (i = 2; i <= module_count; i++) {
+		for (j = i; j > 1 && flash[modules[j]] > flash[modules[j - 1]]; j--) {
+			swap = modules[j]; modules[j] = modules[j - 1]; modules[j - 1] = swap
+		}
+	}
+
+	Row("Module", "Code", "Const", "Data", "BSS", "Flash", "RAM")
+	for (i = 1; i <= module_count; i++) {
+		m = modules[i]
+		Row(m, bytes[m, "code"] + bytes[m, "ramcode"], bytes[m, "const"] + 0, bytes[m, "data"] + 0, bytes[m, "bss"] + 0, flash[m], ram[m])
+	}
+	Row("(stack)", "", "", "", "", "", stack_size + 0)
+
+	flash_used = total["code"] + total["ramcode"] + total["const"] + total["data"]
+	ram_used = total["ramcode"] + total["data"] + total["bss"] + stack_size
+	Row("Total", total["code"] + total["ramcode"], total["const"] + 0, total["data"] + 0, total["bss"] + 0, flash_used, ram_used)
+	if (flash_size > 0 && ram_size > 0) {
+		printf "\nFlash: %u of %u bytes (%.1f %%)\n", flash_used, flash_size, 100.0 * flash_used / flash_size
+		printf "RAM:   %u of %u bytes (%.1f %%)\n", ram_used, ram_size, 100.0 * ram_used / ram_size
+	}
+}
@@ -0,0 +1,47 @@
+# Code size of the register accesses of the drivers written by hand and through the HAL.
+#
+# Reads the symbol list (nm -S) of HAL_Pairs.o (../Host/HAL_Pairs.c) built for the Cortex-M4 and
+# lists the size of both functions of every pair: Pair_Direct_<access>, the register code of the
+# drivers from before the HAL, and Pair_HAL_<access>, the HAL code that replaced it. The check fails
+# if a HAL function is larger than its direct function. It compares code size only, not cycles.
+#
+# Usage: nm -S HAL_Pairs.o | awk -f hal_check.awk
+#
+# Authors: Anna Bagdishyan and Mario Perez
+
+NF == 4 && $3 ~ /^[Tt]$/ && $4 ~ /^Pair_(Direct|HAL)_/ {
+	name = $4
+	kind = (name ~ /^Pair_Direct_/) ? "direct" : "hal"
+	sub(/^Pair_(Direct|HAL)_/, "", name)
+	if (!(name in seen)) {
+		seen[name] = 1
+		names[++count] = name
+	}
+	size[name, kind] = Hex($2)
+}
+
+function Hex(text,    value, i) {
+	value = 0
+	text = tolower(text)
+	sub(/^0x/, "", text)
+	for (i = 1; i <= length(text); i++) {
+		value = value * 16 + index("0123456789abcdef", substr(text, i, 1)) - 1
+	}
+	return value
+}
+
+END {
+	printf "%-20s %8s %8s\n", "Access", "Direct", "HAL"
+	for (i = 1; i <= count; i++) {
+		name = names[i]
+		larger = size[name, "hal"] > size[name, "direct"]
+		printf "%-20s %8u %8u%s\n", name, size[name, "direct"], size[name, "hal"], larger ? "  larger" : ""
+		failed += larger
+	}
+	if (count == 0) {
+		print "FAILED: no pairs found"
+		exit 1
+	}
+	print (failed ? "\nFAILED" : "\nPASSED")
+	exit (failed ? 1 : 0)
+}
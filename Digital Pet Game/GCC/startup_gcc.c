@@ -0,0 +1,104 @@
+/**
+ * @file startup_gcc.c
+ *
+ * @brief Startup code of the TM4C123GH6PM for the arm-none-eabi-gcc build.
+ *
+ * This file takes the place of the startup_TM4C123.s and system_TM4C123.c files that the Keil
+ * project adds from its run-time environment:
+ *  - The vector table (__Vectors, as in the CMSIS startup files) holds the initial stack pointer,
+ *    the system exceptions and the 139 device interrupts. Every interrupt of the interrupt table
+ *    (Interrupts.h) gets its handler, and every other vector Default_Handler, so the vector table
+ *    cannot disagree with the table.
+ *  - Reset_Handler copies the initialized data and the handlers placed in SRAM (INTERRUPTS_RAMFUNC)
+ *    from the flash memory to RAM, clears the zero-initialized data, calls SystemInit and then main.
+ *  - SystemInit enables the FPU, since the firmware is built for the hardware floating point ABI.
+ *    The system clock is left on the PIOSC, and Clock_Init (Clock.h) starts the PLL from main.
+ *
+ * The section and symbol names match the linker script (TM4C123GH6PM.ld).
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Clock.h"
+#include "Interrupts.h"
+
+// CPACR: full access to the coprocessors CP10 and CP11 (Bits 23 to 20) enables the FPU
+#define CPACR_CP10_CP11_FULL    (0xF << 20)
+
+// Linker script symbols: the top of the stack, the initialized data in the flash memory and in RAM,
+// and the zero-initialized data
+extern uint32_t __stack_top;
+extern uint32_t __data_load;
+extern uint32_t __data_start;
+extern uint32_t __data_end;
+extern uint32_t __bss_start;
+extern uint32_t __bss_end;
+
+extern int main(void);
+
+// System clock frequency in Hz, declared by system_TM4C123.h and kept up to date by Clock.c.
+// The device starts from the PIOSC.
+uint32_t SystemCoreClock = CLOCK_PIOSC_HZ;
+
+void Reset_Handler(void);
+
+void SystemInit(void)
+{
+	SCB->CPACR |= CPACR_CP10_CP11_FULL;
+	__DSB();
+	__ISB();
+}
+
+// Handler of every unexpected exception and interrupt. It stops here, where the debugger finds the
+// exception number in the IPSR.
+void Default_Handler(void)
+{
+	while (1);
+}
+
+// Every handler of the interrupt table
+#define STARTUP_DECLARE(irq, preempt, sub, handler) void handler(void);
+INTERRUPTS_TABLE(STARTUP_DECLARE)
+
+// Vector of an interrupt of the table. A system exception has a negative IRQ number, so SysTick
+// (-1) takes vector 15.
+#define STARTUP_VECTOR(irq, preempt, sub, handler) [16 + (irq)] = &handler,
+
+// The range initializer fills every vector with Default_Handler first, and the vectors of the
+// interrupt table then override theirs
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverride-init"
+
+__attribute__((section(".vectors"), used))
+void (* const __Vectors[INTERRUPTS_VECTOR_COUNT])(void) =
+{
+	[1 ... INTERRUPTS_VECTOR_COUNT - 1] = &Default_Handler,
+	[0] = (void (*)(void))&__stack_top,
+	[1] = &Reset_Handler,
+	[7 ... 10] = 0,
+	[13] = 0,
+	INTERRUPTS_TABLE(STARTUP_VECTOR)
+};
+
+#pragma GCC diagnostic pop
+
+void Reset_Handler(void)
+{
+	uint32_t *source = &__data_load;
+	uint32_t *destination = &__data_start;
+
+	// Copy the initialized data, then clear the zero-initialized data
+	while (destination < &__data_end)
+	{
+		*destination++ = *source++;
+	}
+	for (destination = &__bss_start; destination < &__bss_end; destination++)
+	{
+		*destination = 0;
+	}
+
+	SystemInit();
+	main();
+
+	while (1);
+}
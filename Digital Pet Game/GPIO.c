@@ -16,6 +16,7 @@
  */
 
 #include "GPIO.h"
+#include "HAL.h"
 
 // Constant definitions for the user LED (RGB) colors
 const uint8_t RGB_LED_OFF 		= 0x00;
@@ -48,7 +49,7 @@ void RGB_LED_Init(void)
 void RGB_LED_Output(uint8_t led_value)
 {
 	// Set the output of the RGB LED
-	GPIOF->DATA = (GPIOF->DATA & 0xF1) | led_value;
+	HAL_GPIO_Write(HAL_PIN_RGB_LED, led_value);
 }
 
 uint8_t RGB_LED_Status(void)
@@ -56,7 +57,7 @@ uint8_t RGB_LED_Status(void)
 	// Assign the value of Port F to a local variable
 	// and only read the values of the following bits: 3, 2, and 1
 	// Then, return the local variable's value
-	uint8_t RGB_LED_Status = GPIOF->DATA & 0x0E;
+	uint8_t RGB_LED_Status = HAL_GPIO_Read(HAL_PIN_RGB_LED);
 	return RGB_LED_Status;
 }
 
@@ -81,7 +82,7 @@ void EduBase_LEDs_Init(void)
 void EduBase_LEDs_Output(uint8_t led_value)
 {
 	// Set the output of the LEDs
-	GPIOB->DATA = (GPIOB->DATA & 0xF0) | (led_value & 0x0F);
+	HAL_GPIO_Write(HAL_PIN_HUNGER_LEDS, led_value);
 }
 
 void EduBase_Button_Init(void)
@@ -104,6 +105,6 @@ uint8_t Get_EduBase_Button_Status(void)
 	// Assign the value of Port D to a local variable
 	// and only read the values of the following bits: 3, 2, 1, and 0
 	// Then, return the local variable's value
-	uint8_t button_status = GPIOD->DATA & 0x0F;
+	uint8_t button_status = HAL_GPIO_Read(HAL_PIN_BUTTONS);
 	return button_status;
 }
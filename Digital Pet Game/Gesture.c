@@ -0,0 +1,146 @@
+/**
+ * @file Gesture.c
+ *
+ * @brief Source code for the button gesture recognizer.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Gesture.h"
+
+#define GESTURE_MAX_BUTTONS 8
+
+// Per-button recognizer state
+static uint8_t gesture_buttons = 0x00;
+static uint8_t last_pressed = 0x00;
+static uint8_t long_press_sent = 0x00;
+static uint8_t click_pending = 0x00;
+static uint32_t press_time[GESTURE_MAX_BUTTONS];
+static uint32_t click_time[GESTURE_MAX_BUTTONS];
+static uint32_t next_repeat_time[GESTURE_MAX_BUTTONS];
+
+// Event queue: written by Gesture_Update (producer) and read by Gesture_Get_Event (consumer)
+static Gesture_Event event_queue[GESTURE_QUEUE_SIZE];
+static volatile uint8_t queue_head = 0;
+static volatile uint8_t queue_tail = 0;
+static uint32_t dropped_count = 0;
+
+static void Gesture_Send(uint8_t type, uint8_t button_mask, uint32_t time_ms)
+{
+	uint8_t next_head = (queue_head + 1) & (GESTURE_QUEUE_SIZE - 1);
+	
+	if (next_head == queue_tail)
+	{
+		dropped_count++;
+		return;
+	}
+	
+	event_queue[queue_head].type = type;
+	event_queue[queue_head].button_mask = button_mask;
+	event_queue[queue_head].time_ms = time_ms;
+	queue_head = next_head;
+}
+
+void Gesture_Init(uint8_t button_mask)
+{
+	gesture_buttons = button_mask;
+	last_pressed = 0x00;
+	long_press_sent = 0x00;
+	click_pending = 0x00;
+	queue_head = 0;
+	queue_tail = 0;
+}
+
+void Gesture_Update(uint8_t pressed_mask, uint32_t now_ms)
+{
+	pressed_mask &= gesture_buttons;
+	
+	for (int i = 0; i < GESTURE_MAX_BUTTONS; i++)
+	{
+		uint8_t button = (1 << i);
+		
+		if (!(gesture_buttons & button))
+		{
+			continue;
+		}
+		
+		uint8_t pressed = pressed_mask & button;
+		uint8_t was_pressed = last_pressed & button;
+		
+		if (pressed && !was_pressed)
+		{
+			Gesture_Send(GESTURE_PRESS, button, now_ms);
+			press_time[i] = now_ms;
+			long_press_sent &= ~button;
+		}
+		else if (!pressed && was_pressed)
+		{
+			Gesture_Send(GESTURE_RELEASE, button, now_ms);
+			
+			// A press that turned into a long press is not a click
+			if (!(long_press_sent & button))
+			{
+				if ((click_pending & button) && (now_ms - click_time[i]) <= GESTURE_DOUBLE_CLICK_MS)
+				{
+					Gesture_Send(GESTURE_DOUBLE_CLICK, button, now_ms);
+					click_pending &= ~button;
+				}
+				else
+				{
+					click_pending |= button;
+					click_time[i] = now_ms;
+				}
+			}
+		}
+		else if (pressed)
+		{
+			if (!(long_press_sent & button))
+			{
+				if ((now_ms - press_time[i]) >= GESTURE_LONG_PRESS_MS)
+				{
+					Gesture_Send(GESTURE_LONG_PRESS, button, now_ms);
+					long_press_sent |= button;
+					click_pending &= ~button;
+					next_repeat_time[i] = now_ms + GESTURE_HOLD_REPEAT_MS;
+				}
+			}
+			else if ((int32_t)(now_ms - next_repeat_time[i]) >= 0)
+			{
+				Gesture_Send(GESTURE_HOLD_REPEAT, button, now_ms);
+				next_repeat_time[i] = next_repeat_time[i] + GESTURE_HOLD_REPEAT_MS;
+			}
+		}
+		
+		// The double-click window has passed, so the pending click is a single click
+		if (!pressed && (click_pending & button) && (now_ms - click_time[i]) > GESTURE_DOUBLE_CLICK_MS)
+		{
+			Gesture_Send(GESTURE_CLICK, button, click_time[i]);
+			click_pending &= ~button;
+		}
+	}
+	
+	last_pressed = pressed_mask;
+}
+
+uint8_t Gesture_Is_Busy(void)
+{
+	return (last_pressed | click_pending) != 0x00;
+}
+
+uint8_t Gesture_Get_Event(Gesture_Event *event)
+{
+	if (queue_tail == queue_head)
+	{
+		return 0;
+	}
+	
+	*event = event_queue[queue_tail];
+	queue_tail = (queue_tail + 1) & (GESTURE_QUEUE_SIZE - 1);
+	
+	return 1;
+}
+
+uint32_t Gesture_Get_Dropped_Count(void)
+{
+	return dropped_count;
+}
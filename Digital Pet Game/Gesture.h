@@ -0,0 +1,94 @@
+/**
+ * @file Gesture.h
+ *
+ * @brief Header file for the button gesture recognizer.
+ *
+ * The gesture recognizer turns the debounced state of up to eight buttons into timestamped events:
+ *  - GESTURE_PRESS         The button was pressed (reported immediately)
+ *  - GESTURE_RELEASE       The button was released
+ *  - GESTURE_CLICK         A short press that was not followed by a second press within GESTURE_DOUBLE_CLICK_MS
+ *  - GESTURE_DOUBLE_CLICK  Two short presses within GESTURE_DOUBLE_CLICK_MS
+ *  - GESTURE_LONG_PRESS    The button has been held for GESTURE_LONG_PRESS_MS
+ *  - GESTURE_HOLD_REPEAT   The button is still held, repeated every GESTURE_HOLD_REPEAT_MS after a long press
+ *
+ * Gesture_Update is called from the input tick and Gesture_Get_Event is called from the main loop.
+ * The event queue has a single producer and a single consumer, so no critical section is needed.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+#define GESTURE_DOUBLE_CLICK_MS  250
+#define GESTURE_LONG_PRESS_MS    800
+#define GESTURE_HOLD_REPEAT_MS   200
+
+// Number of events that can be queued before the oldest unread events are dropped (power of two)
+#define GESTURE_QUEUE_SIZE       16
+
+typedef enum
+{
+	GESTURE_NONE = 0,
+	GESTURE_PRESS,
+	GESTURE_RELEASE,
+	GESTURE_CLICK,
+	GESTURE_DOUBLE_CLICK,
+	GESTURE_LONG_PRESS,
+	GESTURE_HOLD_REPEAT
+} Gesture_Type;
+
+typedef struct
+{
+	uint8_t type;
+	uint8_t button_mask;
+	uint32_t time_ms;
+} Gesture_Event;
+
+/**
+ * @brief Selects the buttons handled by the gesture recognizer and clears its state.
+ *
+ * @param button_mask A bit mask of the buttons (for example, PMOD_ENC_BUTTON_MASK).
+ *
+ * @return None
+ */
+void Gesture_Init(uint8_t button_mask);
+
+/**
+ * @brief Updates the gesture recognizer with the current debounced button state.
+ *
+ * @param pressed_mask The debounced button state (a set bit means the button is pressed).
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Gesture_Update(uint8_t pressed_mask, uint32_t now_ms);
+
+/**
+ * @brief Indicates whether the gesture recognizer needs further updates.
+ *
+ * The recognizer is busy while a button is held or while a click is waiting for a possible second press.
+ * Once it is not busy, it only needs to be updated again when a button changes.
+ *
+ * @param None
+ *
+ * @return 1 if the recognizer is busy, 0 otherwise.
+ */
+uint8_t Gesture_Is_Busy(void);
+
+/**
+ * @brief Removes the oldest event from the event queue.
+ *
+ * @param event A pointer to the event that is filled in.
+ *
+ * @return 1 if an event was returned, 0 if the queue is empty.
+ */
+uint8_t Gesture_Get_Event(Gesture_Event *event);
+
+/**
+ * @brief Returns the number of events dropped because the event queue was full.
+ *
+ * @param None
+ *
+ * @return The number of dropped events.
+ */
+uint32_t Gesture_Get_Dropped_Count(void);
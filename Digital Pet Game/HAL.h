@@ -0,0 +1,197 @@
+/**
+ * @file HAL.h
+ *
+ * @brief Header file for the hardware abstraction layer of the drivers.
+ *
+ * The pins, timers and SSI modules that the drivers access at run time are described once in this
+ * file, each by its peripheral and the bits that belong to it. The drivers access them through the
+ * inline functions below, which are always inlined. With the device backend:
+ *  - A GPIO write only changes the pins of its description, through the address mask of the DATA
+ *    register, so it is a single store instead of a read-modify-write of DATA, and an interrupt
+ *    that writes other pins of the same port cannot be undone by it.
+ *  - A timer interrupt is cleared with a single write of its flag to ICR.
+ *
+ * HAL_BACKEND selects how the registers are reached:
+ *  - HAL_BACKEND_TM4C123: the registers of the device (default)
+ *  - HAL_BACKEND_HOST: the register variables of the host stand-in of the device header (Host/),
+ *    where the DATA address mask is not modelled, so a GPIO access reads and writes DATA itself
+ * The drivers are the same source files with either backend.
+ *
+ * The hot timer interrupts are bound to their tasks at compile time: the module of a task defines
+ * the vector handler of its timer as another name of the task (HAL_BIND), so the vector table
+ * points straight at the task, with no trampoline handler and no task pointer, even with the vector
+ * table in the flash memory. The timer driver then leaves out its trampoline handler.
+ *
+ * This file defines inline functions, so it is only included from source files.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+// Backends
+#define HAL_BACKEND_TM4C123         0
+#define HAL_BACKEND_HOST            1
+
+// Backend of the drivers. It can be set from the compiler command line (-DHAL_BACKEND=HAL_BACKEND_HOST).
+#ifndef HAL_BACKEND
+#define HAL_BACKEND                 HAL_BACKEND_TM4C123
+#endif
+
+// Timers bound to their tasks at compile time (1), or dispatched by the trampoline handler of their
+// driver through its task pointer (0). They can be set from the compiler command line.
+#ifndef HAL_BIND_TIMER_0A
+#define HAL_BIND_TIMER_0A           1
+#endif
+#ifndef HAL_BIND_TIMER_0B
+#define HAL_BIND_TIMER_0B           1
+#endif
+
+// Functions of the HAL, inlined even without optimization
+#define HAL_INLINE                  static inline __attribute__((always_inline))
+
+// Defines a vector handler as another name of a task in the same source file. The task runs
+// straight from the vector, so it must clear its interrupt itself.
+#define HAL_BIND(handler, task)     void handler(void) __attribute__((alias(#task)))
+
+// Pins: port and pin mask
+#define HAL_PIN_HUNGER_LEDS         GPIOB, 0x0F    // PB0 - PB3, EduBase LEDs
+#define HAL_PIN_RGB_LED             GPIOF, 0x0E    // PF1 - PF3, LaunchPad RGB LED
+#define HAL_PIN_BUTTONS             GPIOD, 0x0F    // PD0 - PD3, EduBase buttons
+#define HAL_PIN_PMOD_ENC            GPIOD, 0x0F    // PD0 - PD3, PMOD ENC pins A, B, button and switch
+#define HAL_PIN_SEVEN_SEGMENT_CS    GPIOC, 0x80    // PC7, seven-segment display slave select (active low)
+#define HAL_PIN_LCD_DATA            GPIOA, 0x3C    // PA2 - PA5, LCD D4 - D7
+#define HAL_PIN_LCD_E               GPIOC, 0x40    // PC6, LCD enable
+#define HAL_PIN_LCD_RS              GPIOE, 0x01    // PE0, LCD register select
+
+// Timers: timer module and time-out interrupt flag (TATOIM or TBTOIM)
+#define HAL_TIMER_0A                TIMER0, 0x001
+#define HAL_TIMER_0B                TIMER0, 0x100
+#define HAL_TIMER_1A                TIMER1, 0x001
+#define HAL_TIMER_2A                TIMER2, 0x001
+
+// SSI modules
+#define HAL_SSI_SEVEN_SEGMENT       SSI2
+
+// Port and mask of a pin description, for the configuration code
+#define HAL_PIN_PORT(pin)           HAL_PIN_PORT_(pin)
+#define HAL_PIN_PORT_(port, mask)   (port)
+#define HAL_PIN_MASK(pin)           HAL_PIN_MASK_(pin)
+#define HAL_PIN_MASK_(port, mask)   (mask)
+
+// Returns the GPIO DATA register alias that only affects the pins selected by mask
+// (the address bits [9:2] of the DATA register are used as a write mask)
+#define HAL_GPIO_DATA_MASKED(port, mask) (*((volatile uint32_t *)((volatile uint8_t *)(port) + ((uint32_t)(mask) << 2))))
+
+/**
+ * @brief Writes the pins selected by a mask, without changing the other pins of the port.
+ *
+ * @param port The GPIO port.
+ *
+ * @param mask The pins to write.
+ *
+ * @param value The new level of the pins (only the bits of the mask are used).
+ *
+ * @return None
+ */
+HAL_INLINE void HAL_GPIO_Write(GPIOA_Type *port, uint32_t mask, uint32_t value)
+{
+#if HAL_BACKEND == HAL_BACKEND_HOST
+	port->DATA = (port->DATA & ~mask) | (value & mask);
+#else
+	HAL_GPIO_DATA_MASKED(port, mask) = value;
+#endif
+}
+
+/**
+ * @brief Sets the pins selected by a mask to high.
+ *
+ * @param port The GPIO port.
+ *
+ * @param mask The pins to set.
+ *
+ * @return None
+ */
+HAL_INLINE void HAL_GPIO_Set(GPIOA_Type *port, uint32_t mask)
+{
+	HAL_GPIO_Write(port, mask, mask);
+}
+
+/**
+ * @brief Clears the pins selected by a mask to low.
+ *
+ * @param port The GPIO port.
+ *
+ * @param mask The pins to clear.
+ *
+ * @return None
+ */
+HAL_INLINE void HAL_GPIO_Clear(GPIOA_Type *port, uint32_t mask)
+{
+	HAL_GPIO_Write(port, mask, 0);
+}
+
+/**
+ * @brief Reads the pins selected by a mask.
+ *
+ * @param port The GPIO port.
+ *
+ * @param mask The pins to read.
+ *
+ * @return The level of the pins of the mask, with every other bit cleared.
+ */
+HAL_INLINE uint32_t HAL_GPIO_Read(GPIOA_Type *port, uint32_t mask)
+{
+#if HAL_BACKEND == HAL_BACKEND_HOST
+	return port->DATA & mask;
+#else
+	return HAL_GPIO_DATA_MASKED(port, mask);
+#endif
+}
+
+/**
+ * @brief Returns whether the time-out interrupt of a timer is pending and unmasked.
+ *
+ * @param timer The timer module.
+ *
+ * @param flag The time-out interrupt flag of the timer.
+ *
+ * @return The flag if the interrupt is pending, 0 otherwise.
+ */
+HAL_INLINE uint32_t HAL_Timer_Pending(TIMER0_Type *timer, uint32_t flag)
+{
+	return timer->MIS & flag;
+}
+
+/**
+ * @brief Clears the time-out interrupt of a timer.
+ *
+ * ICR is write-one-to-clear, so the flag is written without reading ICR first.
+ *
+ * @param timer The timer module.
+ *
+ * @param flag The time-out interrupt flag of the timer.
+ *
+ * @return None
+ */
+HAL_INLINE void HAL_Timer_Clear(TIMER0_Type *timer, uint32_t flag)
+{
+	timer->ICR = flag;
+}
+
+/**
+ * @brief Writes a frame to the transmit FIFO of an SSI module and waits until it has been sent.
+ *
+ * @param ssi The SSI module.
+ *
+ * @param data The frame to send.
+ *
+ * @return None
+ */
+HAL_INLINE void HAL_SSI_Write(SSI0_Type *ssi, uint8_t data)
+{
+	ssi->DR = data;
+
+	// Wait while the BSY bit (Bit 4) of the SR register is set
+	while (ssi->SR & 0x10);
+}
@@ -0,0 +1,671 @@
+/**
+ * @file Balancer.c
+ *
+ * @brief Monte Carlo difficulty balancer with scripted bot players.
+ *
+ * This program plays millions of games of every difficulty level in the level table (Levels.c)
+ * with the same game rules as the firmware (Pet_Sim), played by scripted bots instead of a person.
+ * A bot watches the hunger LEDs and feeds the pet once the number of lit LEDs drops to its
+ * feeding threshold. Each bot is described by:
+ *  - The feeding threshold in lit hunger LEDs
+ *  - A log-normal reaction time distribution, given by its mean and standard deviation
+ *  - The probability that a press is missed (too short, or the wrong button). The bot notices
+ *    that the hunger bar did not refill and presses again after another reaction time.
+ *
+ * A feed click reaches the game once the press has been debounced (DEBOUNCE_SAMPLES input ticks)
+ * and the double-click window (GESTURE_DOUBLE_CLICK_MS) has passed, and the game loop handles it at
+ * its next frame (FRAME_MS).
+ *
+ * The games are split into batches of the same level and bot. Each batch is played as a
+ * population of pets in one Pet_Sim engine, and the batches are run by a pool of threads with
+ * one task deque per thread. A thread takes its own tasks from the bottom of its deque and steals
+ * tasks from the top of the other deques once its deque is empty. Each batch has its own random
+ * seed, so the results do not depend on the number of threads.
+ *
+ * The report lists, for every level and bot, the win rate and the distribution of the time to
+ * death of the lost games (mean, 10th, 50th and 90th percentiles, and the share of deaths in each
+ * second of the game). With -S, the same games are then played with 1, 2, 4, ... threads up to
+ * the thread count and the games per second are reported for each thread count.
+ *
+ * Usage: balancer [-g games] [-t threads] [-s seed] [-S]
+ *  -g  Number of games per level and bot (default 1000000)
+ *  -t  Number of threads (default: number of online CPUs)
+ *  -s  Seed of the random number generator (default 1)
+ *  -S  Report the games per second for each thread count
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// pthreads, sysconf and clock_gettime are POSIX functions
+#define _POSIX_C_SOURCE 200112L
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Levels.h"
+#include "Pet_Sim.h"
+#include "PMOD_ENC.h"
+#include "Debounce.h"
+#include "Gesture.h"
+
+// Period of the game loop and the delay between a press and the click event
+#define FRAME_MS            50
+#define PRESS_DELAY_MS      (DEBOUNCE_SAMPLES * PMOD_ENC_TICK_US / 1000 + GESTURE_DOUBLE_CLICK_MS)
+
+// Number of games played together in one Pet_Sim engine
+#define BATCH_GAMES         1024
+
+// Resolution of the time to death histogram
+#define DEATH_BIN_MS        100
+#define DEATH_BINS          1024
+
+#define MAX_THREADS         256
+#define NO_FEED             0xFFFFFFFFUL
+
+typedef struct
+{
+	const char *name;
+
+	// The bot feeds the pet once this many hunger LEDs or fewer are lit
+	uint8_t feed_threshold_leds;
+
+	// Mean and standard deviation of the log-normal reaction time
+	double reaction_mean_ms;
+	double reaction_sd_ms;
+
+	// Probability that a press is missed
+	double miss_probability;
+} Bot_Strategy;
+
+static const Bot_Strategy bots[] =
+{
+	// name         threshold  reaction mean  reaction sd  miss
+	{"pro",         2,         250,           60,          0.005},
+	{"casual",      2,         450,           150,         0.03},
+	{"late",        1,         450,           150,         0.03},
+	{"cautious",    3,         450,           150,         0.03},
+	{"distracted",  2,         900,           600,         0.08}
+};
+
+#define BOT_COUNT (sizeof(bots) / sizeof(bots[0]))
+
+// Outcome of the games of one level and bot
+typedef struct
+{
+	uint64_t games;
+	uint64_t wins;
+	uint64_t feeds;
+	uint64_t death_bins[DEATH_BINS];
+	uint64_t death_ms_total;
+} Result_Type;
+
+// A batch of games of one level and bot
+typedef struct
+{
+	uint8_t level;
+	uint8_t bot;
+	uint32_t games;
+	uint64_t seed;
+} Task_Type;
+
+typedef struct
+{
+	pthread_mutex_t lock;
+	Task_Type *tasks;
+	uint32_t top;
+	uint32_t bottom;
+} Task_Deque;
+
+typedef struct
+{
+	uint64_t state;
+
+	// Second normal sample of the last Box-Muller transform
+	double spare;
+	int has_spare;
+} Random_Type;
+
+typedef struct Pool Pool;
+
+typedef struct
+{
+	Pool *pool;
+	uint32_t id;
+	pthread_t thread;
+	Task_Deque deque;
+	Random_Type victim_random;
+	uint64_t steals;
+
+	// Pet_Sim storage and bot state for one batch
+	Hunger_Type hunger[BATCH_GAMES];
+	uint32_t words[BATCH_GAMES * PET_SIM_WORDS_PER_PET];
+	uint8_t status[BATCH_GAMES];
+	uint32_t feed_ms[BATCH_GAMES];
+
+	// Results of the tasks run by this thread, merged once all threads are done
+	Result_Type *results;
+} Worker_Type;
+
+struct Pool
+{
+	uint32_t thread_count;
+	Worker_Type *workers;
+};
+
+static uint64_t Split_Mix(uint64_t value)
+{
+	value += 0x9E3779B97F4A7C15ULL;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+static void Random_Seed(Random_Type *random, uint64_t seed)
+{
+	random->state = Split_Mix(seed);
+	if (random->state == 0)
+	{
+		random->state = 1;
+	}
+	random->has_spare = 0;
+}
+
+static uint64_t Random_Next(Random_Type *random)
+{
+	random->state ^= random->state >> 12;
+	random->state ^= random->state << 25;
+	random->state ^= random->state >> 27;
+	return random->state * 0x2545F4914F6CDD1DULL;
+}
+
+// Uniform sample in (0, 1)
+static double Random_Uniform(Random_Type *random)
+{
+	return ((double)(Random_Next(random) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// Standard normal sample (Box-Muller transform)
+static double Random_Normal(Random_Type *random)
+{
+	if (random->has_spare)
+	{
+		random->has_spare = 0;
+		return random->spare;
+	}
+
+	double radius = sqrt(-2.0 * log(Random_Uniform(random)));
+	double angle = 6.283185307179586 * Random_Uniform(random);
+
+	random->spare = radius * sin(angle);
+	random->has_spare = 1;
+	return radius * cos(angle);
+}
+
+// Reaction time of a bot in milliseconds
+static uint32_t Bot_Reaction_Ms(const Bot_Strategy *bot, Random_Type *random)
+{
+	// log-normal distribution with the given mean and standard deviation
+	double ratio = bot->reaction_sd_ms / bot->reaction_mean_ms;
+	double sigma2 = log(1.0 + ratio * ratio);
+	double mu = log(bot->reaction_mean_ms) - 0.5 * sigma2;
+
+	return (uint32_t)(exp(mu + sqrt(sigma2) * Random_Normal(random)) + 0.5);
+}
+
+// Time at which the next feed of a pet reaches the game, decided right after it was fed
+static uint32_t Bot_Next_Feed_Ms(const Bot_Strategy *bot, const Pet_Sim_Type *sim, uint32_t pet,
+	uint32_t now_ms, Random_Type *random)
+{
+	uint32_t level = Pet_Sim_Get_Hunger(sim, pet, now_ms);
+	uint32_t threshold = bot->feed_threshold_leds * HUNGER_ONE_LED;
+	uint32_t press_ms = now_ms;
+
+	// the bot notices the LED that turns off at its threshold
+	if (level > threshold)
+	{
+		press_ms += (uint32_t)(((uint64_t)(level - threshold) * sim->hunger[pet].decay_ms + 0xFFFF) >> 16);
+	}
+
+	// missed presses are followed by another reaction time
+	press_ms += Bot_Reaction_Ms(bot, random);
+	while (Random_Uniform(random) < bot->miss_probability)
+	{
+		press_ms += Bot_Reaction_Ms(bot, random);
+	}
+
+	return press_ms + PRESS_DELAY_MS;
+}
+
+static void Run_Task(Worker_Type *worker, const Task_Type *task)
+{
+	const Level_Type *level = Levels_Get(task->level);
+	const Bot_Strategy *bot = &bots[task->bot];
+	Result_Type *result = &worker->results[task->level * BOT_COUNT + task->bot];
+	uint32_t *feed_ms = worker->feed_ms;
+	Random_Type random;
+	Pet_Sim_Type sim;
+
+	Random_Seed(&random, task->seed);
+	Pet_Sim_Init(&sim, task->games, worker->hunger, worker->words, worker->status);
+
+	for (uint32_t pet = 0; pet < task->games; pet++)
+	{
+		Pet_Sim_Start(&sim, pet, level->decay_ms, level->survival_ms, level->stats_decay, 0);
+		feed_ms[pet] = Bot_Next_Feed_Ms(bot, &sim, pet, 0, &random);
+	}
+
+	uint32_t now_ms = 0;
+	uint32_t playing = task->games;
+	uint64_t feeds = 0;
+
+	while (playing != 0)
+	{
+		now_ms += FRAME_MS;
+
+		// feed the pets whose click has reached the game, then advance all pets
+		for (uint32_t pet = 0; pet < task->games; pet++)
+		{
+			if (feed_ms[pet] <= now_ms)
+			{
+				if (Pet_Sim_Feed(&sim, pet, level->refill_leds * HUNGER_ONE_LED, now_ms))
+				{
+					feed_ms[pet] = Bot_Next_Feed_Ms(bot, &sim, pet, now_ms, &random);
+					feeds++;
+				}
+				else
+				{
+					feed_ms[pet] = NO_FEED;
+				}
+			}
+		}
+
+		playing = Pet_Sim_Step(&sim, now_ms);
+	}
+
+	result->games += task->games;
+	result->feeds += feeds;
+	for (uint32_t pet = 0; pet < task->games; pet++)
+	{
+		if (sim.status[pet] == PET_SIM_WON)
+		{
+			result->wins++;
+		}
+		else
+		{
+			// the game started at time 0, so the time the hunger bar emptied is the time to death
+			uint32_t death_ms = sim.empty_ms[pet];
+			uint32_t bin = death_ms / DEATH_BIN_MS;
+
+			result->death_bins[bin < DEATH_BINS ? bin : DEATH_BINS - 1]++;
+			result->death_ms_total += death_ms;
+		}
+	}
+}
+
+static int Deque_Pop(Task_Deque *deque, Task_Type *task)
+{
+	int found = 0;
+
+	pthread_mutex_lock(&deque->lock);
+	if (deque->bottom > deque->top)
+	{
+		*task = deque->tasks[--deque->bottom];
+		found = 1;
+	}
+	pthread_mutex_unlock(&deque->lock);
+	return found;
+}
+
+static int Deque_Steal(Task_Deque *deque, Task_Type *task)
+{
+	int found = 0;
+
+	pthread_mutex_lock(&deque->lock);
+	if (deque->bottom > deque->top)
+	{
+		*task = deque->tasks[deque->top++];
+		found = 1;
+	}
+	pthread_mutex_unlock(&deque->lock);
+	return found;
+}
+
+static void *Worker_Main(void *argument)
+{
+	Worker_Type *worker = argument;
+	Pool *pool = worker->pool;
+	Task_Type task;
+
+	for (;;)
+	{
+		if (Deque_Pop(&worker->deque, &task))
+		{
+			Run_Task(worker, &task);
+			continue;
+		}
+
+		// No task is ever added once the threads run, so the work is done
+		// when every deque is empty. Victims are visited from a random start.
+		uint32_t start = (uint32_t)(Random_Next(&worker->victim_random) % pool->thread_count);
+		int stolen = 0;
+
+		for (uint32_t i = 0; i < pool->thread_count && !stolen; i++)
+		{
+			uint32_t victim = (start + i) % pool->thread_count;
+			if (victim != worker->id && Deque_Steal(&pool->workers[victim].deque, &task))
+			{
+				stolen = 1;
+			}
+		}
+		if (!stolen)
+		{
+			return 0;
+		}
+		worker->steals++;
+		Run_Task(worker, &task);
+	}
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// Frees the first count workers of a pool and the pool
+static void Free_Workers(Pool *pool, uint32_t count)
+{
+	for (uint32_t id = 0; id < count; id++)
+	{
+		Worker_Type *worker = &pool->workers[id];
+
+		pthread_mutex_destroy(&worker->deque.lock);
+		free(worker->deque.tasks);
+		free(worker->results);
+	}
+	free(pool->workers);
+}
+
+// Plays every game with the given number of threads and returns the elapsed time, or a negative time on error
+static double Run_Games(uint32_t thread_count, uint64_t games, uint64_t seed, Result_Type *results, uint64_t *steals)
+{
+	uint32_t level_count = Levels_Get_Count();
+	uint32_t config_count = level_count * BOT_COUNT;
+	uint64_t tasks_per_config = (games + BATCH_GAMES - 1) / BATCH_GAMES;
+	uint64_t task_count = tasks_per_config * config_count;
+	uint32_t capacity = (uint32_t)((task_count + thread_count - 1) / thread_count);
+	Pool pool;
+
+	pool.thread_count = thread_count;
+	pool.workers = calloc(thread_count, sizeof(Worker_Type));
+	if (pool.workers == NULL)
+	{
+		return -1;
+	}
+
+	for (uint32_t id = 0; id < thread_count; id++)
+	{
+		Worker_Type *worker = &pool.workers[id];
+
+		worker->pool = &pool;
+		worker->id = id;
+		pthread_mutex_init(&worker->deque.lock, 0);
+		worker->deque.tasks = malloc(capacity * sizeof(Task_Type));
+		worker->results = calloc(config_count, sizeof(Result_Type));
+		if (worker->deque.tasks == NULL || worker->results == NULL)
+		{
+			Free_Workers(&pool, id + 1);
+			return -1;
+		}
+		Random_Seed(&worker->victim_random, seed ^ (0xA5A5A5A5ULL + id));
+	}
+
+	// Deal the tasks like cards, one configuration after the other. The easy levels have
+	// longer games, so the threads run out of work at different times and steal the rest.
+	uint64_t task_index = 0;
+	for (uint32_t config = 0; config < config_count; config++)
+	{
+		uint64_t games_left = games;
+
+		for (uint64_t i = 0; i < tasks_per_config; i++, task_index++)
+		{
+			Worker_Type *worker = &pool.workers[task_index % thread_count];
+			Task_Type *task = &worker->deque.tasks[worker->deque.bottom++];
+
+			task->level = (uint8_t)(config / BOT_COUNT);
+			task->bot = (uint8_t)(config % BOT_COUNT);
+			task->games = (uint32_t)(games_left < BATCH_GAMES ? games_left : BATCH_GAMES);
+			task->seed = seed * 0x100000000ULL + task_index;
+			games_left -= task->games;
+		}
+	}
+
+	double start = Seconds_Now();
+	uint32_t started = 0;
+	while (started < thread_count &&
+		pthread_create(&pool.workers[started].thread, 0, &Worker_Main, &pool.workers[started]) == 0)
+	{
+		started++;
+	}
+	for (uint32_t id = 0; id < started; id++)
+	{
+		pthread_join(pool.workers[id].thread, 0);
+	}
+	double elapsed = Seconds_Now() - start;
+
+	// The started threads have stolen the tasks of the others, but the timing is not for thread_count
+	if (started < thread_count)
+	{
+		Free_Workers(&pool, thread_count);
+		return -1;
+	}
+
+	memset(results, 0, config_count * sizeof(Result_Type));
+	*steals = 0;
+	for (uint32_t id = 0; id < thread_count; id++)
+	{
+		Worker_Type *worker = &pool.workers[id];
+
+		for (uint32_t config = 0; config < config_count; config++)
+		{
+			results[config].games += worker->results[config].games;
+			results[config].wins += worker->results[config].wins;
+			results[config].feeds += worker->results[config].feeds;
+			results[config].death_ms_total += worker->results[config].death_ms_total;
+			for (uint32_t bin = 0; bin < DEATH_BINS; bin++)
+			{
+				results[config].death_bins[bin] += worker->results[config].death_bins[bin];
+			}
+		}
+		*steals += worker->steals;
+	}
+	Free_Workers(&pool, thread_count);
+
+	return elapsed;
+}
+
+// Time to death below which the given share of the lost games died
+static uint32_t Death_Percentile_Ms(const Result_Type *result, uint64_t deaths, double share)
+{
+	uint64_t target = (uint64_t)ceil(share * (double)deaths);
+	uint64_t seen = 0;
+
+	for (uint32_t bin = 0; bin < DEATH_BINS; bin++)
+	{
+		seen += result->death_bins[bin];
+		if (seen >= target && seen != 0)
+		{
+			return (bin + 1) * DEATH_BIN_MS;
+		}
+	}
+	return DEATH_BINS * DEATH_BIN_MS;
+}
+
+static void Print_Report(const Result_Type *results)
+{
+	uint32_t max_survival_ms = 0;
+
+	for (uint32_t level = 0; level < Levels_Get_Count(); level++)
+	{
+		if (Levels_Get(level)->survival_ms > max_survival_ms)
+		{
+			max_survival_ms = Levels_Get(level)->survival_ms;
+		}
+	}
+	uint32_t seconds = (max_survival_ms + 999) / 1000;
+
+	printf("Time to death percentiles are upper bounds of %d ms bins. The last columns give the share of\n", DEATH_BIN_MS);
+	printf("the lost games that died in each second of the game.\n\n");
+	printf("%-8s %-11s %10s %7s %6s %8s %6s %6s %6s ", "level", "bot", "games", "win %", "feeds", "ttd mean", "p10", "p50", "p90");
+	for (uint32_t second = 0; second < seconds; second++)
+	{
+		printf(" %2us", second + 1);
+	}
+	printf("\n");
+
+	for (uint32_t level = 0; level < Levels_Get_Count(); level++)
+	{
+		for (uint32_t bot = 0; bot < BOT_COUNT; bot++)
+		{
+			const Result_Type *result = &results[level * BOT_COUNT + bot];
+			uint64_t deaths = result->games - result->wins;
+
+			printf("%-8s %-11s %10llu %7.2f %6.2f ", Levels_Get(level)->label, bots[bot].name,
+				(unsigned long long)result->games, 100.0 * (double)result->wins / (double)result->games,
+				(double)result->feeds / (double)result->games);
+
+			if (deaths == 0)
+			{
+				printf("%8s %6s %6s %6s\n", "-", "-", "-", "-");
+				continue;
+			}
+
+			printf("%8.0f %6u %6u %6u ", (double)result->death_ms_total / (double)deaths,
+				Death_Percentile_Ms(result, deaths, 0.1), Death_Percentile_Ms(result, deaths, 0.5),
+				Death_Percentile_Ms(result, deaths, 0.9));
+
+			for (uint32_t second = 0; second < seconds; second++)
+			{
+				uint64_t count = 0;
+				for (uint32_t bin = second * 1000 / DEATH_BIN_MS; bin < (second + 1) * 1000 / DEATH_BIN_MS; bin++)
+				{
+					count += result->death_bins[bin];
+				}
+				printf(" %3.0f", 100.0 * (double)count / (double)deaths);
+			}
+			printf("\n");
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	uint64_t games = 1000000;
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	uint32_t thread_count = (online > 0) ? (uint32_t)online : 1;
+	uint64_t seed = 1;
+	int scaling = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+		{
+			games = strtoull(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+		{
+			thread_count = (uint32_t)strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			seed = strtoull(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-S") == 0)
+		{
+			scaling = 1;
+		}
+		else
+		{
+			games = 0;
+			break;
+		}
+	}
+
+	if (games == 0 || thread_count == 0 || thread_count > MAX_THREADS)
+	{
+		fprintf(stderr, "Usage: %s [-g games] [-t threads] [-s seed] [-S]\n", argv[0]);
+		return 1;
+	}
+
+	uint32_t config_count = Levels_Get_Count() * BOT_COUNT;
+	Result_Type *results = malloc(config_count * sizeof(Result_Type));
+	Result_Type *check = malloc(config_count * sizeof(Result_Type));
+	uint64_t steals;
+
+	if (results == NULL || check == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+
+	double elapsed = Run_Games(thread_count, games, seed, results, &steals);
+	if (elapsed < 0)
+	{
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+
+	Print_Report(results);
+	printf("\n%llu games in %.2f s with %u threads: %.0f games/s, %llu tasks stolen\n",
+		(unsigned long long)(games * config_count), elapsed, thread_count,
+		(double)(games * config_count) / elapsed, (unsigned long long)steals);
+
+	if (scaling)
+	{
+		double base = 0;
+
+		printf("\n%8s %10s %12s %8s %8s\n", "threads", "seconds", "games/s", "speedup", "steals");
+		for (uint32_t count = 1; ; count *= 2)
+		{
+			if (count > thread_count)
+			{
+				count = thread_count;
+			}
+			elapsed = Run_Games(count, games, seed, check, &steals);
+			if (elapsed < 0)
+			{
+				fprintf(stderr, "Out of memory\n");
+				return 1;
+			}
+			if (base == 0)
+			{
+				base = elapsed;
+			}
+
+			// every thread count must play exactly the same games
+			if (memcmp(check, results, config_count * sizeof(Result_Type)) != 0)
+			{
+				printf("Results with %u threads differ from the first run\n", count);
+				return 1;
+			}
+
+			printf("%8u %10.2f %12.0f %8.2f %8llu\n", count, elapsed, (double)(games * config_count) / elapsed,
+				base / elapsed, (unsigned long long)steals);
+			if (count == thread_count)
+			{
+				break;
+			}
+		}
+	}
+
+	free(results);
+	free(check);
+	return 0;
+}
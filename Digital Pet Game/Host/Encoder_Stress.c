@@ -0,0 +1,441 @@
+/**
+ * @file Encoder_Stress.c
+ *
+ * @brief Host-side stress harness for the PMOD ENC decoding path.
+ *
+ * This program synthesizes quadrature waveforms for the PMOD ENC module and feeds them to the
+ * real PMOD_ENC driver through the host stand-in of GPIOD->DATA and PMOD_ENC_Get_State.
+ * Each configuration turns the knob a number of detents clockwise, pauses, and turns it back
+ * by the same number of detents. The decoded steps are compared against the expected steps.
+ *
+ * A configuration is made of:
+ *  - Decoder: "legacy" (PMOD_ENC_Get_Rotation) or "table" (PMOD_ENC_Decode_Rotation)
+ *  - Strategy: polling at a fixed rate, or edge-triggered with an interrupt latency
+ *  - Bounce profile: number of extra contact toggles after each edge and the bounce window
+ *  - Speed in detents per second, with a random timing jitter on every transition
+ *
+ * The report lists the following counts per configuration:
+ *  - missed: expected steps that were not counted
+ *  - extra: steps counted in the right direction beyond the expected steps
+ *  - wrong: steps counted in the wrong direction
+ *  - invalid: transitions rejected by PMOD_ENC_Decode_Rotation (both pins changed between samples)
+ *
+ * The summary lists the highest speed without any error for each decoder, strategy and bounce profile.
+ *
+ * Usage: encoder_stress [-n detents] [-j jitter_percent] [-s seed] [-c]
+ *  -n  Number of detents in each direction (default 100)
+ *  -j  Timing jitter of each transition as a percentage of the transition period (default 10)
+ *  -s  Seed of the random number generator (default 1)
+ *  -c  Print the results as CSV instead of a table
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TM4C123GH6PM.h"
+#include "PMOD_ENC.h"
+
+// Waveform times are kept in nanoseconds
+#define NS_PER_US           1000ULL
+#define NS_PER_S            1000000000ULL
+
+// Pause between the clockwise and the counter-clockwise turn (50 ms)
+#define TURN_PAUSE_NS       (50ULL * 1000000ULL)
+
+// Time spent in the GPIO Port D handler after the pins have been sampled (2 us)
+#define HANDLER_NS          (2ULL * NS_PER_US)
+
+#define DECODER_LEGACY      0
+#define DECODER_TABLE       1
+
+#define STRATEGY_POLL       0
+#define STRATEGY_EDGE       1
+
+typedef struct
+{
+	uint64_t time_ns;
+	uint8_t pin_mask;
+} Edge_Event;
+
+typedef struct
+{
+	const char *name;
+	uint8_t toggles;
+	uint32_t window_us;
+} Bounce_Profile;
+
+typedef struct
+{
+	const char *name;
+	uint8_t type;
+	uint32_t poll_hz;
+	uint32_t latency_us;
+} Strategy;
+
+typedef struct
+{
+	uint32_t expected;
+	uint32_t counted;
+	uint32_t missed;
+	uint32_t extra;
+	uint32_t wrong;
+	uint32_t invalid;
+} Stress_Result;
+
+static const char *decoder_names[2] = {"legacy", "table"};
+
+static const Strategy strategies[] =
+{
+	{"poll 1 kHz",   STRATEGY_POLL, 1000,  0},
+	{"poll 10 kHz",  STRATEGY_POLL, 10000, 0},
+	{"edge 1 us",    STRATEGY_EDGE, 0,     1},
+	{"edge 20 us",   STRATEGY_EDGE, 0,     20}
+};
+
+static const Bounce_Profile bounce_profiles[] =
+{
+	{"none",  0, 0},
+	{"light", 2, 200},
+	{"heavy", 6, 2000}
+};
+
+static const uint32_t speeds[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
+#define STRATEGY_COUNT      (sizeof(strategies) / sizeof(strategies[0]))
+#define BOUNCE_COUNT        (sizeof(bounce_profiles) / sizeof(bounce_profiles[0]))
+#define SPEED_COUNT         (sizeof(speeds) / sizeof(speeds[0]))
+
+// Clockwise quadrature sequence of (B << 1) | A, see the transition table in PMOD_ENC.c
+static const uint8_t clockwise_sequence[4] = {0x00, 0x02, 0x03, 0x01};
+
+static uint64_t random_state = 1;
+
+// xorshift64* generator, so every run with the same seed produces the same waveforms
+static uint32_t Random_Next(void)
+{
+	random_state ^= random_state >> 12;
+	random_state ^= random_state << 25;
+	random_state ^= random_state >> 27;
+	return (uint32_t)((random_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+// Returns a random value in the range [-range, range]
+static int64_t Random_Spread(uint64_t range)
+{
+	if (range == 0)
+	{
+		return 0;
+	}
+	return (int64_t)(Random_Next() % (2 * range + 1)) - (int64_t)range;
+}
+
+static int Edge_Event_Compare(const void *a, const void *b)
+{
+	const Edge_Event *edge_a = a;
+	const Edge_Event *edge_b = b;
+
+	if (edge_a->time_ns < edge_b->time_ns)
+	{
+		return -1;
+	}
+	return edge_a->time_ns > edge_b->time_ns;
+}
+
+// Builds the pin toggles of one configuration and returns the number of events
+static uint32_t Build_Waveform(Edge_Event *events, uint32_t detents, uint32_t speed, uint32_t jitter_percent,
+	const Bounce_Profile *bounce, uint64_t *turn_end_ns)
+{
+	uint64_t period_ns = NS_PER_S / ((uint64_t)speed * 4);
+	uint64_t jitter_ns = period_ns * jitter_percent / 100;
+	uint64_t time_ns = TURN_PAUSE_NS;
+	uint32_t count = 0;
+	uint8_t position = 0;
+
+	for (int direction = 1; direction >= -1; direction -= 2)
+	{
+		for (uint32_t transition = 0; transition < detents * 4; transition++)
+		{
+			uint8_t last_state = clockwise_sequence[position];
+			position = (uint8_t)((position + direction) & 0x03);
+			uint8_t pin_mask = last_state ^ clockwise_sequence[position];
+
+			// The jitter is kept below half a period so the transitions never swap order
+			uint64_t edge_ns = (uint64_t)((int64_t)time_ns + Random_Spread(jitter_ns));
+			events[count].time_ns = edge_ns;
+			events[count].pin_mask = pin_mask;
+			count++;
+
+			// Bounce toggles come in pairs, so the pin settles at its new level within the window.
+			// The window is clipped so that the pin settles before the other pin changes.
+			uint64_t window_ns = (uint64_t)bounce->window_us * NS_PER_US;
+			if (window_ns > period_ns / 4)
+			{
+				window_ns = period_ns / 4;
+			}
+			for (uint8_t toggle = 0; toggle < bounce->toggles && window_ns > 1; toggle++)
+			{
+				events[count].time_ns = edge_ns + 1 + (Random_Next() % (window_ns - 1));
+				events[count].pin_mask = pin_mask;
+				count++;
+			}
+			if (bounce->toggles & 0x01)
+			{
+				count--;
+			}
+
+			time_ns = time_ns + period_ns;
+		}
+
+		if (direction > 0)
+		{
+			*turn_end_ns = time_ns + TURN_PAUSE_NS / 2;
+			time_ns = time_ns + TURN_PAUSE_NS;
+		}
+	}
+
+	qsort(events, count, sizeof(Edge_Event), Edge_Event_Compare);
+
+	return count;
+}
+
+// Sets the host GPIOD->DATA pins and runs the selected decoder through PMOD_ENC_Get_State
+static int Decode_Sample(uint8_t decoder, uint8_t pins, uint8_t *last_state)
+{
+	GPIOD->DATA = (GPIOD->DATA & ~(uint32_t)PMOD_ENC_ALL_PINS_MASK) | pins;
+
+	uint8_t state = PMOD_ENC_Get_State();
+	int step;
+
+	if (decoder == DECODER_TABLE)
+	{
+		step = PMOD_ENC_Decode_Rotation(state, *last_state);
+	}
+	else
+	{
+		step = PMOD_ENC_Get_Rotation(state, *last_state);
+	}
+
+	*last_state = state;
+	return step;
+}
+
+// Scores one turn from the steps counted in the right and in the wrong direction
+static void Score_Turn(int32_t expected, Stress_Result *result, int32_t right_steps, int32_t wrong_steps)
+{
+	result->expected += (uint32_t)abs(expected);
+	result->counted += (uint32_t)right_steps;
+	result->wrong += (uint32_t)wrong_steps;
+
+	if (right_steps < abs(expected))
+	{
+		result->missed += (uint32_t)(abs(expected) - right_steps);
+	}
+	else
+	{
+		result->extra += (uint32_t)(right_steps - abs(expected));
+	}
+}
+
+static Stress_Result Run_Configuration(uint8_t decoder, const Strategy *strategy, const Bounce_Profile *bounce,
+	uint32_t speed, uint32_t detents, uint32_t jitter_percent, Edge_Event *events)
+{
+	Stress_Result result;
+	uint64_t turn_end_ns = 0;
+	uint32_t event_count = Build_Waveform(events, detents, speed, jitter_percent, bounce, &turn_end_ns);
+	uint64_t end_ns = events[event_count - 1].time_ns + TURN_PAUSE_NS;
+
+	// Positive and negative steps of each turn are counted separately
+	int32_t steps[2][2] = {{0, 0}, {0, 0}};
+	uint8_t pins = 0x00;
+	uint8_t last_state = 0x00;
+	uint32_t next_event = 0;
+
+	memset(&result, 0, sizeof(result));
+	PMOD_ENC_Set_Detent_Scale(PMOD_ENC_DEFAULT_DETENT_SCALE);
+	uint32_t error_count = PMOD_ENC_Get_Error_Count();
+
+	if (strategy->type == STRATEGY_POLL)
+	{
+		// The first poll happens at a random phase of the poll period
+		uint64_t poll_ns = NS_PER_S / strategy->poll_hz;
+		for (uint64_t time_ns = Random_Next() % poll_ns; time_ns < end_ns; time_ns += poll_ns)
+		{
+			while (next_event < event_count && events[next_event].time_ns <= time_ns)
+			{
+				pins ^= events[next_event].pin_mask;
+				next_event++;
+			}
+
+			int step = Decode_Sample(decoder, pins, &last_state);
+			int turn = (time_ns >= turn_end_ns);
+			steps[turn][step < 0] += abs(step);
+		}
+	}
+	else
+	{
+		// Each edge sets the pending flag. The handler acknowledges the flag after the interrupt
+		// latency and samples the pins; edges until then are merged into the same interrupt.
+		uint64_t latency_ns = (uint64_t)strategy->latency_us * NS_PER_US;
+		uint64_t busy_until_ns = 0;
+
+		while (next_event < event_count)
+		{
+			uint64_t edge_ns = events[next_event].time_ns;
+			uint64_t service_ns = (edge_ns > busy_until_ns ? edge_ns : busy_until_ns) + latency_ns;
+
+			while (next_event < event_count && events[next_event].time_ns <= service_ns)
+			{
+				pins ^= events[next_event].pin_mask;
+				next_event++;
+			}
+
+			int step = Decode_Sample(decoder, pins, &last_state);
+			int turn = (service_ns >= turn_end_ns);
+			steps[turn][step < 0] += abs(step);
+
+			busy_until_ns = service_ns + HANDLER_NS;
+		}
+	}
+
+	// Clockwise steps are positive in the first turn and negative in the second turn
+	Score_Turn((int32_t)detents, &result, steps[0][0], steps[0][1]);
+	Score_Turn(-(int32_t)detents, &result, steps[1][1], steps[1][0]);
+
+	result.invalid = PMOD_ENC_Get_Error_Count() - error_count;
+
+	return result;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t detents = 100;
+	uint32_t jitter_percent = 10;
+	uint64_t seed = 1;
+	int csv = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			detents = (uint32_t)strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+		{
+			jitter_percent = (uint32_t)strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			seed = strtoull(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-c") == 0)
+		{
+			csv = 1;
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-n detents] [-j jitter_percent] [-s seed] [-c]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (detents == 0 || jitter_percent >= 50)
+	{
+		fprintf(stderr, "The number of detents must be at least 1 and the jitter must be below 50 %%\n");
+		return 1;
+	}
+	random_state = seed ? seed : 1;
+
+	// Every transition can carry its own bounce toggles
+	uint32_t max_toggles = 0;
+	for (uint32_t b = 0; b < BOUNCE_COUNT; b++)
+	{
+		if (bounce_profiles[b].toggles > max_toggles)
+		{
+			max_toggles = bounce_profiles[b].toggles;
+		}
+	}
+	Edge_Event *events = malloc(sizeof(Edge_Event) * detents * 8 * (1 + max_toggles));
+	if (events == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+
+	PMOD_ENC_Init();
+
+	uint32_t max_clean_speed[2][STRATEGY_COUNT][BOUNCE_COUNT];
+	memset(max_clean_speed, 0, sizeof(max_clean_speed));
+
+	if (csv)
+	{
+		printf("decoder,strategy,bounce,speed,expected,counted,missed,extra,wrong,invalid\n");
+	}
+	else
+	{
+		printf("PMOD ENC stress: %u detents each way, %u %% jitter, seed %llu\n\n",
+			detents, jitter_percent, (unsigned long long)seed);
+		printf("%-7s %-12s %-6s %8s %9s %8s %7s %6s %6s %8s\n",
+			"decoder", "strategy", "bounce", "det/s", "expected", "counted", "missed", "extra", "wrong", "invalid");
+	}
+
+	for (uint8_t decoder = DECODER_LEGACY; decoder <= DECODER_TABLE; decoder++)
+	{
+		for (uint32_t s = 0; s < STRATEGY_COUNT; s++)
+		{
+			for (uint32_t b = 0; b < BOUNCE_COUNT; b++)
+			{
+				uint8_t clean = 1;
+
+				for (uint32_t v = 0; v < SPEED_COUNT; v++)
+				{
+					Stress_Result result = Run_Configuration(decoder, &strategies[s], &bounce_profiles[b],
+						speeds[v], detents, jitter_percent, events);
+
+					// The throughput limit is the last speed before the first error
+					if (clean && result.missed == 0 && result.extra == 0 && result.wrong == 0)
+					{
+						max_clean_speed[decoder][s][b] = speeds[v];
+					}
+					else
+					{
+						clean = 0;
+					}
+
+					printf(csv ? "%s,%s,%s,%u,%u,%u,%u,%u,%u,%u\n" : "%-7s %-12s %-6s %8u %9u %8u %7u %6u %6u %8u\n",
+						decoder_names[decoder], strategies[s].name, bounce_profiles[b].name, speeds[v],
+						result.expected, result.counted, result.missed, result.extra, result.wrong, result.invalid);
+				}
+			}
+		}
+	}
+
+	if (!csv)
+	{
+		printf("\nHighest speed without errors (detents per second, 0 = errors at the lowest speed)\n");
+		printf("%-7s %-12s", "decoder", "strategy");
+		for (uint32_t b = 0; b < BOUNCE_COUNT; b++)
+		{
+			printf(" %8s", bounce_profiles[b].name);
+		}
+		printf("\n");
+
+		for (uint8_t decoder = DECODER_LEGACY; decoder <= DECODER_TABLE; decoder++)
+		{
+			for (uint32_t s = 0; s < STRATEGY_COUNT; s++)
+			{
+				printf("%-7s %-12s", decoder_names[decoder], strategies[s].name);
+				for (uint32_t b = 0; b < BOUNCE_COUNT; b++)
+				{
+					printf(" %8u", max_clean_speed[decoder][s][b]);
+				}
+				printf("\n");
+			}
+		}
+	}
+
+	free(events);
+	return 0;
+}
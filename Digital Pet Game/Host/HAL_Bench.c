@@ -0,0 +1,183 @@
+/**
+ * @file HAL_Bench.c
+ *
+ * @brief Host check and benchmark of the register accesses through the HAL against direct access.
+ *
+ * This program runs both functions of every pair of HAL_Pairs.c on the host registers, with the
+ * host backend of the HAL (HAL.h), and checks that they return the same values and leave the same
+ * registers for random pin levels and values. It then measures the time per call of both functions.
+ *
+ * The host backend reads and writes the GPIO DATA register itself with a read-modify-write, which
+ * is not the code of the Cortex-M4 backend, where the GPIO accesses go through the DATA address
+ * mask. The timings therefore only compare the host versions, where some HAL versions are slower,
+ * and say nothing about the cycles of the HAL on the board. make hal-check in GCC/ compares the
+ * Cortex-M4 code size of both functions of every pair.
+ *
+ * Usage: hal_bench [calls]
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// clock_gettime is a POSIX function
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "TM4C123GH6PM.h"
+#include "HAL_Pairs.h"
+
+#define CHECK_COUNT 100000UL
+
+typedef struct
+{
+	const char *name;
+	uint32_t (*direct)(uint32_t value);
+	uint32_t (*hal)(uint32_t value);
+} Pair;
+
+#define PAIR_ENTRY(access) { #access, &Pair_Direct_##access, &Pair_HAL_##access },
+
+static const Pair pairs[] =
+{
+	HAL_PAIRS(PAIR_ENTRY)
+};
+
+#define PAIR_COUNT (sizeof(pairs) / sizeof(pairs[0]))
+
+// Registers used by the pairs
+typedef struct
+{
+	GPIOA_Type gpioc;
+	GPIOA_Type gpiod;
+	GPIOA_Type gpiof;
+	TIMER0_Type timer0;
+	SSI0_Type ssi2;
+	uint32_t task_count;
+} Registers;
+
+static uint32_t random_state = 1;
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static void Save_Registers(Registers *registers)
+{
+	registers->gpioc = Host_GPIOC;
+	registers->gpiod = Host_GPIOD;
+	registers->gpiof = Host_GPIOF;
+	registers->timer0 = Host_TIMER0;
+	registers->ssi2 = Host_SSI2;
+	registers->task_count = pair_task_count;
+}
+
+static void Load_Registers(const Registers *registers)
+{
+	Host_GPIOC = registers->gpioc;
+	Host_GPIOD = registers->gpiod;
+	Host_GPIOF = registers->gpiof;
+	Host_TIMER0 = registers->timer0;
+	Host_SSI2 = registers->ssi2;
+	pair_task_count = registers->task_count;
+}
+
+// Random pin levels and a pending Timer 0B interrupt, as in the handler, and a value for the pins written
+static uint32_t Randomize_Registers(void)
+{
+	memset(&Host_TIMER0, 0, sizeof(Host_TIMER0));
+	memset(&Host_SSI2, 0, sizeof(Host_SSI2));
+	Host_GPIOC.DATA = Random() & 0xFF;
+	Host_GPIOD.DATA = Random() & 0xFF;
+	Host_GPIOF.DATA = Random() & 0xFF;
+	Host_TIMER0.MIS = 0x100;
+	pair_task_count = Random();
+
+	// The RGB LED pair writes PF1 - PF3, so the value only holds those pins
+	return Random() & 0x0E;
+}
+
+static uint32_t Check_Pair(const Pair *pair)
+{
+	uint32_t errors = 0;
+	Registers start;
+	Registers direct;
+
+	for (uint32_t i = 0; i < CHECK_COUNT && errors < 10; i++)
+	{
+		uint32_t value = Randomize_Registers();
+		Save_Registers(&start);
+
+		uint32_t direct_result = pair->direct(value);
+		Save_Registers(&direct);
+
+		Load_Registers(&start);
+		uint32_t hal_result = pair->hal(value);
+
+		if (direct_result != hal_result || memcmp(&direct.gpioc, &Host_GPIOC, sizeof(Host_GPIOC)) != 0 ||
+			memcmp(&direct.gpiod, &Host_GPIOD, sizeof(Host_GPIOD)) != 0 ||
+			memcmp(&direct.gpiof, &Host_GPIOF, sizeof(Host_GPIOF)) != 0 ||
+			memcmp(&direct.timer0, &Host_TIMER0, sizeof(Host_TIMER0)) != 0 ||
+			memcmp(&direct.ssi2, &Host_SSI2, sizeof(Host_SSI2)) != 0 || direct.task_count != pair_task_count)
+		{
+			printf("FAIL: %s differs for the value 0x%02X\n", pair->name, value);
+			errors++;
+		}
+	}
+	return errors;
+}
+
+// Time per call in nanoseconds
+static double Time_Calls(uint32_t (*function)(uint32_t value), unsigned long calls)
+{
+	double start = Seconds_Now();
+
+	for (unsigned long i = 0; i < calls; i++)
+	{
+		function((uint32_t)(i << 1) & 0x0E);
+	}
+	return (Seconds_Now() - start) * 1e9 / (double)calls;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long calls = (argc > 1) ? strtoul(argv[1], 0, 10) : 20000000UL;
+	uint32_t errors = 0;
+
+	for (uint32_t i = 0; i < PAIR_COUNT; i++)
+	{
+		errors += Check_Pair(&pairs[i]);
+	}
+
+	printf("%-20s %10s %10s %7s\n", "Access", "Direct ns", "HAL ns", "HAL/dir");
+	for (uint32_t i = 0; i < PAIR_COUNT; i++)
+	{
+		Randomize_Registers();
+
+		// Warm up both functions, then time one after the other
+		Time_Calls(pairs[i].direct, calls / 10);
+		Time_Calls(pairs[i].hal, calls / 10);
+		double direct_ns = Time_Calls(pairs[i].direct, calls);
+		double hal_ns = Time_Calls(pairs[i].hal, calls);
+
+		printf("%-20s %10.2f %10.2f %7.2f\n", pairs[i].name, direct_ns, hal_ns, hal_ns / direct_ns);
+	}
+
+	printf("\n%s\n", errors ? "FAILED" : "PASSED");
+	return errors ? 1 : 0;
+}
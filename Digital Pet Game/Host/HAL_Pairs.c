@@ -0,0 +1,121 @@
+/**
+ * @file HAL_Pairs.c
+ *
+ * @brief Register accesses of the drivers written by hand and through the HAL.
+ *
+ * The direct functions keep the register code of the drivers from before the HAL (HAL.h). The host
+ * benchmark (HAL_Bench.c) runs both functions of every pair on the host registers, and the GCC
+ * build compiles this file for the Cortex-M4 and compares their code (make hal-check in GCC/).
+ *
+ * @note The device header is only included through HAL.h, so that the GCC build takes the device
+ * header of the TM4C device family pack instead of the host stand-in of this directory.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "HAL.h"
+#include "HAL_Pairs.h"
+
+volatile uint32_t pair_task_count = 0;
+
+// Task called through the task pointer by the trampoline of the Timer_Dispatch pair
+static void Pair_Task(void)
+{
+	pair_task_count++;
+}
+
+static void (*pair_task)(void) = &Pair_Task;
+
+uint32_t Pair_Direct_Seven_Segment_Write(uint32_t value)
+{
+	GPIOC->DATA &= ~0x80;
+	SSI2->DR = (uint8_t)value;
+	while (SSI2->SR & 0x10);
+	GPIOC->DATA |= 0x80;
+	return 0;
+}
+
+uint32_t Pair_HAL_Seven_Segment_Write(uint32_t value)
+{
+	HAL_GPIO_Clear(HAL_PIN_SEVEN_SEGMENT_CS);
+	HAL_SSI_Write(HAL_SSI_SEVEN_SEGMENT, (uint8_t)value);
+	HAL_GPIO_Set(HAL_PIN_SEVEN_SEGMENT_CS);
+	return 0;
+}
+
+uint32_t Pair_Direct_RGB_LED_Output(uint32_t value)
+{
+	GPIOF->DATA = (GPIOF->DATA & 0xF1) | value;
+	return 0;
+}
+
+uint32_t Pair_HAL_RGB_LED_Output(uint32_t value)
+{
+	HAL_GPIO_Write(HAL_PIN_RGB_LED, value);
+	return 0;
+}
+
+uint32_t Pair_Direct_PMOD_ENC_Read(uint32_t value)
+{
+	(void)value;
+	return GPIOD->DATA & 0x0F;
+}
+
+uint32_t Pair_HAL_PMOD_ENC_Read(uint32_t value)
+{
+	(void)value;
+	return HAL_GPIO_Read(HAL_PIN_PMOD_ENC);
+}
+
+uint32_t Pair_Direct_LCD_Pulse_Enable(uint32_t value)
+{
+	(void)value;
+	GPIOC->DATA &= ~0x40;
+	GPIOC->DATA |= 0x40;
+	GPIOC->DATA &= ~0x40;
+	return 0;
+}
+
+uint32_t Pair_HAL_LCD_Pulse_Enable(uint32_t value)
+{
+	(void)value;
+	HAL_GPIO_Clear(HAL_PIN_LCD_E);
+	HAL_GPIO_Set(HAL_PIN_LCD_E);
+	HAL_GPIO_Clear(HAL_PIN_LCD_E);
+	return 0;
+}
+
+uint32_t Pair_Direct_Timer_Clear(uint32_t value)
+{
+	(void)value;
+	TIMER0->ICR |= 0x100;
+	return 0;
+}
+
+uint32_t Pair_HAL_Timer_Clear(uint32_t value)
+{
+	(void)value;
+	HAL_Timer_Clear(HAL_TIMER_0B);
+	return 0;
+}
+
+// The trampoline handler of the timer driver, without the code of its task
+uint32_t Pair_Direct_Timer_Dispatch(uint32_t value)
+{
+	(void)value;
+	if (TIMER0->MIS & 0x0100)
+	{
+		(*pair_task)();
+		TIMER0->ICR |= 0x100;
+	}
+	return 0;
+}
+
+// The task bound to the vector, which clears its interrupt itself
+uint32_t Pair_HAL_Timer_Dispatch(uint32_t value)
+{
+	(void)value;
+	HAL_Timer_Clear(HAL_TIMER_0B);
+	pair_task_count++;
+	return 0;
+}
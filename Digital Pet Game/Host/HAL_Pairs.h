@@ -0,0 +1,31 @@
+/**
+ * @file HAL_Pairs.h
+ *
+ * @brief Header file for the register accesses of the drivers written by hand and through the HAL.
+ *
+ * Every access of HAL_PAIRS comes in a pair of functions: Pair_Direct_<access> with the register
+ * code that the drivers used before the HAL (HAL.h), and Pair_HAL_<access> with the HAL code that
+ * replaced it. Both take the value to write and return the value read or a count, so the pairs can
+ * be called through one function type.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+// Pairs: X(access)
+#define HAL_PAIRS(X) \
+	X(Seven_Segment_Write) /* SSI2_Write: slave select, SSI2 frame and wait */ \
+	X(RGB_LED_Output)      /* RGB_LED_Output: PF1 - PF3 */ \
+	X(PMOD_ENC_Read)       /* PMOD_ENC_Get_State: PD0 - PD3 */ \
+	X(LCD_Pulse_Enable)    /* EduBase_LCD_Pulse_Enable without the delays: PC6 */ \
+	X(Timer_Clear)         /* Time-out interrupt clear of Timer 0B */ \
+	X(Timer_Dispatch)      /* Timer 0B trampoline and task pointer, against the task bound to the vector */
+
+#define HAL_PAIRS_DECLARE(access) \
+	uint32_t Pair_Direct_##access(uint32_t value); \
+	uint32_t Pair_HAL_##access(uint32_t value);
+HAL_PAIRS(HAL_PAIRS_DECLARE)
+
+// Count of the task of the Timer_Dispatch pair
+extern volatile uint32_t pair_task_count;
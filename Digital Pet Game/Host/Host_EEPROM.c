@@ -0,0 +1,83 @@
+/**
+ * @file Host_EEPROM.c
+ *
+ * @brief EEPROM model for the host stand-in of the TM4C123GH6PM device header.
+ *
+ * The EEPROM registers cannot be plain variables like the other peripherals, because reading
+ * EERDWR returns the word at the address selected by EEBLOCK and EEOFFSET. The EEPROM macro of the
+ * host header calls Host_EEPROM_Access before every register access, which first stores a word
+ * written to EERDWR or EERDWRINC since the previous access, then loads both data registers with
+ * the word at the selected address.
+ *
+ * A stored word keeps the WORKING bit of EEDONE set for Host_EEPROM_Busy_Accesses accesses. A word
+ * written while WORKING is set is counted in Host_EEPROM_Busy_Errors and dropped, since the
+ * hardware does not accept it either. Setting Host_EEPROM_Writes_Left cuts the power after that
+ * many words: later words are dropped, as if the board had been turned off.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+uint32_t Host_EEPROM_Storage[HOST_EEPROM_WORDS];
+uint32_t Host_EEPROM_Write_Count[HOST_EEPROM_WORDS];
+uint32_t Host_EEPROM_Busy_Accesses = 4;
+uint32_t Host_EEPROM_Writes_Left = 0xFFFFFFFF;
+uint32_t Host_EEPROM_Accesses = 0;
+uint32_t Host_EEPROM_Busy_Errors = 0;
+
+static EEPROM_Type registers = {.EESIZE = (32 << 16) | HOST_EEPROM_WORDS};
+static uint32_t loaded_word = 0;
+static uint32_t loaded_address = 0;
+static uint32_t busy_left = 0;
+
+static void Host_EEPROM_Store(uint32_t address, uint32_t word)
+{
+	if (busy_left > 0)
+	{
+		Host_EEPROM_Busy_Errors++;
+		return;
+	}
+	if (Host_EEPROM_Writes_Left == 0)
+	{
+		return;
+	}
+	if (Host_EEPROM_Writes_Left != 0xFFFFFFFF)
+	{
+		Host_EEPROM_Writes_Left--;
+	}
+	Host_EEPROM_Storage[address] = word;
+	Host_EEPROM_Write_Count[address]++;
+	busy_left = Host_EEPROM_Busy_Accesses;
+}
+
+EEPROM_Type *Host_EEPROM_Access(void)
+{
+	Host_EEPROM_Accesses++;
+
+	if (busy_left > 0)
+	{
+		busy_left--;
+	}
+
+	// Store the word written since the previous access. Writing the word already stored is not
+	// detected, which changes nothing but the write count.
+	if (registers.EERDWR != loaded_word)
+	{
+		Host_EEPROM_Store(loaded_address, registers.EERDWR);
+	}
+	else if (registers.EERDWRINC != loaded_word)
+	{
+		Host_EEPROM_Store(loaded_address, registers.EERDWRINC);
+		registers.EEOFFSET = (registers.EEOFFSET + 1) & 0x0F;
+	}
+
+	registers.EEDONE = (busy_left > 0) ? 0x01 : 0x00;
+
+	loaded_address = ((registers.EEBLOCK & 0x1F) << 4) | (registers.EEOFFSET & 0x0F);
+	loaded_word = Host_EEPROM_Storage[loaded_address];
+	registers.EERDWR = loaded_word;
+	registers.EERDWRINC = loaded_word;
+
+	return &registers;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file Host_Flash.c
+ *
+ * @brief Flash memory model for the host stand-in of the TM4C123GH6PM device header.
+ *
+ * The FLASH_CTRL macro of the host header calls Host_Flash_Access before every register access.
+ * A WRITE or ERASE command written to FMC with the write key is carried out there, and FMC then
+ * reads 0, so the driver sees the command done on its first poll. The flash memory itself is the
+ * Host_Flash_Memory array, which the driver reads through FLASH_MEMORY_BASE. Host tools erase
+ * it with memset before use, since the array starts as zeros.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <string.h>
+
+#include "TM4C123GH6PM.h"
+
+#define HOST_FLASH_KEY      0xA442
+#define HOST_FLASH_WRITE    0x01
+#define HOST_FLASH_ERASE    0x02
+
+uint32_t Host_Flash_Memory[HOST_FLASH_SIZE / 4];
+uint32_t Host_Flash_Erase_Count[HOST_FLASH_PAGES];
+uint32_t Host_Flash_Programs = 0;
+uint32_t Host_Flash_Erases = 0;
+uint32_t Host_Flash_Reprogram_Errors = 0;
+
+static FLASH_CTRL_Type registers;
+
+FLASH_CTRL_Type *Host_Flash_Access(void)
+{
+	uint32_t command = registers.FMC;
+	uint32_t address = registers.FMA & (HOST_FLASH_SIZE - 1);
+
+	if ((command >> 16) == HOST_FLASH_KEY && (command & HOST_FLASH_WRITE))
+	{
+		if (Host_Flash_Memory[address / 4] != 0xFFFFFFFF)
+		{
+			Host_Flash_Reprogram_Errors++;
+		}
+		Host_Flash_Memory[address / 4] &= registers.FMD;
+		Host_Flash_Programs++;
+	}
+	else if ((command >> 16) == HOST_FLASH_KEY && (command & HOST_FLASH_ERASE))
+	{
+		memset(&Host_Flash_Memory[(address & ~1023u) / 4], 0xFF, 1024);
+		Host_Flash_Erase_Count[address / 1024]++;
+		Host_Flash_Erases++;
+	}
+	registers.FMC = 0;
+
+	return &registers;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file Host_Pets.c
+ *
+ * @brief Host stand-in of the pet drawings.
+ *
+ * The host tools link the level table (Levels.c), which points to the pet drawing functions.
+ * There is no LCD on the host, so the drawings do nothing.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Pets.h"
+
+void Dog_Display(void)
+{
+}
+
+void Turtle_Display(void)
+{
+}
+
+void Crow_Display(void)
+{
+}
+
+void Cat_Display(void)
+{
+}
@@ -0,0 +1,56 @@
+/**
+ * @file Host_RTC.c
+ *
+ * @brief Hibernation module RTC model for the host stand-in of the TM4C123GH6PM device header.
+ *
+ * The HIB macro of the host header calls Host_HIB_Access before every register access. The RTC
+ * count is kept in 1/32768 seconds, and RTCC and RTCSS are loaded from it on every access. A value
+ * written to RTCLD since the previous access replaces the seconds of the count and clears the
+ * subseconds, as on the hardware. Writing the value already in RTCLD is not detected.
+ *
+ * Host tools move the time forward with Host_RTC_Advance, both while the firmware runs and while
+ * the board is "off": the count survives a reset of the firmware, as it does from VBAT.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <string.h>
+
+#include "TM4C123GH6PM.h"
+
+#define HOST_HIB_RTCEN      0x00000001
+#define HOST_HIB_WRC        0x80000000
+
+static HIB_Type registers;
+static uint32_t loaded_seconds = 0;
+static uint64_t count = 0;
+
+void Host_RTC_Advance(uint64_t ms)
+{
+	if (registers.CTL & HOST_HIB_RTCEN)
+	{
+		count += ms * 32768 / 1000;
+	}
+}
+
+void Host_RTC_Remove_Battery(void)
+{
+	memset(&registers, 0, sizeof(registers));
+	loaded_seconds = 0;
+	count = 0;
+}
+
+HIB_Type *Host_HIB_Access(void)
+{
+	if (registers.RTCLD != loaded_seconds)
+	{
+		loaded_seconds = registers.RTCLD;
+		count = (uint64_t)loaded_seconds << 15;
+	}
+	
+	registers.RTCC = (uint32_t)(count >> 15);
+	registers.RTCSS = (uint32_t)(count & 0x7FFF);
+	registers.CTL |= HOST_HIB_WRC;
+	
+	return &registers;
+}
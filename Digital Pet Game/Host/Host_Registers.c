@@ -0,0 +1,35 @@
+/**
+ * @file Host_Registers.c
+ *
+ * @brief Register variables for the host stand-in of the TM4C123GH6PM device header.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+#include "Clock.h"
+#include "Interrupts.h"
+
+GPIOA_Type Host_GPIOA;
+GPIOA_Type Host_GPIOB;
+GPIOA_Type Host_GPIOC;
+GPIOA_Type Host_GPIOD;
+GPIOA_Type Host_GPIOE;
+GPIOA_Type Host_GPIOF;
+TIMER0_Type Host_TIMER0;
+TIMER0_Type Host_TIMER1;
+TIMER0_Type Host_TIMER2;
+WTIMER0_Type Host_WTIMER0;
+WTIMER0_Type Host_WTIMER2;
+SSI0_Type Host_SSI2;
+SYSCTL_Type Host_SYSCTL;
+NVIC_Type Host_NVIC;
+SysTick_Type Host_SysTick;
+SCB_Type Host_SCB;
+
+uint32_t SystemCoreClock = CLOCK_SYSTEM_HZ;
+
+void (*Host_WFI_Hook)(void) = 0;
+
+// Vector table of the startup code, which has no stack or reset vector on the host
+void (* const __Vectors[INTERRUPTS_VECTOR_COUNT])(void) = { 0 };
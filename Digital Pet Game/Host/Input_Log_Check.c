@@ -0,0 +1,394 @@
+/**
+ * @file Input_Log_Check.c
+ *
+ * @brief Host check of the input record and replay log and of the PMOD ENC replay.
+ *
+ * This program runs three checks:
+ *  - Round trip: a random stream of input changes, with idle gaps of up to several hours, is
+ *    encoded by Input_Log_Record and decoded by Input_Log_Next. Every state must come back in
+ *    order, the encoder pin changes at their exact time and the button and switch changes within
+ *    one coarse tick (INPUT_LOG_COARSE_TICK_US). Input_Log_Update_Time is called as often as the
+ *    Timer 1A tick would, so no record may be counted as wrapped and the records must be less
+ *    than 2^31 us apart; without it, every gap that leaves INPUT_LOG_WRAP_US or more modulo 2^32 us
+ *    must be counted.
+ *  - Full buffer: a small log must record the changes that fit, count every other change as
+ *    dropped, and decode exactly the recorded changes.
+ *  - Replay: a session longer than 2^32 us (about 72 minutes), with an idle gap longer than
+ *    INPUT_LOG_WRAP_US, is recorded through PMOD_ENC_Get_State while Wide Timer 0 crosses the
+ *    2^32 us wrap of Timebase_Get_Us, then replayed by PMOD_ENC_Replay_Tick every 1 ms. Every
+ *    encoder edge must reach the edge task in order, at the first tick at or after its recorded time.
+ *
+ * Usage: input_log_check [-s seed]
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TM4C123GH6PM.h"
+#include "Input_Log.h"
+#include "PMOD_ENC.h"
+#include "Timebase.h"
+
+#define US_PER_MINUTE       60000000ULL
+
+// Period of the replay tick (Timer 1A)
+#define TICK_US             1000
+
+#define ROUND_TRIP_CHANGES  20000
+#define FULL_LOG_SIZE       64
+#define FULL_LOG_CHANGES    100
+
+// Replay session: knob turns and clicks for REPLAY_MINUTES, with one idle gap in the middle
+#define REPLAY_MINUTES      80
+#define REPLAY_IDLE_MINUTES 40
+#define REPLAY_LOG_SIZE     65536
+#define REPLAY_MAX_CHANGES  65536
+
+// Clockwise quadrature sequence of (B << 1) | A, see the transition table in PMOD_ENC.c
+static const uint8_t clockwise_sequence[4] = {0x00, 0x02, 0x03, 0x01};
+
+typedef struct
+{
+	uint64_t time_us;
+	uint8_t state;
+} Change;
+
+static uint32_t random_state = 1;
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static uint8_t log_buffer[REPLAY_LOG_SIZE];
+static Change changes[ROUND_TRIP_CHANGES > REPLAY_MAX_CHANGES ? ROUND_TRIP_CHANGES : REPLAY_MAX_CHANGES];
+
+// Encoder edges delivered to the edge task during the replay
+static Change delivered[REPLAY_MAX_CHANGES];
+static uint32_t delivered_count = 0;
+
+// True time of the simulated board
+static uint64_t now_us = 0;
+
+// Returns whether a decoded time matches the time of a change, given the previous state
+static uint8_t Time_Matches(uint32_t decoded_us, uint64_t change_us, uint8_t edges)
+{
+	uint32_t late_us = (uint32_t)change_us - decoded_us;
+
+	// The fraction of a coarse tick is carried to the next record, so a change is decoded up to
+	// one tick early, and an encoder pin change at its exact time
+	return (edges & INPUT_LOG_FINE_MASK) ? (late_us == 0) : (late_us < INPUT_LOG_COARSE_TICK_US);
+}
+
+static uint32_t Check_Round_Trip(uint8_t update_time)
+{
+	Input_Log_Type log;
+	Input_Log_Reader reader;
+	uint64_t time_us = 0x12345678;
+	uint64_t start_us = time_us;
+	uint8_t state = 0;
+	uint32_t errors = 0;
+	uint32_t long_gaps = 0;
+
+	Input_Log_Init(&log, log_buffer, sizeof(log_buffer), state, (uint32_t)time_us);
+
+	for (uint32_t i = 0; i < ROUND_TRIP_CHANGES; i++)
+	{
+		uint8_t edges = (uint8_t)(1 << (Random() % 4));
+		uint64_t gap_us = (edges & INPUT_LOG_FINE_MASK) ? Random() % 5000 : Random() % 4000000;
+
+		// Now and then the input stays unchanged for up to 4.5 hours
+		if (Random() % 200 == 0)
+		{
+			gap_us += (uint64_t)(Random() % 270) * US_PER_MINUTE;
+		}
+		// Without time records, only a gap that leaves INPUT_LOG_WRAP_US or more modulo 2^32 us can be seen
+		if ((uint32_t)gap_us >= INPUT_LOG_WRAP_US)
+		{
+			long_gaps++;
+		}
+
+		// The Timer 1A tick runs much more often, but every INPUT_LOG_MAX_GAP_US / 4 is enough
+		if (update_time)
+		{
+			for (uint64_t tick_us = time_us + INPUT_LOG_MAX_GAP_US / 4; tick_us < time_us + gap_us;
+				tick_us += INPUT_LOG_MAX_GAP_US / 4)
+			{
+				Input_Log_Update_Time(&log, (uint32_t)tick_us);
+			}
+		}
+
+		time_us += gap_us;
+		state ^= edges;
+		Input_Log_Record(&log, state, (uint32_t)time_us);
+		changes[i].time_us = time_us - start_us;
+		changes[i].state = state;
+	}
+
+	if (!Input_Log_Reader_Init(&reader, log_buffer, log.length))
+	{
+		printf("FAIL: the round trip log header is invalid\n");
+		return 1;
+	}
+
+	uint32_t count = 0;
+	uint32_t time_records = 0;
+	uint32_t last_time_us = 0;
+	uint8_t last_state = 0;
+	while (Input_Log_Next(&reader))
+	{
+		// The replay compares the times of records one after the other by their signed difference
+		if (update_time && (int32_t)(reader.time_us - last_time_us) < 0)
+		{
+			if (errors++ < 5)
+			{
+				printf("FAIL: round trip record at %u us is more than 2^31 us after the previous one\n", reader.time_us);
+			}
+		}
+		last_time_us = reader.time_us;
+
+		if (reader.state == last_state)
+		{
+			time_records++;
+			continue;
+		}
+
+		// Without time records, the time of a change after a gap of 2^32 us or more has wrapped
+		if (count >= ROUND_TRIP_CHANGES || reader.state != changes[count].state || (update_time &&
+			!Time_Matches(reader.time_us, changes[count].time_us, reader.state ^ last_state)))
+		{
+			if (errors++ < 5)
+			{
+				printf("FAIL: round trip change %u decoded as state 0x%X at %u us\n", count, reader.state,
+					reader.time_us);
+			}
+		}
+		last_state = reader.state;
+		count++;
+	}
+
+	if (count != ROUND_TRIP_CHANGES || log.dropped_count != 0)
+	{
+		printf("FAIL: round trip decoded %u of %u changes, %u dropped\n", count, ROUND_TRIP_CHANGES, log.dropped_count);
+		errors++;
+	}
+	if (log.wrapped_count != (update_time ? 0 : long_gaps))
+	{
+		printf("FAIL: round trip counted %u wrapped records for %u long gaps\n", log.wrapped_count, long_gaps);
+		errors++;
+	}
+
+	printf("Round trip%s: %u changes, %u gaps of 2^31 us or more (modulo 2^32 us), %u time records, %u bytes (%.2f per change), %u wrapped\n",
+		update_time ? "" : " without time records", count, long_gaps, time_records, log.length,
+		(double)(log.length - INPUT_LOG_HEADER_SIZE) / count, log.wrapped_count);
+
+	return errors;
+}
+
+static uint32_t Check_Full_Log(void)
+{
+	Input_Log_Type log;
+	Input_Log_Reader reader;
+	uint32_t errors = 0;
+
+	Input_Log_Init(&log, log_buffer, FULL_LOG_SIZE, 0, 0);
+	for (uint32_t i = 1; i <= FULL_LOG_CHANGES; i++)
+	{
+		Input_Log_Record(&log, (i & 1) ? PMOD_ENC_BUTTON_MASK : 0, i * 1000000);
+	}
+
+	uint32_t decoded = 0;
+	Input_Log_Reader_Init(&reader, log_buffer, log.length);
+	while (Input_Log_Next(&reader))
+	{
+		decoded++;
+	}
+
+	if (log.record_count + log.dropped_count != FULL_LOG_CHANGES || decoded != log.record_count ||
+		log.dropped_count == 0 || log.length > FULL_LOG_SIZE)
+	{
+		printf("FAIL: ");
+		errors++;
+	}
+	printf("Full log: %u of %u changes recorded in %u bytes, %u decoded, %u dropped\n", log.record_count,
+		FULL_LOG_CHANGES, FULL_LOG_SIZE, decoded, log.dropped_count);
+
+	return errors;
+}
+
+// Sets the count of Wide Timer 0, so Timebase_Get_Us returns the lower 32 bits of now_us
+static void Set_Time(uint64_t time_us)
+{
+	uint64_t ticks = time_us * (TIMEBASE_CLOCK_HZ / 1000000);
+
+	now_us = time_us;
+	WTIMER0->TAV = (uint32_t)ticks;
+	WTIMER0->TBV = (uint32_t)(ticks >> 32);
+}
+
+// Runs the Timer 1A tick every TICK_US until the given time
+static void Run_Ticks(uint64_t until_us)
+{
+	uint64_t tick_us = (now_us / TICK_US + 1) * TICK_US;
+
+	for (; tick_us <= until_us; tick_us += TICK_US)
+	{
+		Set_Time(tick_us);
+		PMOD_ENC_Replay_Tick();
+	}
+	Set_Time(until_us);
+}
+
+static void Replay_Edge_Task(void)
+{
+	if (PMOD_ENC_Is_Replaying() && delivered_count < REPLAY_MAX_CHANGES)
+	{
+		delivered[delivered_count].time_us = now_us;
+		delivered[delivered_count].state = PMOD_ENC_Get_State();
+		delivered_count++;
+	}
+}
+
+// Sets the PMOD ENC pins and lets the driver see them, as its interrupts would
+static void Set_Pins(uint8_t state)
+{
+	GPIOD->DATA = (GPIOD->DATA & ~(uint32_t)PMOD_ENC_ALL_PINS_MASK) | state;
+	PMOD_ENC_Get_State();
+}
+
+static uint32_t Check_Replay(void)
+{
+	uint64_t idle_start_us = (REPLAY_MINUTES - REPLAY_IDLE_MINUTES) / 2 * US_PER_MINUTE;
+	uint32_t errors = 0;
+	uint32_t change_count = 0;
+	uint8_t state = 0;
+	uint8_t position = 0;
+
+	Timebase_Init();
+	PMOD_ENC_Init();
+	PMOD_ENC_Interrupt_Init(&Replay_Edge_Task);
+
+	// Timebase_Get_Us wraps 10 minutes into the recording
+	uint64_t record_start_us = (1ULL << 32) - 10 * US_PER_MINUTE;
+	Set_Time(record_start_us);
+	Set_Pins(state);
+	PMOD_ENC_Record_Start(log_buffer, REPLAY_LOG_SIZE);
+
+	while (now_us - record_start_us < REPLAY_MINUTES * US_PER_MINUTE && change_count + 64 < REPLAY_MAX_CHANGES)
+	{
+		uint64_t session_us = now_us - record_start_us;
+
+		if (session_us >= idle_start_us && session_us < idle_start_us + REPLAY_IDLE_MINUTES * US_PER_MINUTE)
+		{
+			Run_Ticks(record_start_us + idle_start_us + REPLAY_IDLE_MINUTES * US_PER_MINUTE);
+			continue;
+		}
+
+		// Either a turn of a few detents, with 2 to 20 ms between the edges, or a click with bounce
+		if (Random() % 2)
+		{
+			int direction = (Random() % 2) ? 1 : -1;
+
+			for (uint32_t edge = 0; edge < 4 * (1 + Random() % 4); edge++)
+			{
+				Run_Ticks(now_us + 2000 + Random() % 18000);
+				position = (uint8_t)((position + direction) & 0x03);
+				state = (uint8_t)((state & ~0x03) | clockwise_sequence[position]);
+				Set_Pins(state);
+				changes[change_count].time_us = now_us - record_start_us;
+				changes[change_count].state = state;
+				change_count++;
+			}
+		}
+		else
+		{
+			for (uint32_t edge = 0; edge < 2 * (1 + Random() % 3); edge++)
+			{
+				Run_Ticks(now_us + ((edge % 2) ? 50 + Random() % 500 : 80000 + Random() % 80000));
+				state ^= PMOD_ENC_BUTTON_MASK;
+				Set_Pins(state);
+			}
+		}
+		Run_Ticks(now_us + 1000000 + Random() % 20000000);
+	}
+
+	uint32_t length = PMOD_ENC_Record_Stop();
+	uint32_t dropped = PMOD_ENC_Record_Get_Dropped();
+	uint32_t wrapped = PMOD_ENC_Record_Get_Wrapped();
+	uint64_t session_us = now_us - record_start_us;
+
+	// Replay from a later time, so the elapsed time of the replay crosses 2^32 us at another point
+	Run_Ticks(now_us + 1234567);
+	uint64_t replay_start_us = now_us;
+	if (!PMOD_ENC_Replay_Start(log_buffer, length))
+	{
+		printf("FAIL: the recorded log header is invalid\n");
+		return 1;
+	}
+	while (PMOD_ENC_Is_Replaying() && now_us - replay_start_us < session_us + US_PER_MINUTE)
+	{
+		Run_Ticks(now_us + TICK_US);
+	}
+
+	for (uint32_t i = 0; i < change_count; i++)
+	{
+		uint64_t late_us = (i < delivered_count) ? (delivered[i].time_us - replay_start_us) - changes[i].time_us : 0;
+
+		if (i >= delivered_count || delivered[i].state != changes[i].state ||
+			delivered[i].time_us - replay_start_us < changes[i].time_us || late_us >= TICK_US)
+		{
+			if (errors++ < 5)
+			{
+				printf("FAIL: encoder edge %u recorded at %.3f s ", i, (double)changes[i].time_us * 1e-6);
+				if (i < delivered_count)
+				{
+					printf("was replayed at %.3f s\n", (double)(delivered[i].time_us - replay_start_us) * 1e-6);
+				}
+				else
+				{
+					printf("was not replayed\n");
+				}
+			}
+		}
+	}
+	if (delivered_count != change_count || dropped != 0 || wrapped != 0 || PMOD_ENC_Is_Replaying())
+	{
+		printf("FAIL: ");
+		errors++;
+	}
+	printf("Replay: %.1f minutes, %u encoder edges recorded, %u replayed, %u bytes, %u dropped, %u wrapped\n",
+		(double)session_us / US_PER_MINUTE, change_count, delivered_count, length, dropped, wrapped);
+
+	return errors;
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t errors = 0;
+
+	if (argc == 3 && strcmp(argv[1], "-s") == 0)
+	{
+		random_state = (uint32_t)strtoul(argv[2], NULL, 0);
+		random_state = random_state ? random_state : 1;
+	}
+	else if (argc != 1)
+	{
+		fprintf(stderr, "Usage: %s [-s seed]\n", argv[0]);
+		return 1;
+	}
+
+	errors += Check_Round_Trip(1);
+	errors += Check_Round_Trip(0);
+	errors += Check_Full_Log();
+	errors += Check_Replay();
+
+	printf("\n%s\n", errors ? "FAILED" : "PASSED");
+	return errors ? 1 : 0;
+}
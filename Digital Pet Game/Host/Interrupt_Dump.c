@@ -0,0 +1,214 @@
+/**
+ * @file Interrupt_Dump.c
+ *
+ * @brief Host check and dump of the NVIC registers written from the interrupt table.
+ *
+ * This program initializes the drivers of the game and the interrupt table (Interrupts.h) on the
+ * host registers, once with Interrupts_Init before the drivers and once after them, and checks that:
+ *  - AIRCR holds the key and the priority grouping of the table
+ *  - every IPR byte and the SysTick field of SHPR hold the priority of the table (0 if not listed)
+ *  - ISER enables exactly the device interrupts of the table
+ *  - both orders leave the same registers, so no driver writes the NVIC any more
+ *  - VTOR points to a vector table in SRAM aligned to 1024 bytes (INTERRUPTS_RAM_VECTORS)
+ *  - the Timer 1A vector runs the handler installed with Interrupts_Set_Handler once the table is
+ *    initialized, and every other vector the handler of the table
+ *  - the Timer 0B vector handler is the heartbeat task of PWM_PF1, bound at compile time (HAL.h)
+ *
+ * The dump lists every interrupt of the table with its priority fields, whether its vector runs the
+ * handler of the table or a handler installed by its driver, and the interrupts that can preempt it.
+ *
+ * Usage: interrupt_dump
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Interrupts.h"
+#include "HAL.h"
+#include "BCM_LED.h"
+#include "PMOD_ENC.h"
+#include "PWM_PF1.h"
+#include "Timer_1A_Interrupt.h"
+#include "SysTick_Delay.h"
+
+// SHPR index of the SysTick priority field (exception 15)
+#define SYSTICK_SHPR_INDEX 11
+
+static void No_Task(void)
+{
+}
+
+static void Reset_Registers(void)
+{
+	memset(&Host_NVIC, 0, sizeof(Host_NVIC));
+	memset(&Host_SCB, 0, sizeof(Host_SCB));
+}
+
+static void Init_Drivers(void)
+{
+	BCM_LED_Init(BCM_LED_MASK_ALL);
+	PMOD_ENC_Init();
+	PMOD_ENC_Interrupt_Init(&No_Task);
+	PMOD_ENC_Capture_Init();
+	PF1_PWM_Init();
+	Timer_1A_Interrupt_Init_Direct(&No_Task);
+	SysTick_Delay_Init();
+}
+
+static uint32_t Check_Registers(void)
+{
+	uint32_t errors = 0;
+	uint32_t expected_iser[8] = {0};
+
+	if (SCB->AIRCR != (0x05FA0000 | (INTERRUPTS_PRIGROUP << 8)))
+	{
+		printf("FAIL: AIRCR is 0x%08X\n", SCB->AIRCR);
+		errors++;
+	}
+
+	for (uint8_t i = 0; i < Interrupts_Get_Count(); i++)
+	{
+		int32_t irq = Interrupts_Get(i)->irq;
+		if (irq >= 0)
+		{
+			expected_iser[irq >> 5] |= (1UL << (irq & 0x1F));
+		}
+	}
+
+	for (int32_t irq = 0; irq < 240; irq++)
+	{
+		if (NVIC->IPR[irq] != Interrupts_Get_Priority(irq))
+		{
+			printf("FAIL: IPR[%d] is 0x%02X instead of 0x%02X\n", irq, NVIC->IPR[irq], Interrupts_Get_Priority(irq));
+			errors++;
+		}
+	}
+	for (int i = 0; i < 8; i++)
+	{
+		if (NVIC->ISER[i] != expected_iser[i])
+		{
+			printf("FAIL: ISER[%d] is 0x%08X instead of 0x%08X\n", i, NVIC->ISER[i], expected_iser[i]);
+			errors++;
+		}
+	}
+	if (SCB->SHPR[SYSTICK_SHPR_INDEX] != Interrupts_Get_Priority(SysTick_IRQn))
+	{
+		printf("FAIL: the SysTick priority is 0x%02X\n", SCB->SHPR[SYSTICK_SHPR_INDEX]);
+		errors++;
+	}
+	return errors;
+}
+
+// Whether the driver of an interrupt installs its handler straight into the vector
+static uint8_t Is_Direct(int32_t irq)
+{
+	return (irq == TIMER1A_IRQn);
+}
+
+static uint32_t Check_Vectors(uint8_t drivers_installed)
+{
+	uint32_t errors = 0;
+
+	// The vector table in the flash memory is only built for the target
+	if (!INTERRUPTS_RAM_VECTORS)
+	{
+		return 0;
+	}
+
+	if (SCB->VTOR == 0 || (SCB->VTOR & 0x3FF) != 0)
+	{
+		printf("FAIL: VTOR is 0x%08X\n", SCB->VTOR);
+		errors++;
+	}
+
+	// The vector handler bound at compile time is the task itself
+	if (HAL_BIND_TIMER_0B && Interrupts_Get_Handler(TIMER0B_IRQn) != &PF1_PWM_Timer_Handler)
+	{
+		printf("FAIL: the Timer 0B vector does not run PF1_PWM_Timer_Handler\n");
+		errors++;
+	}
+
+	for (uint8_t i = 0; i < Interrupts_Get_Count(); i++)
+	{
+		const Interrupts_Entry *entry = Interrupts_Get(i);
+		uint8_t direct = (Interrupts_Get_Handler(entry->irq) != entry->handler);
+
+		if (direct != (drivers_installed && Is_Direct(entry->irq)))
+		{
+			printf("FAIL: the vector of IRQ %d runs %s handler\n", entry->irq, direct ? "another" : "the table");
+			errors++;
+		}
+	}
+	return errors;
+}
+
+static void Dump(void)
+{
+	printf("AIRCR 0x%08X: PRIGROUP %u, %u preemption levels, %u sub-priorities\n\n", SCB->AIRCR,
+		(SCB->AIRCR >> 8) & 0x07, INTERRUPTS_PREEMPT_LEVELS, INTERRUPTS_SUB_LEVELS);
+	printf("%4s  %-17s %7s %3s %5s %7s %7s  %s\n", "IRQ", "Handler", "preempt", "sub", "field", "enabled", "vector",
+		"Preempted by");
+
+	for (uint8_t i = 0; i < Interrupts_Get_Count(); i++)
+	{
+		const Interrupts_Entry *entry = Interrupts_Get(i);
+		uint8_t field = (entry->irq < 0) ? SCB->SHPR[SYSTICK_SHPR_INDEX] : NVIC->IPR[entry->irq];
+		const char *enabled = (entry->irq < 0) ? "-" :
+			((NVIC->ISER[entry->irq >> 5] >> (entry->irq & 0x1F)) & 1) ? "yes" : "no";
+
+		const char *vector = !INTERRUPTS_RAM_VECTORS ? "flash" :
+			(Interrupts_Get_Handler(entry->irq) == entry->handler) ? "table" : "direct";
+
+		printf("%4d  %-17s %7u %3u  0x%02X %7s %7s  ", entry->irq, entry->name, entry->preempt, entry->sub, field,
+			enabled, vector);
+
+		uint8_t preempted = 0;
+		for (uint8_t j = 0; j < Interrupts_Get_Count(); j++)
+		{
+			if (Interrupts_Get(j)->preempt < entry->preempt)
+			{
+				printf("%s%s", preempted ? ", " : "", Interrupts_Get(j)->name);
+				preempted = 1;
+			}
+		}
+		printf("%s\n", preempted ? "" : "critical sections only");
+	}
+	printf("\n");
+}
+
+int main(void)
+{
+	uint32_t errors = 0;
+
+	// The table first, then the drivers
+	Reset_Registers();
+	Interrupts_Init();
+	Init_Drivers();
+	errors += Check_Registers();
+	errors += Check_Vectors(1);
+	NVIC_Type table_first = Host_NVIC;
+
+	// The drivers first, then the table, which leaves the handlers of the table in the vectors
+	Reset_Registers();
+	Init_Drivers();
+	Interrupts_Init();
+	errors += Check_Registers();
+	errors += Check_Vectors(0);
+
+	if (memcmp(&table_first, &Host_NVIC, sizeof(Host_NVIC)) != 0)
+	{
+		printf("FAIL: the NVIC registers depend on the order of the initialization\n");
+		errors++;
+	}
+
+	// The table first again, as in main, for the dump
+	Reset_Registers();
+	Interrupts_Init();
+	Init_Drivers();
+
+	Dump();
+	printf(errors ? "FAILED\n" : "PASSED\n");
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,282 @@
+/**
+ * @file Pet_Sim_Bench.c
+ *
+ * @brief Host benchmark of the structure-of-arrays pet simulation engine.
+ *
+ * This program first replays random games through Pet_Sim and through a reference made of
+ * a single Hunger_Type model and packed stats, updated the same way the game loop did before
+ * the engine existed, and checks that both give the same status, hunger level and stats. The
+ * reference applies the stats ticks one by one, while Pet_Sim applies all ticks due at once.
+ *
+ * It then runs populations of 1K, 1M and 10M pets (or the sizes given on the command line)
+ * with the three difficulty levels mixed. Every 50 ms of game time, one twentieth of the pets
+ * are fed and Pet_Sim_Step advances all pets. Only Pet_Sim_Step is timed, and the result is
+ * reported in pets updated per second.
+ *
+ * Usage: pet_sim_bench [pets ...]
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// clock_gettime is a POSIX function
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "Pet_Sim.h"
+#include "Pet_Stats.h"
+
+// Game loop period of the firmware and the number of pet updates timed per population
+#define STEP_MS             50
+#define UPDATES_PER_RUN     200000000ULL
+#define MIN_STEPS           20
+
+#define CHECK_GAMES         2000
+#define CHECK_STEPS         4000
+
+// Hunger decay, survival time and stats decay of the three levels (see Levels.c)
+static const uint32_t level_decay_ms[3] = {1000, 500, 250};
+static const uint32_t level_stats_decay[3] =
+{
+	PET_STATS_PACK(0, 4, 3, 2),
+	PET_STATS_PACK(0, 6, 4, 3),
+	PET_STATS_PACK(0, 8, 6, 4)
+};
+#define SURVIVAL_MS         8000
+
+// Reference game state: the hunger model and packed stats of a single pet
+typedef struct
+{
+	Hunger_Type hunger;
+	Pet_Stats stats;
+	uint32_t stats_decay;
+	uint32_t stats_tick_ms;
+	uint32_t survive_ms;
+	uint8_t status;
+} Reference_Pet;
+
+static uint64_t random_state = 0x2545F4914F6CDD1DULL;
+
+static uint32_t Random_Next(void)
+{
+	random_state ^= random_state >> 12;
+	random_state ^= random_state << 25;
+	random_state ^= random_state >> 27;
+	return (uint32_t)((random_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static void Reference_Step(Reference_Pet *pet, uint32_t now_ms)
+{
+	if (pet->status != PET_SIM_PLAYING)
+	{
+		return;
+	}
+
+	while ((now_ms - pet->stats_tick_ms) >= PET_SIM_STATS_TICK_MS)
+	{
+		pet->stats = Pet_Stats_Update(pet->stats, pet->stats_decay, 0,
+			PET_STATS_PACK(0, 0, 16, 0), PET_STATS_PACK(255, 255, 255, 255));
+		pet->stats_tick_ms += PET_SIM_STATS_TICK_MS;
+	}
+
+	// A pet that had survived before its hunger bar emptied wins. The bar cannot empty before
+	// the last feed, since an empty bar cannot be fed.
+	uint8_t survived = (int32_t)(pet->survive_ms - now_ms) <= 0;
+	uint8_t fed_when_survived = survived && ((int32_t)(pet->hunger.last_update_ms - pet->survive_ms) >= 0 ||
+		Hunger_Get(&pet->hunger, pet->survive_ms) != 0);
+
+	if (Hunger_Get(&pet->hunger, now_ms) == 0 && !fed_when_survived)
+	{
+		pet->status = PET_SIM_LOST;
+	}
+	else if (survived)
+	{
+		pet->status = PET_SIM_WON;
+	}
+}
+
+// Plays random games on one engine pet and on the reference and compares them after every step
+static int Check_Semantics(void)
+{
+	Pet_Sim_Type sim;
+	Hunger_Type hunger[1];
+	uint32_t words[PET_SIM_WORDS_PER_PET];
+	uint8_t status[1];
+
+	Pet_Sim_Init(&sim, 1, hunger, words, status);
+
+	for (int game = 0; game < CHECK_GAMES; game++)
+	{
+		uint32_t level = Random_Next() % 3;
+		uint32_t now_ms = Random_Next();
+		Reference_Pet pet;
+
+		Pet_Sim_Start(&sim, 0, level_decay_ms[level], SURVIVAL_MS, level_stats_decay[level], now_ms);
+		Hunger_Init(&pet.hunger, level_decay_ms[level], now_ms);
+		pet.stats = PET_STATS_PACK(255, 192, 192, 192);
+		pet.stats_decay = level_stats_decay[level];
+		pet.stats_tick_ms = now_ms;
+		pet.survive_ms = now_ms + SURVIVAL_MS;
+		pet.status = PET_SIM_PLAYING;
+
+		for (int step = 0; step < CHECK_STEPS && pet.status == PET_SIM_PLAYING; step++)
+		{
+			// Irregular loop times, including long stalls that cover several stats ticks and
+			// resets after minutes off the board
+			uint32_t stall = Random_Next() % 256;
+			now_ms += (stall == 0) ? Random_Next() % 600000 : ((stall < 16) ? Random_Next() % 3000 : Random_Next() % 100);
+
+			uint32_t action = Random_Next() % 32;
+			if (action == 0)
+			{
+				uint32_t amount = (1 + Random_Next() % 4) * HUNGER_ONE_LED;
+				if (Hunger_Get(&pet.hunger, now_ms) != 0)
+				{
+					Hunger_Add(&pet.hunger, amount, now_ms);
+					pet.stats = Pet_Stats_Sub(pet.stats, PET_STATS_PACK(0, 0, 0, 8));
+				}
+				Pet_Sim_Feed(&sim, 0, amount, now_ms);
+			}
+			else if (action == 1)
+			{
+				pet.stats = Pet_Stats_Sub(Pet_Stats_Add(pet.stats, PET_STATS_PACK(0, 64, 0, 0)), PET_STATS_PACK(0, 0, 32, 0));
+				Pet_Sim_Play(&sim, 0);
+			}
+			else if (action == 2)
+			{
+				pet.stats = Pet_Stats_Sub(Pet_Stats_Add(pet.stats, PET_STATS_PACK(0, 0, 0, 128)), PET_STATS_PACK(0, 16, 0, 0));
+				Pet_Sim_Wash(&sim, 0);
+			}
+
+			Reference_Step(&pet, now_ms);
+			Pet_Sim_Step(&sim, now_ms);
+
+			uint32_t reference_stats = Pet_Stats_Set(pet.stats, PET_STAT_HUNGER,
+				(uint8_t)((Hunger_Get(&pet.hunger, now_ms) * PET_STAT_MAX) >> 18));
+
+			if (Pet_Sim_Get_Status(&sim, 0) != pet.status ||
+				Pet_Sim_Get_Hunger(&sim, 0, now_ms) != Hunger_Get(&pet.hunger, now_ms) ||
+				Pet_Sim_Get_Stats(&sim, 0, now_ms) != reference_stats)
+			{
+				printf("Mismatch in game %d at step %d\n", game, step);
+				return 0;
+			}
+		}
+	}
+
+	printf("Pet_Sim matches the single-pet reference in %d random games\n", CHECK_GAMES);
+	return 1;
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static int Run_Population(uint32_t count)
+{
+	Hunger_Type *hunger = malloc((size_t)count * sizeof(Hunger_Type));
+	uint32_t *words = malloc((size_t)count * PET_SIM_WORDS_PER_PET * sizeof(uint32_t));
+	uint8_t *status = malloc(count);
+	Pet_Sim_Type sim;
+
+	if (hunger == NULL || words == NULL || status == NULL)
+	{
+		fprintf(stderr, "Out of memory for %u pets\n", count);
+		free(hunger);
+		free(words);
+		free(status);
+		return 0;
+	}
+
+	Pet_Sim_Init(&sim, count, hunger, words, status);
+
+	// Long games keep the whole population playing during the benchmark
+	uint32_t now_ms = 0;
+	for (uint32_t pet = 0; pet < count; pet++)
+	{
+		uint32_t level = pet % 3;
+		Pet_Sim_Start(&sim, pet, level_decay_ms[level], 0x40000000, level_stats_decay[level], now_ms);
+	}
+
+	uint64_t steps = UPDATES_PER_RUN / count;
+	if (steps < MIN_STEPS)
+	{
+		steps = MIN_STEPS;
+	}
+
+	double step_seconds = 0;
+	uint32_t playing = count;
+	uint32_t feed_slice = (count + 19) / 20;
+	uint32_t feed_start = 0;
+
+	for (uint64_t step = 0; step < steps; step++)
+	{
+		now_ms += STEP_MS;
+
+		// Each pet is fed about once per second (every 20 steps)
+		for (uint32_t i = 0; i < feed_slice; i++)
+		{
+			uint32_t pet = feed_start + i;
+			if (pet >= count)
+			{
+				pet = pet - count;
+			}
+			Pet_Sim_Feed(&sim, pet, HUNGER_FULL, now_ms);
+		}
+		feed_start = (feed_start + feed_slice) % count;
+
+		double start = Seconds_Now();
+		playing = Pet_Sim_Step(&sim, now_ms);
+		step_seconds += Seconds_Now() - start;
+	}
+
+	double updates = (double)count * (double)steps;
+	printf("%10u pets  %8llu steps  %8.3f s  %8.1f M pets/s  %5.2f ns/pet  %u playing\n",
+		count, (unsigned long long)steps, step_seconds, updates / step_seconds / 1e6,
+		step_seconds * 1e9 / updates, playing);
+
+	free(hunger);
+	free(words);
+	free(status);
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	static const uint32_t default_counts[3] = {1000, 1000000, 10000000};
+
+	if (!Check_Semantics())
+	{
+		return 1;
+	}
+
+	if (argc > 1)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			uint32_t count = (uint32_t)strtoul(argv[i], NULL, 0);
+			if (count == 0 || !Run_Population(count))
+			{
+				return 1;
+			}
+		}
+	}
+	else
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			if (!Run_Population(default_counts[i]))
+			{
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
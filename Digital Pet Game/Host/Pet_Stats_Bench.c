@@ -0,0 +1,206 @@
+/**
+ * @file Pet_Stats_Bench.c
+ *
+ * @brief Host benchmark of the packed pet stats against a scalar struct.
+ *
+ * This program first checks that Pet_Stats_Update gives the same result as a scalar
+ * reference (one uint8_t field per stat with explicit saturation and clamping) for random
+ * stats, amounts and limits. It then measures the time per update of both versions over
+ * an array of pets.
+ *
+ * On the host, Pet_Stats.c is built with its portable implementation, so the timings compare
+ * SIMD-within-a-register arithmetic with the scalar struct. The Cortex-M4 version replaces each
+ * packed operation with a single UQSUB8, UQADD8 or USUB8/SEL instruction. With the host options
+ * (-O3 -flto), the compiler vectorizes the scalar loop over the array with the SIMD instructions of
+ * the host, so the scalar struct is several times faster here (about 1.5 ns against 13 to 16 ns per
+ * update). The portable implementation is only a correctness reference, and the host timings say
+ * nothing about the Cortex-M4 version, which has not been timed.
+ *
+ * Usage: pet_stats_bench [pets] [rounds]
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// clock_gettime is a POSIX function
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "Pet_Stats.h"
+
+#define CHECK_COUNT 10000000UL
+
+typedef struct
+{
+	uint8_t hunger;
+	uint8_t happiness;
+	uint8_t energy;
+	uint8_t hygiene;
+} Pet_Stats_Scalar;
+
+static uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t Random_Next(void)
+{
+	random_state ^= random_state >> 12;
+	random_state ^= random_state << 25;
+	random_state ^= random_state >> 27;
+	return (uint32_t)((random_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static uint8_t Scalar_Update_Stat(uint8_t value, uint8_t decay, uint8_t gain, uint8_t floor, uint8_t ceiling)
+{
+	int result = value - decay;
+
+	if (result < 0)
+	{
+		result = 0;
+	}
+	result = result + gain;
+	if (result > 255)
+	{
+		result = 255;
+	}
+	if (result < floor)
+	{
+		result = floor;
+	}
+	if (result > ceiling)
+	{
+		result = ceiling;
+	}
+	return (uint8_t)result;
+}
+
+static void Scalar_Update(Pet_Stats_Scalar *stats, const Pet_Stats_Scalar *decay, const Pet_Stats_Scalar *gain,
+	const Pet_Stats_Scalar *floor, const Pet_Stats_Scalar *ceiling)
+{
+	stats->hunger = Scalar_Update_Stat(stats->hunger, decay->hunger, gain->hunger, floor->hunger, ceiling->hunger);
+	stats->happiness = Scalar_Update_Stat(stats->happiness, decay->happiness, gain->happiness, floor->happiness, ceiling->happiness);
+	stats->energy = Scalar_Update_Stat(stats->energy, decay->energy, gain->energy, floor->energy, ceiling->energy);
+	stats->hygiene = Scalar_Update_Stat(stats->hygiene, decay->hygiene, gain->hygiene, floor->hygiene, ceiling->hygiene);
+}
+
+static Pet_Stats_Scalar Unpack(Pet_Stats stats)
+{
+	Pet_Stats_Scalar scalar;
+
+	scalar.hunger = Pet_Stats_Get(stats, PET_STAT_HUNGER);
+	scalar.happiness = Pet_Stats_Get(stats, PET_STAT_HAPPINESS);
+	scalar.energy = Pet_Stats_Get(stats, PET_STAT_ENERGY);
+	scalar.hygiene = Pet_Stats_Get(stats, PET_STAT_HYGIENE);
+	return scalar;
+}
+
+static Pet_Stats Pack(const Pet_Stats_Scalar *scalar)
+{
+	return PET_STATS_PACK(scalar->hunger, scalar->happiness, scalar->energy, scalar->hygiene);
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long pets = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000UL;
+	unsigned long rounds = (argc > 2) ? strtoul(argv[2], NULL, 0) : 100UL;
+
+	if (pets == 0 || rounds == 0)
+	{
+		fprintf(stderr, "Usage: %s [pets] [rounds]\n", argv[0]);
+		return 1;
+	}
+
+	// Both versions must agree on every lane, including saturation and clamping
+	for (unsigned long i = 0; i < CHECK_COUNT; i++)
+	{
+		Pet_Stats stats = Random_Next();
+		Pet_Stats decay = Random_Next();
+		Pet_Stats gain = Random_Next();
+		Pet_Stats floor = Random_Next() & 0x7F7F7F7F;
+		Pet_Stats ceiling = Random_Next() | 0x80808080;
+
+		Pet_Stats_Scalar scalar = Unpack(stats);
+		Pet_Stats_Scalar scalar_decay = Unpack(decay);
+		Pet_Stats_Scalar scalar_gain = Unpack(gain);
+		Pet_Stats_Scalar scalar_floor = Unpack(floor);
+		Pet_Stats_Scalar scalar_ceiling = Unpack(ceiling);
+
+		Scalar_Update(&scalar, &scalar_decay, &scalar_gain, &scalar_floor, &scalar_ceiling);
+		if (Pack(&scalar) != Pet_Stats_Update(stats, decay, gain, floor, ceiling))
+		{
+			printf("Mismatch for stats 0x%08X, decay 0x%08X, gain 0x%08X\n", stats, decay, gain);
+			return 1;
+		}
+	}
+	printf("Packed and scalar updates agree on %lu random inputs\n", CHECK_COUNT);
+
+	Pet_Stats *packed = malloc(pets * sizeof(Pet_Stats));
+	Pet_Stats_Scalar *scalar = malloc(pets * sizeof(Pet_Stats_Scalar));
+	if (packed == NULL || scalar == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	for (unsigned long i = 0; i < pets; i++)
+	{
+		packed[i] = Random_Next();
+		scalar[i] = Unpack(packed[i]);
+	}
+
+	// The decay, gain and limits used by the game for one stats tick
+	const Pet_Stats decay = PET_STATS_PACK(0, 6, 4, 3);
+	const Pet_Stats gain = PET_STATS_PACK(0, 1, 2, 0);
+	const Pet_Stats floor = PET_STATS_PACK(0, 0, 16, 0);
+	const Pet_Stats ceiling = PET_STATS_PACK(255, 255, 255, 255);
+	const Pet_Stats_Scalar scalar_decay = Unpack(decay);
+	const Pet_Stats_Scalar scalar_gain = Unpack(gain);
+	const Pet_Stats_Scalar scalar_floor = Unpack(floor);
+	const Pet_Stats_Scalar scalar_ceiling = Unpack(ceiling);
+
+	double start = Seconds_Now();
+	for (unsigned long round = 0; round < rounds; round++)
+	{
+		for (unsigned long i = 0; i < pets; i++)
+		{
+			packed[i] = Pet_Stats_Update(packed[i], decay, gain, floor, ceiling);
+		}
+	}
+	double packed_seconds = Seconds_Now() - start;
+
+	start = Seconds_Now();
+	for (unsigned long round = 0; round < rounds; round++)
+	{
+		for (unsigned long i = 0; i < pets; i++)
+		{
+			Scalar_Update(&scalar[i], &scalar_decay, &scalar_gain, &scalar_floor, &scalar_ceiling);
+		}
+	}
+	double scalar_seconds = Seconds_Now() - start;
+
+	// The final states must also agree, which keeps the compiler from dropping either loop
+	for (unsigned long i = 0; i < pets; i++)
+	{
+		if (Pack(&scalar[i]) != packed[i])
+		{
+			printf("Final state mismatch at pet %lu\n", i);
+			return 1;
+		}
+	}
+
+	double updates = (double)pets * (double)rounds;
+	printf("%lu pets x %lu rounds\n", pets, rounds);
+	printf("packed (portable): %6.2f ns per update\n", packed_seconds * 1e9 / updates);
+	printf("scalar struct:     %6.2f ns per update\n", scalar_seconds * 1e9 / updates);
+
+	free(packed);
+	free(scalar);
+	return 0;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file Power_Profile.c
+ *
+ * @brief Host check of the clock profile switches and report of the time spent in each profile.
+ *
+ * This program plays the main loop of the firmware on the host registers: each period does a random
+ * amount of work in the burst profile, then waits in Power_Wait_Ms, in the idle profile or, for a
+ * share of the periods standing in for the menu, in the burst profile. Wide Timer 0 counts the cycles
+ * of the simulated system clock at the frequency of SystemCoreClock, and every WFI is woken up by
+ * the next interrupt after a random part of a millisecond.
+ *
+ * The program keeps the true time in units of the PLL output period and checks that:
+ *  - the Timebase returns the true time after every switch, so no time is lost or gained
+ *  - the prescalers of Timers 0A, 0B, 1A and 2A make them count at 1 MHz in both profiles
+ *  - Power_Wait_Ms returns in the burst profile, within 1 ms of the given time
+ *
+ * The report lists the time in each profile and the switches given by the Power module, and the
+ * host time of a switch.
+ *
+ * Usage: power_profile [-n periods] [-s seed]
+ *  -n  Number of main loop periods (default 20000)
+ *  -s  Seed of the random number generator (default 1)
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// clock_gettime is a POSIX function
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Power.h"
+#include "Clock.h"
+#include "Timebase.h"
+
+// Main loop wait of the firmware
+#define LOOP_WAIT_MS 50
+
+// Share of the periods spent in the menu, which waits in the burst profile
+#define MENU_ONE_IN 8
+
+// Longest work of a period in microseconds, and the chance of an LCD burst of up to 20 ms
+#define WORK_MAX_US 3000
+#define LCD_BURST_ONE_IN 16
+#define LCD_BURST_MAX_US 20000
+
+static uint32_t random_state = 1;
+
+// True time in units of the PLL output period
+static uint64_t true_units = 0;
+
+static uint32_t timebase_errors = 0;
+static uint32_t prescale_errors = 0;
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// Runs the simulated system clock for the given number of cycles at the current frequency
+static void Run_Cycles(uint64_t cycles)
+{
+	uint64_t count = ((uint64_t)WTIMER0->TBV << 32) | WTIMER0->TAV;
+
+	count += cycles;
+	WTIMER0->TAV = (uint32_t)count;
+	WTIMER0->TBV = (uint32_t)(count >> 32);
+	true_units += cycles * (TIMEBASE_UNIT_HZ / SystemCoreClock);
+}
+
+static void Run_Us(uint32_t us)
+{
+	Run_Cycles((uint64_t)us * (SystemCoreClock / 1000000));
+}
+
+static void Check_Drivers(void)
+{
+	uint32_t prescale = SystemCoreClock / 1000000 - 1;
+
+	if (Timebase_Get_Us() != (uint32_t)(true_units / (TIMEBASE_UNIT_HZ / 1000000)))
+	{
+		timebase_errors++;
+	}
+	if (TIMER0->TAPR != prescale || TIMER0->TBPR != prescale || TIMER1->TAPR != prescale ||
+		TIMER2->TAPR != prescale)
+	{
+		prescale_errors++;
+	}
+}
+
+// The next interrupt wakes the CPU up after a random part of a millisecond, and a few odd cycles
+// keep the count off whole microseconds
+static void Wake_Up(void)
+{
+	Run_Cycles(1 + Random() % (SystemCoreClock / 1000));
+	Check_Drivers();
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t periods = 20000;
+	uint32_t wait_errors = 0;
+	uint32_t longest_wait_us = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			periods = (uint32_t)strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			random_state = (uint32_t)strtoul(argv[++i], NULL, 0) | 1;
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-n periods] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// The PLL locks at once, and the timers used by the game are enabled
+	SYSCTL->PLLSTAT = 0x01;
+	SYSCTL->RCGCTIMER = 0x07;
+	Clock_Init();
+	Timebase_Init();
+	TIMER0->TAPR = CLOCK_TIMER_PRESCALE(1000000);
+	TIMER0->TBPR = CLOCK_TIMER_PRESCALE(1000000);
+	TIMER1->TAPR = CLOCK_TIMER_PRESCALE(1000000);
+	TIMER2->TAPR = CLOCK_TIMER_PRESCALE(1000000);
+	Power_Init();
+	Host_WFI_Hook = &Wake_Up;
+
+	for (uint32_t period = 0; period < periods; period++)
+	{
+		uint32_t work_us = Random() % WORK_MAX_US;
+		if (Random() % LCD_BURST_ONE_IN == 0)
+		{
+			work_us += Random() % LCD_BURST_MAX_US;
+		}
+		Run_Us(work_us);
+		Run_Cycles(Random() % 80);
+		Check_Drivers();
+
+		uint8_t profile = (Random() % MENU_ONE_IN == 0) ? POWER_PROFILE_BURST : POWER_PROFILE_IDLE;
+		uint64_t wait_start = true_units;
+		Power_Wait_Ms(LOOP_WAIT_MS, profile);
+		Check_Drivers();
+
+		uint32_t wait_us = (uint32_t)((true_units - wait_start) / (TIMEBASE_UNIT_HZ / 1000000));
+		longest_wait_us = (wait_us > longest_wait_us) ? wait_us : longest_wait_us;
+		if (wait_us < (LOOP_WAIT_MS - 1) * 1000 || wait_us > (LOOP_WAIT_MS + 1) * 1000 ||
+			Power_Get_Profile() != POWER_PROFILE_BURST)
+		{
+			wait_errors++;
+		}
+	}
+
+	uint32_t burst_ms = Power_Get_Time_Ms(POWER_PROFILE_BURST);
+	uint32_t idle_ms = Power_Get_Time_Ms(POWER_PROFILE_IDLE);
+	uint32_t switches = Power_Get_Switch_Count();
+
+	// Host time of a switch to the idle profile and back
+	Host_WFI_Hook = 0;
+	const int round_trips = 1000000;
+	double start = Seconds_Now();
+	for (int i = 0; i < round_trips; i++)
+	{
+		Power_Set_Profile(POWER_PROFILE_IDLE);
+		Power_Set_Profile(POWER_PROFILE_BURST);
+	}
+	double switch_ns = (Seconds_Now() - start) * 1e9 / (2.0 * round_trips);
+
+	printf("Main loop periods:     %u (%.1f minutes)\n", periods,
+		(double)true_units / TIMEBASE_UNIT_HZ / 60.0);
+	printf("Burst profile:         %u ms (%.1f %%)\n", burst_ms, 100.0 * burst_ms / (burst_ms + idle_ms));
+	printf("Idle profile:          %u ms (%.1f %%)\n", idle_ms, 100.0 * idle_ms / (burst_ms + idle_ms));
+	printf("Profile switches:      %u, %.0f ns each on the host\n", switches, switch_ns);
+	printf("Longest wait:          %u us for %u ms\n", longest_wait_us, LOOP_WAIT_MS);
+	printf("Timebase errors:       %u\n", timebase_errors);
+	printf("Prescaler errors:      %u\n", prescale_errors);
+	printf("Wait errors:           %u\n", wait_errors);
+
+	uint32_t failures = timebase_errors + prescale_errors + wait_errors;
+	printf(failures ? "FAILED\n" : "PASSED\n");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file RTC_Catch_Up.c
+ *
+ * @brief Host check of the pet clock and of the catch-up of a saved game after time off the board.
+ *
+ * This program runs the RTC driver and the pet clock (Pet_Clock.h) on the host RTC model
+ * (Host_RTC.c) and checks that:
+ *  - the RTC is started when VBAT was removed, and keeps its count through a reset otherwise
+ *  - the pet clock never goes backwards, and moves by PET_CLOCK_DAY_MS in every real day
+ *  - a saved game that catches up on the time off in one Pet_Sim_Step, as main.c does at reset,
+ *    ends in the same state as the same game advanced every minute of the time off
+ *
+ * The games have random hunger decay, survival time and stats decay, so that many of them are
+ * still playing after days off. The time off is log-uniform from 1 second to 14 days.
+ *
+ * The report lists the pet hours in a real day, the outcome of the games after the time off, and
+ * the host time of a catch-up compared with advancing the game every minute.
+ *
+ * Usage: rtc_catch_up [-n games] [-s seed]
+ *  -n  Number of games (default 2000)
+ *  -s  Seed of the random number generator (default 1)
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// clock_gettime is a POSIX function
+#define _POSIX_C_SOURCE 200112L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Pet_Clock.h"
+#include "Pet_Sim.h"
+#include "Pet_Stats.h"
+#include "RTC.h"
+
+#define DAY_S           86400
+#define MAX_OFF_S       (14 * DAY_S)
+#define REPLAY_STEP_S   60
+
+static uint32_t random_state = 1;
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// Returns the RTC count in seconds
+static uint32_t RTC_Seconds(void)
+{
+	uint32_t seconds;
+	uint32_t subseconds;
+
+	RTC_Read(&seconds, &subseconds);
+	return seconds;
+}
+
+static int Check_Boot(void)
+{
+	Host_RTC_Remove_Battery();
+	if (Pet_Clock_Init() != 0)
+	{
+		printf("FAIL: the RTC reported a kept count after VBAT was removed\n");
+		return 0;
+	}
+
+	uint32_t started = RTC_Seconds();
+	Host_RTC_Advance(3600 * 1000);
+	if (Pet_Clock_Init() != 1 || RTC_Seconds() != started + 3600)
+	{
+		printf("FAIL: the RTC count was not kept through a reset\n");
+		return 0;
+	}
+	return 1;
+}
+
+// Checks every second of two days from the current count, then random whole days
+static int Check_Pet_Day(void)
+{
+	uint32_t start = RTC_Seconds();
+	uint32_t last_ms = Pet_Clock_From_RTC(start, 0);
+
+	for (uint32_t second = 1; second <= 2 * DAY_S; second++)
+	{
+		uint32_t now_ms = Pet_Clock_From_RTC(start + second, 0);
+		if ((int32_t)(now_ms - last_ms) <= 0)
+		{
+			printf("FAIL: the pet clock did not move forward at RTC second %u\n", start + second);
+			return 0;
+		}
+		last_ms = now_ms;
+	}
+
+	for (int i = 0; i < 100000; i++)
+	{
+		uint32_t seconds = Random() % 0xF0000000;
+		uint32_t subseconds = Random() % RTC_SUBSECONDS_PER_SECOND;
+		if (Pet_Clock_From_RTC(seconds + DAY_S, subseconds) - Pet_Clock_From_RTC(seconds, subseconds) != PET_CLOCK_DAY_MS)
+		{
+			printf("FAIL: a real day from RTC second %u is not PET_CLOCK_DAY_MS\n", seconds);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static void Start_Random_Game(Pet_Sim_Type *sim, uint32_t now_ms)
+{
+	uint32_t decay_ms = 1000 + Random() % (4 * 3600 * 1000);
+	uint32_t survival_ms = 60000 + Random() % (3 * DAY_S * 1000);
+	uint32_t stats_decay = PET_STATS_PACK(0, Random() % 4, Random() % 4, Random() % 4);
+
+	Pet_Sim_Start(sim, 0, decay_ms, survival_ms, stats_decay, now_ms);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t games = 2000;
+	uint32_t failures = 0;
+	uint32_t outcome[PET_SIM_PAUSED + 1] = {0};
+	double catch_up_seconds = 0;
+	double replay_seconds = 0;
+	double replay_steps = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			games = (uint32_t)strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			random_state = (uint32_t)strtoul(argv[++i], NULL, 0) | 1;
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-n games] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (!Check_Boot() || !Check_Pet_Day())
+	{
+		printf("FAILED\n");
+		return 1;
+	}
+
+	Pet_Sim_Type board;
+	Pet_Sim_Type replay;
+	Hunger_Type board_hunger[1];
+	Hunger_Type replay_hunger[1];
+	uint32_t board_words[PET_SIM_WORDS_PER_PET];
+	uint32_t replay_words[PET_SIM_WORDS_PER_PET];
+	uint8_t board_status[1];
+	uint8_t replay_status[1];
+
+	Pet_Sim_Init(&board, 1, board_hunger, board_words, board_status);
+	Pet_Sim_Init(&replay, 1, replay_hunger, replay_words, replay_status);
+
+	for (uint32_t game = 0; game < games; game++)
+	{
+		Pet_Sim_Snapshot snapshot;
+
+		// Play for up to a day with a feed every few minutes, then take the checkpoint
+		Start_Random_Game(&board, Pet_Clock_Get_Ms());
+		for (uint32_t minutes = Random() % (24 * 60); minutes > 0; minutes--)
+		{
+			Host_RTC_Advance(60 * 1000);
+			Pet_Sim_Step(&board, Pet_Clock_Get_Ms());
+			if (Random() % 8 == 0)
+			{
+				Pet_Sim_Feed(&board, 0, (1 + Random() % 4) * HUNGER_ONE_LED, Pet_Clock_Get_Ms());
+			}
+		}
+		if (Pet_Sim_Get_Status(&board, 0) != PET_SIM_PLAYING)
+		{
+			continue;
+		}
+		uint32_t saved_ms = Pet_Clock_Get_Ms();
+		uint32_t saved_seconds = RTC_Seconds();
+		Pet_Sim_Save(&board, 0, saved_ms, &snapshot);
+
+		// Board off for a log-uniform time, then reset: load at the checkpoint and catch up
+		uint32_t off_s = (uint32_t)exp(log((double)MAX_OFF_S) * (double)(Random() % 1000000) / 1e6);
+		Host_RTC_Advance((uint64_t)off_s * 1000);
+		if (Pet_Clock_Init() != 1)
+		{
+			printf("FAIL: game %u: the RTC was restarted by a reset\n", game);
+			failures++;
+			break;
+		}
+
+		double start = Seconds_Now();
+		uint32_t now_ms = Pet_Clock_Get_Ms();
+		Pet_Sim_Load(&board, 0, &snapshot, saved_ms);
+		Pet_Sim_Step(&board, now_ms);
+		catch_up_seconds += Seconds_Now() - start;
+
+		// The same game advanced every minute of the time off
+		start = Seconds_Now();
+		Pet_Sim_Load(&replay, 0, &snapshot, saved_ms);
+		uint32_t second = 0;
+		do
+		{
+			second = (second + REPLAY_STEP_S < off_s) ? second + REPLAY_STEP_S : off_s;
+			Pet_Sim_Step(&replay, Pet_Clock_From_RTC(saved_seconds + second, 0));
+			replay_steps++;
+		} while (second < off_s && Pet_Sim_Get_Status(&replay, 0) == PET_SIM_PLAYING);
+		replay_seconds += Seconds_Now() - start;
+
+		// Both are compared at the pet clock now, which the replay reaches at the last whole second
+		uint32_t status = Pet_Sim_Get_Status(&board, 0);
+		outcome[status]++;
+		if (status != Pet_Sim_Get_Status(&replay, 0) ||
+			Pet_Sim_Get_Hunger(&board, 0, now_ms) != Pet_Sim_Get_Hunger(&replay, 0, now_ms) ||
+			(status == PET_SIM_PLAYING && Pet_Sim_Get_Stats(&board, 0, now_ms) != Pet_Sim_Get_Stats(&replay, 0, now_ms)))
+		{
+			printf("FAIL: game %u: the catch-up after %u s off does not match the replay\n", game, off_s);
+			failures++;
+		}
+	}
+
+	uint32_t checked = outcome[PET_SIM_PLAYING] + outcome[PET_SIM_WON] + outcome[PET_SIM_LOST];
+	printf("Pet clock:            %.2f pet hours per real day, asleep from %02u:00 to %02u:00\n",
+		PET_CLOCK_DAY_MS / 3.6e6, PET_CLOCK_NIGHT_START_S / 3600, PET_CLOCK_NIGHT_END_S / 3600);
+	printf("Games caught up:      %u (%u still playing, %u won, %u lost while off)\n", checked,
+		outcome[PET_SIM_PLAYING], outcome[PET_SIM_WON], outcome[PET_SIM_LOST]);
+	printf("Catch-up:             %.0f ns on the host, in one Pet_Sim_Step\n",
+		checked ? catch_up_seconds * 1e9 / checked : 0.0);
+	printf("Replay every minute:  %.0f ns on the host, %.0f steps per game\n",
+		checked ? replay_seconds * 1e9 / checked : 0.0, checked ? replay_steps / checked : 0.0);
+
+	printf(failures ? "FAILED\n" : "PASSED\n");
+	return failures ? 1 : 0;
+}
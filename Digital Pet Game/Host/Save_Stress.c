@@ -0,0 +1,239 @@
+/**
+ * @file Save_Stress.c
+ *
+ * @brief Host stress test of the saved game records on the EEPROM model.
+ *
+ * This program runs the Save module against the host EEPROM model (Host_EEPROM.c), with the main
+ * loop period of the firmware and a random write time for every word, and checks that:
+ *  - Save_Task never writes a word while the EEPROM is still busy
+ *  - after a power cut at a random word, Save_Restore returns the newest whole record
+ *    (a record cut short is never restored)
+ *  - a damaged newest record is skipped and the record before it is restored
+ *
+ * Every checkpoint is a structure of the size of the firmware saved game, whose words are all
+ * derived from a checkpoint number, so a mixed or torn record is detected. A new checkpoint is
+ * taken as soon as the previous one has been written, so record n holds checkpoint n.
+ *
+ * The report lists the power cuts and what was restored, the EEPROM accesses and host time
+ * taken by Save_Restore, and the writes of the most written word compared to the checkpoints.
+ *
+ * Usage: save_stress [-n power_cuts] [-s seed]
+ *  -n  Number of power cuts (default 10000)
+ *  -s  Seed of the random number generator (default 1)
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// clock_gettime is a POSIX function
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Save.h"
+
+#define PAYLOAD_WORDS 7
+#define PAYLOAD_VERSION 1
+
+// Main loop period of the firmware
+#define LOOP_MS 50
+
+// Range of the number of EEPROM accesses for which a word write keeps the EEPROM busy
+#define BUSY_ACCESSES_MAX 8
+
+typedef struct
+{
+	uint32_t words[PAYLOAD_WORDS];
+} Payload_Type;
+
+static uint32_t random_state = 1;
+static uint32_t now_ms = 0;
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static void Make_Payload(Payload_Type *payload, uint32_t number)
+{
+	payload->words[0] = number;
+	for (int i = 1; i < PAYLOAD_WORDS; i++)
+	{
+		payload->words[i] = (number * 2654435761u) ^ (uint32_t)i;
+	}
+}
+
+// Returns the checkpoint number of a payload, or -1 if its words do not belong together
+static int64_t Check_Payload(const Payload_Type *payload)
+{
+	Payload_Type expected;
+
+	Make_Payload(&expected, payload->words[0]);
+	return memcmp(&expected, payload, sizeof(expected)) == 0 ? (int64_t)payload->words[0] : -1;
+}
+
+// Resets the board: the Save module starts again and restores the newest record
+static uint8_t Boot(Payload_Type *restored)
+{
+	Host_EEPROM_Writes_Left = 0xFFFFFFFF;
+	if (!Save_Init(PAYLOAD_VERSION, sizeof(Payload_Type)))
+	{
+		fprintf(stderr, "Save_Init failed\n");
+		exit(1);
+	}
+	return Save_Restore(restored);
+}
+
+// Runs the main loop until the given number of records are written or the power is cut.
+// Returns the number of records written.
+static uint32_t Play(uint32_t first, uint32_t records)
+{
+	Payload_Type payload;
+	uint32_t written = 0;
+
+	Make_Payload(&payload, first);
+	Save_Checkpoint(&payload);
+
+	while (written < records && Host_EEPROM_Writes_Left != 0)
+	{
+		Host_EEPROM_Busy_Accesses = 1 + Random() % BUSY_ACCESSES_MAX;
+		Save_Task(now_ms);
+		now_ms += LOOP_MS;
+
+		if (Save_Get_Record_Count() > written)
+		{
+			written = Save_Get_Record_Count();
+			Make_Payload(&payload, first + written);
+			Save_Checkpoint(&payload);
+		}
+	}
+	return written;
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t cuts = 10000;
+	Payload_Type restored;
+	uint32_t newest = 0;
+	uint32_t total_records = 0;
+	uint32_t restored_newest = 0;
+	uint32_t restored_previous = 0;
+	uint32_t failures = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			cuts = (uint32_t)strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			random_state = (uint32_t)strtoul(argv[++i], NULL, 0) | 1;
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-n power_cuts] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// An erased EEPROM reads all ones and holds no record
+	memset(Host_EEPROM_Storage, 0xFF, sizeof(Host_EEPROM_Storage));
+	if (Boot(&restored))
+	{
+		printf("FAIL: a record was restored from an erased EEPROM\n");
+		failures++;
+	}
+	total_records += Play(1, 1);
+	newest = 1;
+
+	// Power cuts: play for a random number of words, cut the power, reset, and check the restored record
+	for (uint32_t cut = 0; cut < cuts; cut++)
+	{
+		Host_EEPROM_Writes_Left = Random() % (4 * EEPROM_BLOCK_WORDS);
+		uint32_t written = Play(newest + 1, 0xFFFFFFFF);
+		total_records += written;
+		newest += written;
+
+		int64_t number = Boot(&restored) ? Check_Payload(&restored) : -1;
+
+		if (number == newest)
+		{
+			restored_newest++;
+		}
+		else
+		{
+			printf("FAIL: power cut %u restored %lld, newest record is %u\n", cut, (long long)number, newest);
+			failures++;
+		}
+	}
+
+	// Damaged newest record: flip a bit of its payload and expect the record before it
+	total_records += Play(newest + 1, 2);
+	newest += 2;
+	uint32_t newest_word_count = 0;
+	uint32_t newest_address = 0;
+	for (uint32_t block = 0; block < SAVE_BLOCK_COUNT; block++)
+	{
+		uint32_t address = (SAVE_FIRST_BLOCK + block) * EEPROM_BLOCK_WORDS;
+		if (Host_EEPROM_Storage[address + 2] == newest)
+		{
+			newest_address = address;
+			newest_word_count++;
+		}
+	}
+	Host_EEPROM_Storage[newest_address + 3] ^= 0x00010000;
+	if (newest_word_count == 1 && Boot(&restored) && Check_Payload(&restored) == newest - 1)
+	{
+		restored_previous++;
+	}
+	else
+	{
+		printf("FAIL: the record before a damaged record was not restored\n");
+		failures++;
+	}
+
+	// Restore cost with every block holding a record
+	uint32_t accesses = Host_EEPROM_Accesses;
+	double start = Seconds_Now();
+	const int restores = 100000;
+	for (int i = 0; i < restores; i++)
+	{
+		Save_Restore(&restored);
+	}
+	double restore_ns = (Seconds_Now() - start) * 1e9 / restores;
+	accesses = (Host_EEPROM_Accesses - accesses) / restores;
+
+	uint32_t most_writes = 0;
+	for (uint32_t i = 0; i < HOST_EEPROM_WORDS; i++)
+	{
+		most_writes = (Host_EEPROM_Write_Count[i] > most_writes) ? Host_EEPROM_Write_Count[i] : most_writes;
+	}
+
+	printf("Power cuts:               %u\n", cuts);
+	printf("Records written:          %u\n", total_records);
+	printf("Newest record restored:   %u\n", restored_newest);
+	printf("Damaged record skipped:   %u\n", restored_previous);
+	printf("Busy EEPROM writes:       %u\n", Host_EEPROM_Busy_Errors);
+	printf("Restore:                  %u EEPROM accesses, %.0f ns on the host\n", accesses, restore_ns);
+	printf("Most written word:        %u writes (%.1f records per write)\n", most_writes,
+		(double)total_records / most_writes);
+
+	failures += Host_EEPROM_Busy_Errors;
+	printf(failures ? "FAILED\n" : "PASSED\n");
+	return failures ? 1 : 0;
+}
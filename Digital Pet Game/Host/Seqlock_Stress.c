@@ -0,0 +1,184 @@
+/**
+ * @file Seqlock_Stress.c
+ *
+ * @brief Host stress test of the sequence lock under a heavy interrupt load.
+ *
+ * This program stands in for the board with a periodic timer signal: the signal handler plays the
+ * interrupt and the main program plays the main loop. As on the Cortex-M4, the handler interrupts
+ * the main program at any instruction and always runs to completion before the main program resumes.
+ *
+ * The handler publishes a structure of SHARED_WORDS words that all hold the same sequence value, and
+ * the main program copies it as fast as it can for the given time, once through Seqlock_Read and once
+ * with a plain copy. A copy is torn if its words differ. The report lists, for each interrupt period,
+ * the number of interrupts, the number of copies, the retries taken by Seqlock_Read, and the torn
+ * copies of both methods. The sequence lock must never return a torn copy.
+ *
+ * Usage: seqlock_stress [-t seconds] [period_us ...]
+ *  -t  Time spent on each interrupt period in seconds (default 1)
+ *  The default periods are 1000, 100, 20 and 5 us.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// setitimer, sigaction and clock_gettime are POSIX functions
+#define _POSIX_C_SOURCE 200112L
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include "Seqlock.h"
+
+#define SHARED_WORDS 8
+
+typedef struct
+{
+	uint32_t words[SHARED_WORDS];
+} Shared_Type;
+
+static Shared_Type shared;
+static Seqlock_Type shared_lock;
+static volatile uint32_t interrupt_count = 0;
+
+// The "interrupt": publishes the next value in every word
+static void Timer_Handler(int signal_number)
+{
+	(void)signal_number;
+	uint32_t value = interrupt_count + 1;
+
+	Seqlock_Write_Begin(&shared_lock);
+	for (int i = 0; i < SHARED_WORDS; i++)
+	{
+		shared.words[i] = value;
+	}
+	Seqlock_Write_End(&shared_lock);
+
+	interrupt_count = value;
+}
+
+static int Is_Torn(const Shared_Type *copy)
+{
+	for (int i = 1; i < SHARED_WORDS; i++)
+	{
+		if (copy->words[i] != copy->words[0])
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static void Set_Timer(long period_us)
+{
+	struct itimerval timer;
+
+	timer.it_interval.tv_sec = period_us / 1000000;
+	timer.it_interval.tv_usec = period_us % 1000000;
+	timer.it_value = timer.it_interval;
+	setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+static int Run_Period(long period_us, double seconds)
+{
+	uint64_t copies = 0;
+	uint64_t torn_locked = 0;
+	uint64_t torn_plain = 0;
+	Shared_Type copy;
+
+	memset(&shared, 0, sizeof(shared));
+	Seqlock_Init(&shared_lock);
+	interrupt_count = 0;
+
+	Set_Timer(period_us);
+	double end = Seconds_Now() + seconds;
+
+	while (Seconds_Now() < end)
+	{
+		// a batch of copies between two reads of the clock
+		for (int i = 0; i < 1000; i++)
+		{
+			Seqlock_Read(&shared_lock, &copy, &shared, sizeof(copy));
+			torn_locked += Is_Torn(&copy);
+
+			// plain copy through volatile, so the compiler reads the words again every time
+			const volatile uint32_t *words = shared.words;
+			for (int j = 0; j < SHARED_WORDS; j++)
+			{
+				copy.words[j] = words[j];
+			}
+			torn_plain += Is_Torn(&copy);
+		}
+		copies += 1000;
+	}
+
+	Set_Timer(0);
+
+	uint32_t retries = Seqlock_Get_Retry_Count(&shared_lock);
+	printf("%9ld %12u %12llu %10u %9.4f %12llu %12llu\n", period_us, interrupt_count,
+		(unsigned long long)copies, retries, 100.0 * (double)retries / (double)copies,
+		(unsigned long long)torn_locked, (unsigned long long)torn_plain);
+
+	return torn_locked == 0 && Seqlock_Get_Read_Count(&shared_lock) == copies;
+}
+
+int main(int argc, char **argv)
+{
+	static const long default_periods[] = {1000, 100, 20, 5};
+	double seconds = 1.0;
+	long periods[64];
+	int period_count = 0;
+	struct sigaction action;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+		{
+			seconds = strtod(argv[++i], NULL);
+		}
+		else if (period_count < 64 && strtol(argv[i], NULL, 0) > 0)
+		{
+			periods[period_count++] = strtol(argv[i], NULL, 0);
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-t seconds] [period_us ...]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (period_count == 0)
+	{
+		for (unsigned i = 0; i < sizeof(default_periods) / sizeof(default_periods[0]); i++)
+		{
+			periods[period_count++] = default_periods[i];
+		}
+	}
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = &Timer_Handler;
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = 0;
+	sigaction(SIGALRM, &action, NULL);
+
+	printf("%9s %12s %12s %10s %9s %12s %12s\n", "period_us", "interrupts", "copies", "retries",
+		"retry %", "torn seqlock", "torn plain");
+
+	int passed = 1;
+	for (int i = 0; i < period_count; i++)
+	{
+		passed &= Run_Period(periods[i], seconds);
+	}
+
+	printf(passed ? "The sequence lock returned no torn copy\n" : "The sequence lock returned torn copies\n");
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file Stats_Log_Bench.c
+ *
+ * @brief Host benchmark and check of the statistics log on the flash memory model.
+ *
+ * This program appends random finished games to the statistics log (Stats_Log) on the host flash
+ * memory model (Host_Flash.c) and keeps its own totals of every level. After every append the
+ * totals of the log must match, and at random points the board is reset: Stats_Log_Init must
+ * rebuild the same totals from the flash memory, including across compactions.
+ *
+ * The report lists the host time and the flash operations of an append, the compactions, and
+ * the host time of a rebuild for a log holding from one game to a full half. On the board, an
+ * append costs 2 word programs, and a rebuild reads every word of the active half at most once.
+ *
+ * Usage: stats_log_bench [-n games] [-s seed]
+ *  -n  Number of games appended (default 100000)
+ *  -s  Seed of the random number generator (default 1)
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+// clock_gettime is a POSIX function
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Stats_Log.h"
+
+#define LEVELS 4
+
+// Average chance of a reset between two games
+#define RESET_ONE_IN 200
+
+static uint32_t random_state = 1;
+static Stats_Log_Level expected[STATS_LOG_LEVELS];
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static double Seconds_Now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static void Random_Game(Stats_Log_Game *game)
+{
+	game->level = (uint8_t)(Random() % LEVELS);
+	game->result = (uint8_t)(Random() % 3);
+	game->feeds = (uint16_t)(Random() % 40);
+	game->reaction_ms = (uint16_t)(200 + Random() % 2000);
+	game->survival_s = (uint16_t)(Random() % 300);
+}
+
+static void Expect_Game(const Stats_Log_Game *game)
+{
+	Stats_Log_Level *level = &expected[game->level];
+
+	level->games++;
+	level->wins += (game->result == STATS_LOG_WON);
+	level->losses += (game->result == STATS_LOG_LOST);
+	level->best_survival_s = (game->survival_s > level->best_survival_s) ? game->survival_s : level->best_survival_s;
+	level->feeds += game->feeds;
+	level->reaction_sum_ms += (uint32_t)game->feeds * game->reaction_ms;
+}
+
+static int Totals_Match(void)
+{
+	for (uint8_t level = 0; level < STATS_LOG_LEVELS; level++)
+	{
+		if (memcmp(Stats_Log_Get_Level(level), &expected[level], sizeof(Stats_Log_Level)) != 0)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// Appends games to an empty log until it holds the given number of entries, then times the rebuild
+static double Rebuild_Ns(uint32_t games)
+{
+	Stats_Log_Game game;
+	const int rebuilds = 2000;
+
+	memset(Host_Flash_Memory, 0xFF, sizeof(Host_Flash_Memory));
+	Stats_Log_Init();
+	for (uint32_t i = 0; i < games; i++)
+	{
+		Random_Game(&game);
+		Stats_Log_Append(&game);
+	}
+
+	double start = Seconds_Now();
+	for (int i = 0; i < rebuilds; i++)
+	{
+		Stats_Log_Init();
+	}
+	return (Seconds_Now() - start) * 1e9 / rebuilds;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t games = 100000;
+	uint32_t resets = 0;
+	uint32_t failures = 0;
+	double append_seconds = 0;
+	Stats_Log_Game game;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			games = (uint32_t)strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			random_state = (uint32_t)strtoul(argv[++i], NULL, 0) | 1;
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [-n games] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	memset(Host_Flash_Memory, 0xFF, sizeof(Host_Flash_Memory));
+	if (!Stats_Log_Init())
+	{
+		printf("FAIL: the log could not be started\n");
+		return 1;
+	}
+	uint32_t programs = Host_Flash_Programs;
+	uint32_t erases = Host_Flash_Erases;
+
+	for (uint32_t i = 0; i < games; i++)
+	{
+		Random_Game(&game);
+		Expect_Game(&game);
+
+		double start = Seconds_Now();
+		uint8_t appended = Stats_Log_Append(&game);
+		append_seconds += Seconds_Now() - start;
+
+		if (!appended || !Totals_Match())
+		{
+			printf("FAIL: game %u: the totals do not match after the append\n", i);
+			failures++;
+			break;
+		}
+
+		if (Random() % RESET_ONE_IN == 0)
+		{
+			resets++;
+			if (!Stats_Log_Init() || !Totals_Match())
+			{
+				printf("FAIL: game %u: the totals do not match after a reset\n", i);
+				failures++;
+				break;
+			}
+		}
+	}
+	programs = Host_Flash_Programs - programs;
+	erases = Host_Flash_Erases - erases;
+
+	uint32_t most_erases = 0;
+	for (uint32_t page = 0; page < HOST_FLASH_PAGES; page++)
+	{
+		most_erases = (Host_Flash_Erase_Count[page] > most_erases) ? Host_Flash_Erase_Count[page] : most_erases;
+	}
+
+	printf("Games appended:        %u with %u resets\n", games, resets);
+	printf("Append:                %.0f ns on the host, %.3f word programs and %.4f page erases per game\n",
+		append_seconds * 1e9 / games, (double)programs / games, (double)erases / games);
+	printf("Compactions:           %u (one every %.1f games), most erased page %u times\n",
+		erases / 4, erases ? games / (erases / 4.0) : 0.0, most_erases);
+	printf("Rebuild at reset:      1 game %.0f ns, 128 games %.0f ns, 255 games %.0f ns on the host\n",
+		Rebuild_Ns(1), Rebuild_Ns(128), Rebuild_Ns(255));
+	printf("Words programmed twice: %u\n", Host_Flash_Reprogram_Errors);
+
+	failures += Host_Flash_Reprogram_Errors;
+	printf(failures ? "FAILED\n" : "PASSED\n");
+	return failures ? 1 : 0;
+}
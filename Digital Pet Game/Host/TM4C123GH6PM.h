@@ -0,0 +1,344 @@
+/**
+ * @file TM4C123GH6PM.h
+ *
+ * @brief Host stand-in for the TM4C123GH6PM device header.
+ *
+ * This file lets the firmware drivers build and run on a PC. Every peripheral used by the
+ * firmware is declared with the same type and register names as the device header, but the
+ * registers are plain variables defined in Host_Registers.c. Host tools set input registers
+ * (for example, GPIOD->DATA or the Wide Timer 0 count) and inspect output registers directly.
+ *
+ * Only the peripherals and registers used by the firmware are declared. The register order
+ * follows the datasheet, but the reserved gaps are not reproduced, except for the GPIO DATA
+ * address mask region, which is needed by the masked DATA writes.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#ifndef TM4C123GH6PM_HOST_H
+#define TM4C123GH6PM_HOST_H
+
+#include <stdint.h>
+
+#define __IO volatile
+#define __I  volatile const
+#define __O  volatile
+
+typedef enum
+{
+	SysTick_IRQn  = -1,
+	GPIOA_IRQn    = 0,
+	GPIOB_IRQn    = 1,
+	GPIOC_IRQn    = 2,
+	GPIOD_IRQn    = 3,
+	GPIOE_IRQn    = 4,
+	SSI0_IRQn     = 7,
+	TIMER0A_IRQn  = 19,
+	TIMER0B_IRQn  = 20,
+	TIMER1A_IRQn  = 21,
+	TIMER1B_IRQn  = 22,
+	TIMER2A_IRQn  = 23,
+	TIMER2B_IRQn  = 24,
+	GPIOF_IRQn    = 30,
+	HIB_IRQn      = 43,
+	SSI2_IRQn     = 57,
+	WTIMER0A_IRQn = 94,
+	WTIMER0B_IRQn = 95,
+	WTIMER1A_IRQn = 96,
+	WTIMER1B_IRQn = 97,
+	WTIMER2A_IRQn = 98,
+	WTIMER2B_IRQn = 99
+} IRQn_Type;
+
+typedef struct
+{
+	__IO uint32_t DATA_Bits[255];
+	__IO uint32_t DATA;
+	__IO uint32_t DIR;
+	__IO uint32_t IS;
+	__IO uint32_t IBE;
+	__IO uint32_t IEV;
+	__IO uint32_t IM;
+	__IO uint32_t RIS;
+	__IO uint32_t MIS;
+	__IO uint32_t ICR;
+	__IO uint32_t AFSEL;
+	__IO uint32_t DR2R;
+	__IO uint32_t DR4R;
+	__IO uint32_t DR8R;
+	__IO uint32_t ODR;
+	__IO uint32_t PUR;
+	__IO uint32_t PDR;
+	__IO uint32_t SLR;
+	__IO uint32_t DEN;
+	__IO uint32_t LOCK;
+	__IO uint32_t CR;
+	__IO uint32_t AMSEL;
+	__IO uint32_t PCTL;
+	__IO uint32_t ADCCTL;
+	__IO uint32_t DMACTL;
+} GPIOA_Type;
+
+typedef struct
+{
+	__IO uint32_t CFG;
+	__IO uint32_t TAMR;
+	__IO uint32_t TBMR;
+	__IO uint32_t CTL;
+	__IO uint32_t SYNC;
+	__IO uint32_t IMR;
+	__IO uint32_t RIS;
+	__IO uint32_t MIS;
+	__IO uint32_t ICR;
+	__IO uint32_t TAILR;
+	__IO uint32_t TBILR;
+	__IO uint32_t TAMATCHR;
+	__IO uint32_t TBMATCHR;
+	__IO uint32_t TAPR;
+	__IO uint32_t TBPR;
+	__IO uint32_t TAPMR;
+	__IO uint32_t TBPMR;
+	__IO uint32_t TAR;
+	__IO uint32_t TBR;
+	__IO uint32_t TAV;
+	__IO uint32_t TBV;
+	__IO uint32_t RTCPD;
+	__IO uint32_t TAPS;
+	__IO uint32_t TBPS;
+	__IO uint32_t TAPV;
+	__IO uint32_t TBPV;
+	__IO uint32_t PP;
+} TIMER0_Type;
+
+typedef TIMER0_Type WTIMER0_Type;
+
+typedef struct
+{
+	__IO uint32_t CR0;
+	__IO uint32_t CR1;
+	__IO uint32_t DR;
+	__IO uint32_t SR;
+	__IO uint32_t CPSR;
+	__IO uint32_t IM;
+	__IO uint32_t RIS;
+	__IO uint32_t MIS;
+	__IO uint32_t ICR;
+	__IO uint32_t DMACTL;
+	__IO uint32_t CC;
+} SSI0_Type;
+
+typedef struct
+{
+	__IO uint32_t DID0;
+	__IO uint32_t DID1;
+	__IO uint32_t PBORCTL;
+	__IO uint32_t RIS;
+	__IO uint32_t IMC;
+	__IO uint32_t MISC;
+	__IO uint32_t RESC;
+	__IO uint32_t RCC;
+	__IO uint32_t GPIOHBCTL;
+	__IO uint32_t RCC2;
+	__IO uint32_t MOSCCTL;
+	__IO uint32_t DSLPCLKCFG;
+	__IO uint32_t SYSPROP;
+	__IO uint32_t PIOSCCAL;
+	__IO uint32_t PIOSCSTAT;
+	__IO uint32_t PLLFREQ0;
+	__IO uint32_t PLLFREQ1;
+	__IO uint32_t PLLSTAT;
+	__IO uint32_t SLPPWRCFG;
+	__IO uint32_t DSLPPWRCFG;
+	__IO uint32_t RCGCTIMER;
+	__IO uint32_t RCGCGPIO;
+	__IO uint32_t RCGCHIB;
+	__IO uint32_t RCGCSSI;
+	__IO uint32_t RCGCEEPROM;
+	__IO uint32_t RCGCWTIMER;
+	__IO uint32_t SCGCTIMER;
+	__IO uint32_t SCGCGPIO;
+	__IO uint32_t SCGCWTIMER;
+	__IO uint32_t DCGCTIMER;
+	__IO uint32_t DCGCGPIO;
+	__IO uint32_t DCGCWTIMER;
+	__IO uint32_t PRTIMER;
+	__IO uint32_t PRGPIO;
+	__IO uint32_t PRHIB;
+	__IO uint32_t PRSSI;
+	__IO uint32_t PREEPROM;
+	__IO uint32_t PRWTIMER;
+} SYSCTL_Type;
+
+typedef struct
+{
+	__IO uint32_t ISER[8];
+	__IO uint32_t ICER[8];
+	__IO uint32_t ISPR[8];
+	__IO uint32_t ICPR[8];
+	__IO uint32_t IABR[8];
+	__IO uint8_t  IPR[240];
+	__O  uint32_t STIR;
+} NVIC_Type;
+
+typedef struct
+{
+	__IO uint32_t CTRL;
+	__IO uint32_t LOAD;
+	__IO uint32_t VAL;
+	__I  uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct
+{
+	__I  uint32_t CPUID;
+	__IO uint32_t ICSR;
+	__IO uint32_t VTOR;
+	__IO uint32_t AIRCR;
+	__IO uint32_t SCR;
+	__IO uint32_t CCR;
+	__IO uint8_t  SHPR[12];
+	__IO uint32_t SHCSR;
+} SCB_Type;
+
+typedef struct
+{
+	__IO uint32_t EESIZE;
+	__IO uint32_t EEBLOCK;
+	__IO uint32_t EEOFFSET;
+	__I  uint32_t RESERVED0;
+	__IO uint32_t EERDWR;
+	__IO uint32_t EERDWRINC;
+	__IO uint32_t EEDONE;
+	__IO uint32_t EESUPP;
+	__IO uint32_t EEUNLOCK;
+} EEPROM_Type;
+
+typedef struct
+{
+	__IO uint32_t FMA;
+	__IO uint32_t FMD;
+	__IO uint32_t FMC;
+	__I  uint32_t FCRIS;
+	__IO uint32_t FCIM;
+	__IO uint32_t FCMISC;
+} FLASH_CTRL_Type;
+
+typedef struct
+{
+	__IO uint32_t RTCC;
+	__IO uint32_t RTCM0;
+	__I  uint32_t RESERVED0;
+	__IO uint32_t RTCLD;
+	__IO uint32_t CTL;
+	__IO uint32_t IM;
+	__IO uint32_t RIS;
+	__IO uint32_t MIS;
+	__IO uint32_t IC;
+	__IO uint32_t RTCT;
+	__IO uint32_t RTCSS;
+	__I  uint32_t RESERVED1;
+	__IO uint32_t DATA;
+} HIB_Type;
+
+extern GPIOA_Type Host_GPIOA;
+extern GPIOA_Type Host_GPIOB;
+extern GPIOA_Type Host_GPIOC;
+extern GPIOA_Type Host_GPIOD;
+extern GPIOA_Type Host_GPIOE;
+extern GPIOA_Type Host_GPIOF;
+extern TIMER0_Type Host_TIMER0;
+extern TIMER0_Type Host_TIMER1;
+extern TIMER0_Type Host_TIMER2;
+extern WTIMER0_Type Host_WTIMER0;
+extern WTIMER0_Type Host_WTIMER2;
+extern SSI0_Type Host_SSI2;
+extern SYSCTL_Type Host_SYSCTL;
+extern NVIC_Type Host_NVIC;
+extern SysTick_Type Host_SysTick;
+extern SCB_Type Host_SCB;
+
+// EEPROM model (Host_EEPROM.c): 32 blocks of 16 words. A word written to EERDWR or EERDWRINC is
+// stored by the next access to EEPROM, which also loads EERDWR and EERDWRINC with the word at
+// EEBLOCK and EEOFFSET. Reads through EERDWRINC do not move EEOFFSET.
+#define HOST_EEPROM_WORDS 512
+extern uint32_t Host_EEPROM_Storage[HOST_EEPROM_WORDS];
+extern uint32_t Host_EEPROM_Write_Count[HOST_EEPROM_WORDS];
+
+// Number of accesses for which EEDONE reports a write in progress after each stored word
+extern uint32_t Host_EEPROM_Busy_Accesses;
+
+// Number of words still stored before the power is cut, or 0xFFFFFFFF for no power cut
+extern uint32_t Host_EEPROM_Writes_Left;
+
+// Number of accesses, and number of words written while a write was still in progress (driver errors)
+extern uint32_t Host_EEPROM_Accesses;
+extern uint32_t Host_EEPROM_Busy_Errors;
+
+EEPROM_Type *Host_EEPROM_Access(void);
+
+// Flash memory model (Host_Flash.c): 256 KB in a RAM array. A command written to FMC with the
+// write key is carried out by the next access to FLASH_CTRL, which then reads FMC as 0.
+// Programming a word only clears bits, as on the hardware.
+#define HOST_FLASH_SIZE 0x40000
+#define HOST_FLASH_PAGES (HOST_FLASH_SIZE / 1024)
+extern uint32_t Host_Flash_Memory[HOST_FLASH_SIZE / 4];
+extern uint32_t Host_Flash_Erase_Count[HOST_FLASH_PAGES];
+
+// Number of words programmed and pages erased, and number of words programmed twice
+// without an erase (driver errors)
+extern uint32_t Host_Flash_Programs;
+extern uint32_t Host_Flash_Erases;
+extern uint32_t Host_Flash_Reprogram_Errors;
+
+FLASH_CTRL_Type *Host_Flash_Access(void);
+
+// Hibernation module RTC model (Host_RTC.c): the RTC counts host time given to Host_RTC_Advance
+// while RTCEN is set. A value written to RTCLD is loaded into the count by the next access to HIB,
+// and every access sets WRC, so the driver never waits for a register write.
+void Host_RTC_Advance(uint64_t ms);
+
+// Clears the Hibernation module as if VBAT had been removed: the RTC stops and must be started again
+void Host_RTC_Remove_Battery(void);
+
+HIB_Type *Host_HIB_Access(void);
+
+#define GPIOA    (&Host_GPIOA)
+#define GPIOB    (&Host_GPIOB)
+#define GPIOC    (&Host_GPIOC)
+#define GPIOD    (&Host_GPIOD)
+#define GPIOE    (&Host_GPIOE)
+#define GPIOF    (&Host_GPIOF)
+#define TIMER0   (&Host_TIMER0)
+#define TIMER1   (&Host_TIMER1)
+#define TIMER2   (&Host_TIMER2)
+#define WTIMER0  (&Host_WTIMER0)
+#define WTIMER2  (&Host_WTIMER2)
+#define SSI2     (&Host_SSI2)
+#define SYSCTL   (&Host_SYSCTL)
+#define NVIC     (&Host_NVIC)
+#define SysTick  (&Host_SysTick)
+#define SCB      (&Host_SCB)
+#define EEPROM   (Host_EEPROM_Access())
+#define FLASH_CTRL (Host_Flash_Access())
+#define HIB      (Host_HIB_Access())
+
+// The flash memory is read through the RAM array of the model
+#define FLASH_MEMORY_BASE ((uintptr_t)Host_Flash_Memory)
+
+extern uint32_t SystemCoreClock;
+
+// Called by __WFI if set, in place of the interrupt that would wake the CPU up
+extern void (*Host_WFI_Hook)(void);
+
+// Core intrinsics have no effect on the host. The barriers still keep the compiler from moving
+// memory accesses across them, which is what a signal handler standing in for an interrupt needs.
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t priMask) { (void)priMask; }
+static inline void __WFI(void) { if (Host_WFI_Hook) Host_WFI_Hook(); }
+static inline void __DSB(void) { __asm__ volatile ("" ::: "memory"); }
+static inline void __ISB(void) { __asm__ volatile ("" ::: "memory"); }
+static inline void __DMB(void) { __asm__ volatile ("" ::: "memory"); }
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file Hunger.c
+ *
+ * @brief Source code for the hunger model.
+ *
+ * This file contains the function definitions for the closed-form Q16 hunger model.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Hunger.h"
+
+// Returns the level drained between the last update and now.
+// The 64-bit division is only done when the model is read, not on every timer tick.
+static uint32_t Hunger_Drained(const Hunger_Type *hunger, uint32_t now_ms)
+{
+	if (hunger->paused)
+	{
+		return 0;
+	}
+	
+	uint32_t elapsed_ms = now_ms - hunger->last_update_ms;
+	uint64_t drained_q16 = ((uint64_t)elapsed_ms << 16) / hunger->decay_ms;
+	
+	if (drained_q16 > hunger->level_q16)
+	{
+		return hunger->level_q16;
+	}
+	return (uint32_t)drained_q16;
+}
+
+// Moves the last update to the current time without changing the current level
+static void Hunger_Rebase(Hunger_Type *hunger, uint32_t now_ms)
+{
+	hunger->level_q16 = hunger->level_q16 - Hunger_Drained(hunger, now_ms);
+	hunger->last_update_ms = now_ms;
+}
+
+void Hunger_Init(Hunger_Type *hunger, uint32_t decay_ms, uint32_t now_ms)
+{
+	hunger->level_q16 = HUNGER_FULL;
+	hunger->last_update_ms = now_ms;
+	hunger->decay_ms = decay_ms ? decay_ms : 1;
+	hunger->paused = 0;
+}
+
+uint32_t Hunger_Get(const Hunger_Type *hunger, uint32_t now_ms)
+{
+	return hunger->level_q16 - Hunger_Drained(hunger, now_ms);
+}
+
+void Hunger_Add(Hunger_Type *hunger, uint32_t amount_q16, uint32_t now_ms)
+{
+	Hunger_Rebase(hunger, now_ms);
+	
+	if (amount_q16 >= HUNGER_FULL - hunger->level_q16)
+	{
+		hunger->level_q16 = HUNGER_FULL;
+	}
+	else
+	{
+		hunger->level_q16 = hunger->level_q16 + amount_q16;
+	}
+}
+
+void Hunger_Set_Decay(Hunger_Type *hunger, uint32_t decay_ms, uint32_t now_ms)
+{
+	Hunger_Rebase(hunger, now_ms);
+	hunger->decay_ms = decay_ms ? decay_ms : 1;
+}
+
+void Hunger_Pause(Hunger_Type *hunger, uint32_t now_ms)
+{
+	Hunger_Rebase(hunger, now_ms);
+	hunger->paused = 1;
+}
+
+void Hunger_Resume(Hunger_Type *hunger, uint32_t now_ms)
+{
+	// The time spent paused is skipped by restarting the decay from now
+	hunger->last_update_ms = now_ms;
+	hunger->paused = 0;
+}
+
+uint32_t Hunger_Get_Time_Left(const Hunger_Type *hunger, uint32_t now_ms)
+{
+	uint32_t level_q16 = Hunger_Get(hunger, now_ms);
+	
+	// Smallest time t for which (t << 16) / decay_ms drains the whole level
+	return (uint32_t)((((uint64_t)level_q16 * hunger->decay_ms) + 0xFFFF) >> 16);
+}
+
+uint8_t Hunger_Get_LEDs(uint32_t level_q16)
+{
+	// Number of LEDs with any part left, rounded up
+	uint32_t lit_leds = (level_q16 + HUNGER_ONE_LED - 1) >> 16;
+	
+	if (lit_leds > 4)
+	{
+		lit_leds = 4;
+	}
+	return (uint8_t)((1 << lit_leds) - 1);
+}
@@ -0,0 +1,120 @@
+/**
+ * @file Hunger.h
+ *
+ * @brief Header file for the hunger model.
+ *
+ * The hunger level is a Q16 fixed-point number of hunger LEDs, from 0 (starved) to
+ * HUNGER_FULL (four LEDs). The model only stores the level at the last update, the time
+ * of the last update and the decay interval. The current level is computed in closed form
+ * when it is read, so no periodic tick is needed and the level is exact for any time
+ * between two reads, including pauses and sleep:
+ *
+ *  level(now) = level(last update) - ((now - last update) << 16) / decay_ms
+ *
+ * The level is clamped at 0. Every function that changes the model first moves the last
+ * update to the current time, so the level before the change is kept exactly.
+ *
+ * Times are given in milliseconds (see Pet_Clock_Get_Ms) and may wrap around. The time between
+ * two updates must be less than 2^32 ms (about 49 days).
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+// Q16 fixed-point levels: one hunger LED is 1.0 and a full hunger bar is 4.0
+#define HUNGER_ONE_LED  (1UL << 16)
+#define HUNGER_FULL     (4UL << 16)
+
+typedef struct
+{
+	uint32_t level_q16;
+	uint32_t last_update_ms;
+	uint32_t decay_ms;
+	uint8_t paused;
+} Hunger_Type;
+
+/**
+ * @brief Initializes the hunger model with a full hunger bar.
+ *
+ * @param hunger A pointer to the hunger model.
+ * @param decay_ms The time in milliseconds for one hunger LED to drain (at least 1).
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Hunger_Init(Hunger_Type *hunger, uint32_t decay_ms, uint32_t now_ms);
+
+/**
+ * @brief Returns the hunger level at the given time without changing the model.
+ *
+ * @param hunger A pointer to the hunger model.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return The Q16 hunger level from 0 to HUNGER_FULL.
+ */
+uint32_t Hunger_Get(const Hunger_Type *hunger, uint32_t now_ms);
+
+/**
+ * @brief Adds to the hunger level, up to HUNGER_FULL.
+ *
+ * @param hunger A pointer to the hunger model.
+ * @param amount_q16 The Q16 amount to add (for example, 2 * HUNGER_ONE_LED).
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Hunger_Add(Hunger_Type *hunger, uint32_t amount_q16, uint32_t now_ms);
+
+/**
+ * @brief Changes the decay interval from the given time on.
+ *
+ * @param hunger A pointer to the hunger model.
+ * @param decay_ms The time in milliseconds for one hunger LED to drain (at least 1).
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Hunger_Set_Decay(Hunger_Type *hunger, uint32_t decay_ms, uint32_t now_ms);
+
+/**
+ * @brief Stops the decay. The level stays constant until Hunger_Resume is called.
+ *
+ * @param hunger A pointer to the hunger model.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Hunger_Pause(Hunger_Type *hunger, uint32_t now_ms);
+
+/**
+ * @brief Restarts the decay from the level reached when the model was paused.
+ *
+ * @param hunger A pointer to the hunger model.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Hunger_Resume(Hunger_Type *hunger, uint32_t now_ms);
+
+/**
+ * @brief Returns the time left until the hunger level reaches 0.
+ *
+ * @param hunger A pointer to the hunger model.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return The time left in milliseconds (rounded up), or 0 if the pet has starved.
+ * The decay interval is not applied while the model is paused.
+ */
+uint32_t Hunger_Get_Time_Left(const Hunger_Type *hunger, uint32_t now_ms);
+
+/**
+ * @brief Converts a hunger level to the hunger bar LED pattern.
+ *
+ * A hunger LED stays on while any part of it is left, so a level of 2.5 lights three LEDs.
+ *
+ * @param level_q16 The Q16 hunger level.
+ *
+ * @return A 4-bit value for the hunger bar LEDs (PB0 - PB3), filled from LED0 up.
+ */
+uint8_t Hunger_Get_LEDs(uint32_t level_q16);
@@ -0,0 +1,171 @@
+/**
+ * @file Input_Log.c
+ *
+ * @brief Source code for the input record and replay log.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Input_Log.h"
+
+void Input_Log_Init(Input_Log_Type *log, uint8_t *buffer, uint32_t size, uint8_t initial_state, uint32_t start_time_us)
+{
+	log->buffer = buffer;
+	log->size = size;
+	log->last_time_us = start_time_us;
+	log->record_count = 0;
+	log->dropped_count = 0;
+	log->wrapped_count = 0;
+	log->last_state = initial_state & 0x0F;
+	log->full = (size < INPUT_LOG_HEADER_SIZE);
+	log->length = 0;
+	
+	if (!log->full)
+	{
+		buffer[0] = 'I';
+		buffer[1] = 'L';
+		buffer[2] = INPUT_LOG_VERSION;
+		buffer[3] = log->last_state;
+		log->length = INPUT_LOG_HEADER_SIZE;
+	}
+}
+
+// Returns the time unit of a record that changes the bits of edges
+static uint32_t Input_Log_Tick_Us(uint8_t edges)
+{
+	return (edges & INPUT_LOG_FINE_MASK) ? 1 : INPUT_LOG_COARSE_TICK_US;
+}
+
+// Appends a record of a state (which may be the last recorded state) to a log that has room for it
+static void Input_Log_Append(Input_Log_Type *log, uint8_t state, uint32_t time_us)
+{
+	uint32_t tick_us = Input_Log_Tick_Us(state ^ log->last_state);
+	uint32_t delta = (time_us - log->last_time_us) / tick_us;
+	uint32_t extension = delta >> 3;
+	uint8_t *record = &log->buffer[log->length];
+	uint32_t index = 0;
+	
+	record[index++] = (uint8_t)((state << 4) | ((extension != 0) << 3) | (delta & 0x07));
+	
+	while (extension != 0)
+	{
+		uint8_t next = extension & 0x7F;
+		extension = extension >> 7;
+		if (extension != 0)
+		{
+			next |= 0x80;
+		}
+		record[index++] = next;
+	}
+	
+	log->length += index;
+	log->last_time_us += delta * tick_us;
+	log->last_state = state;
+	log->record_count++;
+}
+
+// Returns whether a log has no room left for a record
+static uint8_t Input_Log_Is_Full(Input_Log_Type *log)
+{
+	if (log->full || (log->size - log->length) < INPUT_LOG_MAX_RECORD)
+	{
+		log->full = 1;
+	}
+	return log->full;
+}
+
+uint8_t Input_Log_Record(Input_Log_Type *log, uint8_t state, uint32_t time_us)
+{
+	state = state & 0x0F;
+	
+	if (state == log->last_state)
+	{
+		return 1;
+	}
+	
+	if (Input_Log_Is_Full(log))
+	{
+		// Count every change that is lost, including a change back to the last recorded state
+		log->dropped_count++;
+		log->last_state = state;
+		return 0;
+	}
+	
+	if ((time_us - log->last_time_us) >= INPUT_LOG_WRAP_US)
+	{
+		log->wrapped_count++;
+	}
+	
+	Input_Log_Append(log, state, time_us);
+	return 1;
+}
+
+uint8_t Input_Log_Update_Time(Input_Log_Type *log, uint32_t time_us)
+{
+	if ((time_us - log->last_time_us) < INPUT_LOG_MAX_GAP_US)
+	{
+		return 1;
+	}
+	
+	if (Input_Log_Is_Full(log))
+	{
+		return 0;
+	}
+	
+	Input_Log_Append(log, log->last_state, time_us);
+	return 1;
+}
+
+uint8_t Input_Log_Reader_Init(Input_Log_Reader *reader, const uint8_t *buffer, uint32_t length)
+{
+	reader->buffer = buffer;
+	reader->length = length;
+	reader->position = INPUT_LOG_HEADER_SIZE;
+	reader->time_us = 0;
+	reader->state = 0;
+	
+	if (length < INPUT_LOG_HEADER_SIZE || buffer[0] != 'I' || buffer[1] != 'L' || buffer[2] != INPUT_LOG_VERSION)
+	{
+		reader->length = 0;
+		return 0;
+	}
+	
+	reader->state = buffer[3] & 0x0F;
+	return 1;
+}
+
+uint8_t Input_Log_Next(Input_Log_Reader *reader)
+{
+	if (reader->position >= reader->length)
+	{
+		return 0;
+	}
+	
+	uint8_t first = reader->buffer[reader->position++];
+	uint32_t delta = first & 0x07;
+	
+	if (first & 0x08)
+	{
+		uint32_t shift = 3;
+		uint8_t next;
+		
+		do
+		{
+			if (reader->position >= reader->length)
+			{
+				// Truncated record
+				reader->position = reader->length;
+				return 0;
+			}
+			next = reader->buffer[reader->position++];
+			delta |= (uint32_t)(next & 0x7F) << shift;
+			shift += 7;
+		} while (next & 0x80);
+	}
+	
+	uint8_t state = first >> 4;
+	reader->time_us += delta * Input_Log_Tick_Us(state ^ reader->state);
+	reader->state = state;
+	
+	return 1;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file Input_Log.h
+ *
+ * @brief Header file for the input record and replay log.
+ *
+ * The log stores every change of a 4-bit input state (PD0 - PD3) with its time in a compact
+ * binary format, so that a captured session can be fed back through the same input path. The
+ * module has no hardware dependencies and builds for the board and the host.
+ *
+ * Log format:
+ *  - Header (4 bytes): 'I', 'L', INPUT_LOG_VERSION, initial state
+ *  - One record per change:
+ *      Byte 0: Bits 7 to 4 = new state, Bit 3 = extension flag, Bits 2 to 0 = delta time (Bits 2 to 0)
+ *      If the extension flag is set, the remaining delta time bits (delta >> 3) follow as a
+ *      little-endian base-128 varint (Bit 7 set on every byte except the last).
+ *    The delta time is the time since the previous record (or the start of the log). It counts
+ *    microseconds when a bit of INPUT_LOG_FINE_MASK (encoder pins A and B) changes, and
+ *    INPUT_LOG_COARSE_TICK_US ticks otherwise (button and switch), since the debounce and the
+ *    gestures work in milliseconds. The fraction of a tick is carried to the next record.
+ *  - A record with the same state as the previous one only adds its delta time. It is written by
+ *    Input_Log_Update_Time, so that the delta time of a record never wraps, and the reader returns
+ *    it like a change, so that a replay can follow the time across long idle times.
+ *
+ * A record is 1 byte for deltas below 8 ticks, 2 bytes below 1024, 3 bytes below 131072 and
+ * 4 bytes below 16.7 million. Knob rotation is mostly 2 - 3 bytes per edge. A button press or release
+ * is about 2 - 3 bytes plus 1 byte for each contact bounce. A game with a feed click every 4 s takes
+ * about 2 - 3 bytes per second (the click window of Gesture.h keeps the clicks apart), so a 16 KB log
+ * holds about 1.5 to 2 hours of play, and many hours of idle time cost nothing.
+ *
+ * The changes that do not fit in the buffer, and the records whose delta time may have wrapped
+ * because Input_Log_Update_Time was not called for INPUT_LOG_WRAP_US or more, are counted in the log.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+#define INPUT_LOG_VERSION       2
+#define INPUT_LOG_HEADER_SIZE   4
+
+// Largest possible record: 1 byte + a 5-byte varint for a 29-bit delta
+#define INPUT_LOG_MAX_RECORD    6
+
+// Input bits whose changes are timed in microseconds (PMOD ENC pins A and B)
+#define INPUT_LOG_FINE_MASK     0x03
+
+// Time unit of the other changes and of the time records
+#define INPUT_LOG_COARSE_TICK_US 1000
+
+// Time between records after which Input_Log_Update_Time adds a time record (about 18 minutes).
+// It is half of INPUT_LOG_WRAP_US, so records stay less than 2^31 us apart even when the function
+// is called some time after the threshold was reached.
+#define INPUT_LOG_MAX_GAP_US    0x40000000UL
+
+// Time between records from which the delta time of a change may have wrapped (about 36 minutes)
+#define INPUT_LOG_WRAP_US       0x80000000UL
+
+typedef struct
+{
+	uint8_t *buffer;
+	uint32_t size;
+	uint32_t length;
+	uint32_t last_time_us;
+	uint32_t record_count;
+	uint32_t dropped_count;
+	uint32_t wrapped_count;
+	uint8_t last_state;
+	uint8_t full;
+} Input_Log_Type;
+
+typedef struct
+{
+	const uint8_t *buffer;
+	uint32_t length;
+	uint32_t position;
+	uint32_t time_us;
+	uint8_t state;
+} Input_Log_Reader;
+
+/**
+ * @brief Starts a new log in the given buffer.
+ *
+ * @param log A pointer to the log.
+ * @param buffer The buffer that stores the log.
+ * @param size The size of the buffer in bytes (at least INPUT_LOG_HEADER_SIZE).
+ * @param initial_state The input state at the start of the log.
+ * @param start_time_us The time at the start of the log in microseconds.
+ *
+ * @return None
+ */
+void Input_Log_Init(Input_Log_Type *log, uint8_t *buffer, uint32_t size, uint8_t initial_state, uint32_t start_time_us);
+
+/**
+ * @brief Appends an input state to the log if it differs from the last recorded state.
+ *
+ * A change that does not fit in the buffer is counted in log->dropped_count. A change recorded
+ * INPUT_LOG_WRAP_US or more after the previous record is counted in log->wrapped_count, since
+ * its delta time may have wrapped. A change 2^32 us or more after the previous record can only be
+ * told apart from a shorter one by the time records of Input_Log_Update_Time.
+ *
+ * @param log A pointer to the log.
+ * @param state The current input state (only Bits 3 to 0 are recorded).
+ * @param time_us The current time in microseconds.
+ *
+ * @return 1 if the state was recorded or unchanged, 0 if the log is full.
+ */
+uint8_t Input_Log_Record(Input_Log_Type *log, uint8_t state, uint32_t time_us);
+
+/**
+ * @brief Adds a time record to the log once the time since the last record reaches INPUT_LOG_MAX_GAP_US.
+ *
+ * Calling this function at least once every INPUT_LOG_MAX_GAP_US keeps every record less than
+ * 2^31 us after the previous one, however long the input stays unchanged, so no delta time wraps.
+ *
+ * @param log A pointer to the log.
+ * @param time_us The current time in microseconds.
+ *
+ * @return 1 if no record was needed or it was added, 0 if the log is full.
+ */
+uint8_t Input_Log_Update_Time(Input_Log_Type *log, uint32_t time_us);
+
+/**
+ * @brief Prepares a reader for a log.
+ *
+ * @param reader A pointer to the reader.
+ * @param buffer The log data, starting with the header.
+ * @param length The length of the log data in bytes.
+ *
+ * @return 1 if the header is valid, 0 otherwise.
+ */
+uint8_t Input_Log_Reader_Init(Input_Log_Reader *reader, const uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief Reads the next record from a log.
+ *
+ * After a successful call, reader->state holds the new input state and reader->time_us holds
+ * the time of the change in microseconds since the start of the log. A time record is returned
+ * with the state unchanged, so with the time records of Input_Log_Update_Time, the times of two
+ * records read one after the other are less than 2^31 us apart and can be compared by their
+ * signed difference.
+ *
+ * @param reader A pointer to the reader.
+ *
+ * @return 1 if a record was read, 0 at the end of the log.
+ */
+uint8_t Input_Log_Next(Input_Log_Reader *reader);
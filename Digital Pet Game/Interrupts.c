@@ -0,0 +1,150 @@
+/**
+ * @file Interrupts.c
+ *
+ * @brief Source code for the interrupt configuration table.
+ *
+ * This file contains the function definitions for the interrupt configuration table, and the
+ * compile-time checks of the table. The checks use the same negative array size as
+ * CLOCK_STATIC_ASSERT (Clock.h), with one enumeration constant per interrupt holding its
+ * preemption priority.
+ *
+ * The vector table of the startup code is __Vectors, as in the CMSIS startup files. VTOR holds the
+ * address of the table in its OFFSET field (Bits 31 to 10), so the table in SRAM is aligned to
+ * 1024 bytes.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Interrupts.h"
+
+#define INTERRUPTS_STATIC_ASSERT(condition, name) typedef char interrupts_static_assert_##name[(condition) ? 1 : -1]
+
+// Every handler of the table
+#define INTERRUPTS_DECLARE(irq, preempt, sub, handler) void handler(void);
+INTERRUPTS_TABLE(INTERRUPTS_DECLARE)
+
+// Preemption priority of every interrupt. An interrupt listed twice defines the same constant twice.
+#define INTERRUPTS_PREEMPT_CONSTANT(irq, preempt, sub, handler) INTERRUPTS_PREEMPT_##irq = (preempt),
+enum
+{
+	INTERRUPTS_TABLE(INTERRUPTS_PREEMPT_CONSTANT)
+};
+
+// Every priority must fit in its bits
+#define INTERRUPTS_CHECK_RANGE(irq, preempt, sub, handler) \
+	INTERRUPTS_STATIC_ASSERT((preempt) < INTERRUPTS_PREEMPT_LEVELS && (sub) < INTERRUPTS_SUB_LEVELS, range_##irq);
+INTERRUPTS_TABLE(INTERRUPTS_CHECK_RANGE)
+
+// The BCM_LED slots preempt every other interrupt, and the heartbeat samples every other one but them
+#define INTERRUPTS_CHECK_PLAN(irq, preempt, sub, handler) \
+	INTERRUPTS_STATIC_ASSERT((irq) == TIMER2A_IRQn || (preempt) > INTERRUPTS_PREEMPT_TIMER2A_IRQn, bcm_first_##irq); \
+	INTERRUPTS_STATIC_ASSERT((irq) == TIMER2A_IRQn || (irq) == TIMER0B_IRQn || \
+		(preempt) > INTERRUPTS_PREEMPT_TIMER0B_IRQn, heartbeat_second_##irq);
+INTERRUPTS_TABLE(INTERRUPTS_CHECK_PLAN)
+
+// The PMOD ENC input interrupts share the input state, so none of them may preempt another
+INTERRUPTS_STATIC_ASSERT(INTERRUPTS_PREEMPT_GPIOD_IRQn == INTERRUPTS_PREEMPT_TIMER0A_IRQn &&
+	INTERRUPTS_PREEMPT_GPIOD_IRQn == INTERRUPTS_PREEMPT_TIMER1A_IRQn &&
+	INTERRUPTS_PREEMPT_GPIOD_IRQn == INTERRUPTS_PREEMPT_WTIMER2A_IRQn &&
+	INTERRUPTS_PREEMPT_GPIOD_IRQn == INTERRUPTS_PREEMPT_WTIMER2B_IRQn, pmod_enc_one_level);
+
+#define INTERRUPTS_ENTRY(irq, preempt, sub, handler) {(irq), (preempt), (sub), &handler, #handler},
+static const Interrupts_Entry interrupts_table[] =
+{
+	INTERRUPTS_TABLE(INTERRUPTS_ENTRY)
+};
+
+#define INTERRUPTS_COUNT (sizeof(interrupts_table) / sizeof(interrupts_table[0]))
+
+// Vector table of the startup code in the flash memory
+extern void (* const __Vectors[INTERRUPTS_VECTOR_COUNT])(void);
+
+#if INTERRUPTS_RAM_VECTORS
+// The 155 vectors of 4 bytes fit in the 1024 bytes of the alignment
+INTERRUPTS_STATIC_ASSERT(INTERRUPTS_VECTOR_COUNT * 4 <= 1024, ram_vectors_alignment);
+static void (*interrupts_ram_vectors[INTERRUPTS_VECTOR_COUNT])(void) __attribute__((aligned(1024)));
+#endif
+
+// Vector table in use
+static void (* const *interrupts_vectors)(void) = __Vectors;
+
+void Interrupts_Init(void)
+{
+#if INTERRUPTS_RAM_VECTORS
+	// Copy the vector table to SRAM with the handler of every interrupt of the table, then point VTOR to it
+	for (uint32_t i = 0; i < INTERRUPTS_VECTOR_COUNT; i++)
+	{
+		interrupts_ram_vectors[i] = __Vectors[i];
+	}
+	for (uint8_t i = 0; i < INTERRUPTS_COUNT; i++)
+	{
+		interrupts_ram_vectors[16 + interrupts_table[i].irq] = interrupts_table[i].handler;
+	}
+	SCB->VTOR = (uint32_t)(uintptr_t)interrupts_ram_vectors;
+	__DSB();
+	interrupts_vectors = interrupts_ram_vectors;
+#endif
+	
+	// Write the PRIGROUP field (Bits 10 to 8) of AIRCR, which only accepts
+	// writes with 0x05FA in the VECTKEY field (Bits 31 to 16)
+	SCB->AIRCR = 0x05FA0000 | (INTERRUPTS_PRIGROUP << 8);
+	
+	for (uint8_t i = 0; i < INTERRUPTS_COUNT; i++)
+	{
+		int32_t irq = interrupts_table[i].irq;
+		uint8_t priority = INTERRUPTS_PRIORITY(interrupts_table[i].preempt, interrupts_table[i].sub);
+		
+		if (irq < 0)
+		{
+			// System exceptions 4 to 15 have their priority field in SHPR, and are enabled by their own peripheral
+			SCB->SHPR[(irq & 0x0F) - 4] = priority;
+		}
+		else
+		{
+			// One priority byte per IRQ in IPR, and one enable bit per IRQ in ISER
+			NVIC->IPR[irq] = priority;
+			NVIC->ISER[irq >> 5] |= (1UL << (irq & 0x1F));
+		}
+	}
+}
+
+// An interrupt listed twice under another name makes a duplicate case value
+#define INTERRUPTS_CASE(irq, preempt, sub, handler) case (irq): return INTERRUPTS_PRIORITY(preempt, sub);
+
+uint8_t Interrupts_Get_Priority(int32_t irq)
+{
+	switch (irq)
+	{
+		INTERRUPTS_TABLE(INTERRUPTS_CASE)
+		default: return 0;
+	}
+}
+
+uint8_t Interrupts_Get_Count(void)
+{
+	return INTERRUPTS_COUNT;
+}
+
+const Interrupts_Entry *Interrupts_Get(uint8_t index)
+{
+	return &interrupts_table[index];
+}
+
+uint8_t Interrupts_Set_Handler(int32_t irq, void (*handler)(void))
+{
+#if INTERRUPTS_RAM_VECTORS
+	// A vector is a single word, so an interrupt taken during the write runs either handler
+	interrupts_ram_vectors[16 + irq] = handler;
+	__DSB();
+	return 1;
+#else
+	(void)irq;
+	(void)handler;
+	return 0;
+#endif
+}
+
+void (*Interrupts_Get_Handler(int32_t irq))(void)
+{
+	return interrupts_vectors[16 + irq];
+}
@@ -0,0 +1,153 @@
+/**
+ * @file Interrupts.h
+ *
+ * @brief Header file for the interrupt configuration table.
+ *
+ * Every interrupt used by the game is listed once in INTERRUPTS_TABLE with its preemption priority,
+ * sub-priority and handler. Interrupts_Init sets the priority grouping, writes the priority of every
+ * listed interrupt and enables it, so the drivers no longer write the NVIC themselves.
+ *
+ * The TM4C123GH6PM implements 3 priority bits, split into 2 preemption bits (levels 0 to 3, 0 is
+ * the highest) and 1 sub-priority bit, which only orders pending interrupts of the same level.
+ * Preemption plan:
+ *  - Level 0: BCM_LED slots (Timer 2A). Only a critical section (Power.h) can delay a slot
+ *    boundary, so the LED brightness has bounded jitter.
+ *  - Level 1: PWM_PF1 heartbeat samples (Timer 0B). Only the short BCM_LED handler can delay them.
+ *  - Level 2: PMOD ENC input: the capture (Wide Timer 2A and 2B), then GPIO Port D, the debounce
+ *    tick (Timer 0A) and the input replay (Timer 1A). They share the input state, so they must never
+ *    preempt each other. The capture runs first since its edge time is already latched.
+ *  - Level 3: SysTick_Delay, which only counts microseconds for the blocking delays of the LCD and
+ *    the seven-segment display refresh in the main loop. A delay can only become longer.
+ *
+ * The build stops if an interrupt is listed twice, if a priority is out of range, or if the table
+ * does not follow the preemption plan above.
+ *
+ * With INTERRUPTS_RAM_VECTORS set, Interrupts_Init also moves the vector table to SRAM, so a driver
+ * can install a handler straight into a vector at run time (Interrupts_Set_Handler) instead of
+ * calling its task through a pointer from a trampoline handler. The hot handlers are placed in SRAM
+ * with INTERRUPTS_RAMFUNC, away from the flash wait states of the 80 MHz system clock.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+// Priority bits implemented by the device, and the number of them used for the sub-priority
+#define INTERRUPTS_PRIORITY_BITS    3
+#define INTERRUPTS_SUB_BITS         1
+
+#define INTERRUPTS_PREEMPT_LEVELS   (1 << (INTERRUPTS_PRIORITY_BITS - INTERRUPTS_SUB_BITS))
+#define INTERRUPTS_SUB_LEVELS       (1 << INTERRUPTS_SUB_BITS)
+
+// PRIGROUP field of AIRCR: the sub-priority takes the lowest implemented bits of the 8-bit field
+#define INTERRUPTS_PRIGROUP         (7 - (INTERRUPTS_PRIORITY_BITS - INTERRUPTS_SUB_BITS))
+
+// Value of a priority register field (IPR or SHPR) for a preemption priority and a sub-priority
+#define INTERRUPTS_PRIORITY(preempt, sub) \
+	((uint8_t)((((preempt) << INTERRUPTS_SUB_BITS) | (sub)) << (8 - INTERRUPTS_PRIORITY_BITS)))
+
+// Vector table in SRAM. It can be set from the compiler command line (-DINTERRUPTS_RAM_VECTORS=0)
+// to keep the vector table and every handler in the flash memory.
+#ifndef INTERRUPTS_RAM_VECTORS
+#define INTERRUPTS_RAM_VECTORS      1
+#endif
+
+// Vectors of the TM4C123GH6PM: the initial stack pointer and the 15 system exceptions, then the
+// 139 device interrupts (IRQ 0 GPIOA to IRQ 138 PWM1_FAULT)
+#define INTERRUPTS_VECTOR_COUNT     (16 + 139)
+
+// Code section of the hot handlers, which the linker places in SRAM (Digital_Pet_Game.sct for the
+// Keil project, GCC/TM4C123GH6PM.ld for the GCC build) and the startup code copies from the flash memory
+#if INTERRUPTS_RAM_VECTORS
+#define INTERRUPTS_RAMFUNC          __attribute__((section(".ramfunc")))
+#else
+#define INTERRUPTS_RAMFUNC
+#endif
+
+// Interrupt table: X(IRQ number, preemption priority, sub-priority, handler)
+#define INTERRUPTS_TABLE(X) \
+	X(TIMER2A_IRQn,  0, 0, TIMER2A_Handler)  /* BCM_LED slots */ \
+	X(TIMER0B_IRQn,  1, 0, TIMER0B_Handler)  /* PWM_PF1 heartbeat samples */ \
+	X(WTIMER2A_IRQn, 2, 0, WTIMER2A_Handler) /* PMOD ENC capture of pin A */ \
+	X(WTIMER2B_IRQn, 2, 0, WTIMER2B_Handler) /* PMOD ENC capture of pin B */ \
+	X(GPIOD_IRQn,    2, 1, GPIOD_Handler)    /* PMOD ENC pins */ \
+	X(TIMER0A_IRQn,  2, 1, TIMER0A_Handler)  /* PMOD ENC debounce tick */ \
+	X(TIMER1A_IRQn,  2, 1, TIMER1A_Handler)  /* PMOD ENC input replay */ \
+	X(SysTick_IRQn,  3, 0, SysTick_Handler)  /* SysTick_Delay */
+
+typedef struct
+{
+	int32_t irq;
+	uint8_t preempt;
+	uint8_t sub;
+	void (*handler)(void);
+	const char *name;
+} Interrupts_Entry;
+
+/**
+ * @brief Applies the interrupt table.
+ *
+ * This function sets the priority grouping in AIRCR, writes the priority of every interrupt of the
+ * table (IPR, or SHPR for a system exception) and enables every device interrupt in ISER. A device
+ * interrupt is only requested once its driver unmasks it, so this function can be called before
+ * or after the drivers are initialized.
+ *
+ * With INTERRUPTS_RAM_VECTORS set, the vector table of the startup code is first copied to SRAM,
+ * with the handler of every interrupt of the table, and VTOR is pointed to the copy. It must then
+ * be called before any driver installs a handler with Interrupts_Set_Handler.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Interrupts_Init(void);
+
+/**
+ * @brief Returns the priority register field that Interrupts_Init writes for an interrupt.
+ *
+ * @param irq The IRQ number (negative for a system exception).
+ *
+ * @return The 8-bit priority field, or 0 (the reset value) for an interrupt that is not in the table.
+ */
+uint8_t Interrupts_Get_Priority(int32_t irq);
+
+/**
+ * @brief Returns the number of entries in the interrupt table.
+ *
+ * @param None
+ *
+ * @return The number of entries.
+ */
+uint8_t Interrupts_Get_Count(void);
+
+/**
+ * @brief Returns an entry of the interrupt table.
+ *
+ * @param index The index of the entry, from 0 to Interrupts_Get_Count() - 1.
+ *
+ * @return A pointer to the entry.
+ */
+const Interrupts_Entry *Interrupts_Get(uint8_t index);
+
+/**
+ * @brief Installs a handler in the vector of an interrupt.
+ *
+ * The handler runs straight from the vector, so it must clear the interrupt itself. Without
+ * INTERRUPTS_RAM_VECTORS the vector table is in the flash memory and nothing is changed.
+ *
+ * @param irq The IRQ number (negative for a system exception).
+ *
+ * @param handler The handler to run from the vector.
+ *
+ * @return 1 if the handler was installed, 0 if the vector table is in the flash memory.
+ */
+uint8_t Interrupts_Set_Handler(int32_t irq, void (*handler)(void));
+
+/**
+ * @brief Returns the handler that the vector of an interrupt runs.
+ *
+ * @param irq The IRQ number (negative for a system exception).
+ *
+ * @return The handler in the vector table in use.
+ */
+void (*Interrupts_Get_Handler(int32_t irq))(void);
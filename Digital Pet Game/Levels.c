@@ -0,0 +1,77 @@
+/**
+ * @file Levels.c
+ *
+ * @brief Source code for the difficulty level table.
+ *
+ * This file contains the descriptors of the difficulty levels, listed in menu order.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Levels.h"
+#include "PWM_PF1.h"
+#include "Pets.h"
+#include "Pet_Stats.h"
+
+// Faster heartbeat for the medium level: 75 bpm when fed and 170 bpm when starving
+static const Heartbeat_Curve heartbeat_medium_curve =
+{
+	{
+		0,
+		HEARTBEAT_PHASE_STEP(170),
+		HEARTBEAT_PHASE_STEP(130),
+		HEARTBEAT_PHASE_STEP(100),
+		HEARTBEAT_PHASE_STEP(75)
+	},
+	{
+		0,
+		HEARTBEAT_GAMMA(96),
+		HEARTBEAT_GAMMA(160),
+		HEARTBEAT_GAMMA(208),
+		HEARTBEAT_GAMMA(255)
+	}
+};
+
+// Racing heartbeat for the hard level: 90 bpm when fed and 200 bpm when starving
+static const Heartbeat_Curve heartbeat_hard_curve =
+{
+	{
+		0,
+		HEARTBEAT_PHASE_STEP(200),
+		HEARTBEAT_PHASE_STEP(150),
+		HEARTBEAT_PHASE_STEP(115),
+		HEARTBEAT_PHASE_STEP(90)
+	},
+	{
+		0,
+		HEARTBEAT_GAMMA(80),
+		HEARTBEAT_GAMMA(144),
+		HEARTBEAT_GAMMA(200),
+		HEARTBEAT_GAMMA(255)
+	}
+};
+
+static const Level_Type levels[] =
+{
+	// label      decay_ms  survival_ms  pet_display   heartbeat_curve           refill_leds        stats_decay
+	{"EASY",      1000,     8000,        &Dog_Display,  0,                        LEVEL_REFILL_FULL, PET_STATS_PACK(0, 4, 3, 2)},
+	{"MEDIUM",    500,      8000,        &Crow_Display, &heartbeat_medium_curve,  LEVEL_REFILL_FULL, PET_STATS_PACK(0, 6, 4, 3)},
+	{"HARD",      250,      8000,        &Cat_Display,  &heartbeat_hard_curve,    LEVEL_REFILL_FULL, PET_STATS_PACK(0, 8, 6, 4)}
+};
+
+#define LEVEL_COUNT (sizeof(levels) / sizeof(levels[0]))
+
+uint8_t Levels_Get_Count(void)
+{
+	return (uint8_t)LEVEL_COUNT;
+}
+
+const Level_Type *Levels_Get(uint8_t index)
+{
+	if (index >= LEVEL_COUNT)
+	{
+		return 0;
+	}
+	
+	return &levels[index];
+}
@@ -0,0 +1,63 @@
+/**
+ * @file Levels.h
+ *
+ * @brief Header file for the difficulty level table.
+ *
+ * Each difficulty level is described by a constant descriptor: the menu label, the hunger
+ * decay interval, the survival time needed to win, the pet shown when the level starts,
+ * the heartbeat curve, the refill rule and the pet stat decay. The main menu and the game are both generated
+ * from the table, so a level is added by adding a row to the table in Levels.c.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+// Number of hunger LEDs restored by a refill that fills the whole hunger bar
+#define LEVEL_REFILL_FULL 4
+
+typedef struct
+{
+	// Menu label, up to 15 characters so that it fits next to the menu arrow
+	const char *label;
+	
+	// Time in milliseconds before the next hunger LED turns off
+	uint32_t decay_ms;
+	
+	// Time in milliseconds that the pet must be kept alive to win
+	uint32_t survival_ms;
+	
+	// Draws the pet of this level on the LCD
+	void (*pet_display)(void);
+	
+	// Heartbeat curve used for the PF1 LED (see PWM_PF1.h), or 0 for the default curve
+	const struct Heartbeat_Curve *heartbeat_curve;
+	
+	// Number of hunger LEDs restored by a refill (1 - LEVEL_REFILL_FULL).
+	// A refill is only allowed while at least one hunger LED is on.
+	uint8_t refill_leds;
+	
+	// Happiness, energy and hygiene lost per pet stats tick, packed with PET_STATS_PACK (see Pet_Stats.h).
+	// The hunger lane follows the hunger model and should be 0.
+	uint32_t stats_decay;
+} Level_Type;
+
+/**
+ * @brief Returns the number of difficulty levels in the table.
+ *
+ * @param None
+ *
+ * @return The number of difficulty levels.
+ */
+uint8_t Levels_Get_Count(void);
+
+/**
+ * @brief Returns the descriptor of a difficulty level.
+ *
+ * The lookup is a single array access. The levels are listed in menu order.
+ *
+ * @param index The level index (0 to Levels_Get_Count() - 1).
+ *
+ * @return A pointer to the level descriptor, or 0 if the index is out of range.
+ */
+const Level_Type *Levels_Get(uint8_t index);
@@ -24,6 +24,59 @@
  */
  
 #include "PMOD_ENC.h"
+#include "Interrupts.h"
+#include "HAL.h"
+#include "Timer_0A_Interrupt.h"
+#include "Timebase.h"
+#include "Debounce.h"
+#include "Gesture.h"
+#include "Input_Log.h"
+
+// The pins read through the HAL are the pins of the driver
+CLOCK_STATIC_ASSERT(HAL_PIN_MASK(HAL_PIN_PMOD_ENC) == PMOD_ENC_ALL_PINS_MASK, pmod_enc_pins);
+
+// Declare pointer to the user-defined task executed on PMOD ENC pin changes
+void (*PMOD_ENC_Edge_Task)(void);
+
+// Marker used in the transition table for illegal transitions (both A and B changed)
+#define PMOD_ENC_INVALID  2
+
+// Quadrature transition table indexed by ((last AB) << 2) | (current AB), where AB = (B << 1) | A.
+// The clockwise sequence is 00 -> 10 -> 11 -> 01 -> 00, which matches the direction
+// reported by PMOD_ENC_Get_Rotation (Pin 1 (A) rising while Pin 2 (B) is high).
+static const int8_t quadrature_table[16] =
+{
+	 0,                -1,                 1,                 PMOD_ENC_INVALID,
+	 1,                 0,                 PMOD_ENC_INVALID, -1,
+	-1,                 PMOD_ENC_INVALID,  0,                 1,
+	 PMOD_ENC_INVALID,  1,                -1,                 0
+};
+
+// Number of valid transitions per reported step and the transitions counted towards the next step
+static int8_t detent_scale = PMOD_ENC_DEFAULT_DETENT_SCALE;
+static int8_t transition_accumulator = 0;
+
+// Number of illegal transitions seen by PMOD_ENC_Decode_Rotation
+static uint32_t transition_error_count = 0;
+
+// Debounce engine for all of Port D, updated by the input tick
+static Debounce_Type port_d_debounce;
+
+// Record and replay state
+static Input_Log_Type record_log;
+static Input_Log_Reader replay_reader;
+static uint8_t recording = 0;
+static volatile uint8_t replaying = 0;
+static uint8_t replay_pending = 0;
+static uint8_t replay_state = 0;
+static uint32_t replay_start_us = 0;
+
+// Set once Pin 1 (A) and Pin 2 (B) are timestamped by Wide Timer 2
+static uint8_t capture_enabled = 0;
+
+// Velocity estimator state: last captured edge time and the filtered time between edges
+static uint32_t last_edge_time = 0;
+static uint32_t edge_period = 0;
 
 void PMOD_ENC_Init(void)
 {
@@ -39,13 +92,324 @@ void PMOD_ENC_Init(void)
 	
 }
 
+// Executed from the Timer 0A vector every PMOD_ENC_TICK_US while the button or switch is active,
+// bound to it at compile time with HAL_BIND_TIMER_0A (HAL.h)
+static void PMOD_ENC_Input_Tick(void)
+{
+	HAL_Timer_Clear(HAL_TIMER_0A);
+	
+	Debounce_Update(&port_d_debounce, PMOD_ENC_Get_State());
+	Gesture_Update(port_d_debounce.state, Timebase_Get_Ms());
+	
+	if (Debounce_Is_Settled(&port_d_debounce) && !Gesture_Is_Busy())
+	{
+		// Discard the edges caused by bounce and unmask the button and switch interrupts
+		GPIOD->ICR = PMOD_ENC_DEBOUNCE_MASK;
+		GPIOD->IM |= PMOD_ENC_DEBOUNCE_MASK;
+		
+		// An edge between the last sample and the unmask would have been discarded, so check once more
+		if (((PMOD_ENC_Get_State() ^ port_d_debounce.state) & PMOD_ENC_DEBOUNCE_MASK) == 0)
+		{
+			return;
+		}
+		GPIOD->IM &= ~PMOD_ENC_DEBOUNCE_MASK;
+	}
+	
+	Timer_0A_One_Shot_Start();
+}
+
+#if HAL_BIND_TIMER_0A
+HAL_BIND(TIMER0A_Handler, PMOD_ENC_Input_Tick);
+#endif
+
+void PMOD_ENC_Interrupt_Init(void(*task)(void))
+{
+	PMOD_ENC_Edge_Task = task;
+	
+	Debounce_Init(&port_d_debounce, PMOD_ENC_Get_State());
+	Gesture_Init(PMOD_ENC_BUTTON_MASK);
+	Timer_0A_One_Shot_Init(&PMOD_ENC_Input_Tick, PMOD_ENC_TICK_US);
+	
+	// Mask the PD0 - PD3 interrupts while they are being configured
+	GPIOD->IM &= ~PMOD_ENC_ALL_PINS_MASK;
+	
+	// Configure PD0 - PD3 to detect edges (IS = 0) on both edges (IBE = 1)
+	GPIOD->IS &= ~PMOD_ENC_ALL_PINS_MASK;
+	GPIOD->IBE |= PMOD_ENC_ALL_PINS_MASK;
+	
+	// Clear any pending edges and unmask the PD0 - PD3 interrupts
+	GPIOD->ICR = PMOD_ENC_ALL_PINS_MASK;
+	GPIOD->IM |= PMOD_ENC_ALL_PINS_MASK;
+	
+	// Keep Port D clocked in sleep and deep-sleep mode so that an edge can wake the microcontroller
+	SYSCTL->SCGCGPIO |= 0x08;
+	SYSCTL->DCGCGPIO |= 0x08;
+	
+	// The priority of IRQ 3 is set and the IRQ is enabled by Interrupts_Init (Interrupts.h)
+}
+
+INTERRUPTS_RAMFUNC void GPIOD_Handler(void)
+{
+	uint32_t edges = GPIOD->MIS & PMOD_ENC_ALL_PINS_MASK;
+	
+	// Acknowledge the PD0 - PD3 interrupts and clear them
+	GPIOD->ICR = edges;
+	
+	// The pins are ignored while a recorded session is being replayed
+	if (replaying)
+	{
+		return;
+	}
+	
+	// The button and switch are sampled by the input tick until they settle
+	if (edges & PMOD_ENC_DEBOUNCE_MASK)
+	{
+		GPIOD->IM &= ~PMOD_ENC_DEBOUNCE_MASK;
+		Timer_0A_One_Shot_Start();
+	}
+	
+	if (edges & (PMOD_ENC_PIN_A_MASK | PMOD_ENC_PIN_B_MASK))
+	{
+		(*PMOD_ENC_Edge_Task)();
+	}
+}
+
+uint8_t PMOD_ENC_Get_Debounced_State(void)
+{
+	return port_d_debounce.state;
+}
+
+// Updates the filtered edge period with a new timestamp from Wide Timer 2
+INTERRUPTS_RAMFUNC static void PMOD_ENC_Capture_Edge(uint32_t edge_time)
+{
+	uint32_t period = edge_time - last_edge_time;
+	
+	if (period < PMOD_ENC_CAPTURE_MIN_PERIOD)
+	{
+		// Bounce: keep the previous estimate and the previous timestamp
+		return;
+	}
+	
+	last_edge_time = edge_time;
+	
+	if (edge_period == 0 || period > PMOD_ENC_CAPTURE_MAX_PERIOD)
+	{
+		// First edge after the knob was idle: there is no previous edge to measure from
+		edge_period = PMOD_ENC_CAPTURE_MAX_PERIOD;
+	}
+	else
+	{
+		// First-order low-pass filter: period += (new - period) / 4
+		edge_period = edge_period - (edge_period >> 2) + (period >> 2);
+	}
+}
+
+void PMOD_ENC_Capture_Init(void)
+{
+	// Enable the clock to Wide Timer 2 by setting the R2 bit (Bit 2) in the RCGCWTIMER register
+	SYSCTL->RCGCWTIMER |= 0x04;
+	
+	capture_enabled = 1;
+	
+	// Stop using the GPIO interrupts for PD0 and PD1
+	GPIOD->IM &= ~(PMOD_ENC_PIN_A_MASK | PMOD_ENC_PIN_B_MASK);
+	
+	// Route PD0 to WT2CCP0 and PD1 to WT2CCP1 (PMCn value 0x7 from Table 10-2 in the datasheet)
+	GPIOD->AFSEL |= (PMOD_ENC_PIN_A_MASK | PMOD_ENC_PIN_B_MASK);
+	GPIOD->PCTL = (GPIOD->PCTL & ~0x000000FF) | 0x00000077;
+	
+	// Disable Wide Timer 2A and 2B before configuration
+	WTIMER2->CTL &= ~0x0101;
+	
+	// 0x4 = Select the 32-bit timer configuration for each half
+	WTIMER2->CFG = 0x04;
+	
+	// Capture mode (0x3), edge-time mode (TnCMR, Bit 2) and count up (TnCDIR, Bit 4)
+	WTIMER2->TAMR = 0x17;
+	WTIMER2->TBMR = 0x17;
+	
+	// Capture both edges: TAEVENT (Bits 3 to 2) and TBEVENT (Bits 11 to 10) = 0x3
+	WTIMER2->CTL |= 0x0C0C;
+	
+	// Free-running over the full 32-bit range
+	WTIMER2->TAILR = 0xFFFFFFFF;
+	WTIMER2->TBILR = 0xFFFFFFFF;
+	
+	// Clear and enable the capture event interrupts: CAEIM (Bit 2) and CBEIM (Bit 10)
+	WTIMER2->ICR = 0x0404;
+	WTIMER2->IMR |= 0x0404;
+	
+	// The priorities of IRQ 98 and IRQ 99 are set and the IRQs are enabled by Interrupts_Init (Interrupts.h)
+	
+	// Start both halves in the same write so that they share the same timebase
+	WTIMER2->CTL |= 0x0101;
+}
+
+uint32_t PMOD_ENC_Get_Velocity(void)
+{
+	uint32_t period = edge_period;
+	
+	// The knob is idle if there has been no edge for a while (the count register is free-running)
+	if (period == 0 || (WTIMER2->TAV - last_edge_time) > PMOD_ENC_CAPTURE_MAX_PERIOD)
+	{
+		return 0;
+	}
+	
+	// Edges per second divided by the number of edges per detent
+	return PMOD_ENC_CAPTURE_CLOCK_HZ / (period * (uint32_t)detent_scale);
+}
+
+int PMOD_ENC_Accelerate(int steps)
+{
+	int multiplier = (int)(PMOD_ENC_Get_Velocity() / PMOD_ENC_ACCEL_DETENTS_PER_SEC);
+	
+	if (multiplier < 1)
+	{
+		multiplier = 1;
+	}
+	
+	return steps * multiplier;
+}
+
+INTERRUPTS_RAMFUNC void WTIMER2A_Handler(void)
+{
+	if (WTIMER2->MIS & 0x0004)
+	{
+		// Acknowledge the capture event and timestamp the Pin 1 (A) edge
+		WTIMER2->ICR = 0x0004;
+		if (!replaying)
+		{
+			PMOD_ENC_Capture_Edge(WTIMER2->TAR);
+			(*PMOD_ENC_Edge_Task)();
+		}
+	}
+}
+
+INTERRUPTS_RAMFUNC void WTIMER2B_Handler(void)
+{
+	if (WTIMER2->MIS & 0x0400)
+	{
+		// Acknowledge the capture event and timestamp the Pin 2 (B) edge
+		WTIMER2->ICR = 0x0400;
+		if (!replaying)
+		{
+			PMOD_ENC_Capture_Edge(WTIMER2->TBR);
+			(*PMOD_ENC_Edge_Task)();
+		}
+	}
+}
+
 // Returns the status of the PD0 through PD3 pins
-uint8_t PMOD_ENC_Get_State(void)
+INTERRUPTS_RAMFUNC uint8_t PMOD_ENC_Get_State(void)
 {
-	uint8_t state = GPIOD->DATA & PMOD_ENC_ALL_PINS_MASK;
+	if (replaying)
+	{
+		return replay_state;
+	}
+	
+	uint8_t state = HAL_GPIO_Read(HAL_PIN_PMOD_ENC);
+	
+	// Every change seen by the input path is recorded, so replaying the log reproduces it
+	if (recording)
+	{
+		Input_Log_Record(&record_log, state, Timebase_Get_Us());
+	}
+	
   return state;
 }
 
+void PMOD_ENC_Record_Start(uint8_t *buffer, uint32_t size)
+{
+	Input_Log_Init(&record_log, buffer, size, HAL_GPIO_Read(HAL_PIN_PMOD_ENC), Timebase_Get_Us());
+	recording = 1;
+}
+
+uint32_t PMOD_ENC_Record_Stop(void)
+{
+	recording = 0;
+	return record_log.length;
+}
+
+uint32_t PMOD_ENC_Record_Get_Dropped(void)
+{
+	return record_log.dropped_count;
+}
+
+uint32_t PMOD_ENC_Record_Get_Wrapped(void)
+{
+	return record_log.wrapped_count;
+}
+
+uint8_t PMOD_ENC_Replay_Start(const uint8_t *buffer, uint32_t length)
+{
+	if (!Input_Log_Reader_Init(&replay_reader, buffer, length))
+	{
+		return 0;
+	}
+	
+	recording = 0;
+	replay_state = replay_reader.state;
+	replay_pending = Input_Log_Next(&replay_reader);
+	replay_start_us = Timebase_Get_Us();
+	replaying = 1;
+	
+	return 1;
+}
+
+uint8_t PMOD_ENC_Is_Replaying(void)
+{
+	return replaying;
+}
+
+INTERRUPTS_RAMFUNC void PMOD_ENC_Replay_Tick(void)
+{
+	if (recording)
+	{
+		Input_Log_Update_Time(&record_log, Timebase_Get_Us());
+	}
+	
+	if (!replaying)
+	{
+		return;
+	}
+	
+	uint32_t elapsed_us = Timebase_Get_Us() - replay_start_us;
+	
+	// Deliver every change that is due, through the same paths as the GPIO and capture interrupts.
+	// Both times wrap after 2^32 us, so they are compared by their signed difference, which is
+	// valid since the records of the log, time records included, are less than 2^31 us apart
+	// (Input_Log_Update_Time). A time record changes no pin and delivers nothing.
+	while (replay_pending && (int32_t)(elapsed_us - replay_reader.time_us) >= 0)
+	{
+		uint8_t edges = replay_reader.state ^ replay_state;
+		replay_state = replay_reader.state;
+		
+		// Button and switch edges are only seen while their interrupts are unmasked
+		if (edges & PMOD_ENC_DEBOUNCE_MASK & GPIOD->IM)
+		{
+			GPIOD->IM &= ~PMOD_ENC_DEBOUNCE_MASK;
+			Timer_0A_One_Shot_Start();
+		}
+		
+		if (edges & (PMOD_ENC_PIN_A_MASK | PMOD_ENC_PIN_B_MASK))
+		{
+			if (capture_enabled)
+			{
+				PMOD_ENC_Capture_Edge((replay_start_us + replay_reader.time_us) * (PMOD_ENC_CAPTURE_CLOCK_HZ / 1000000));
+			}
+			(*PMOD_ENC_Edge_Task)();
+		}
+		
+		replay_pending = Input_Log_Next(&replay_reader);
+	}
+	
+	// The end of the log has been reached, so switch back to the live pins
+	if (!replay_pending)
+	{
+		replaying = 0;
+	}
+}
+
 // Determines the direction of the rotary encoder as it rotates
 int PMOD_ENC_Get_Rotation(uint8_t state, uint8_t last_state)
 {
@@ -70,6 +434,57 @@ int PMOD_ENC_Get_Rotation(uint8_t state, uint8_t last_state)
 	}
 }
 
+// Decodes every valid quadrature transition and reports one step per detent
+int PMOD_ENC_Decode_Rotation(uint8_t state, uint8_t last_state)
+{
+	uint8_t index = ((last_state & 0x03) << 2) | (state & 0x03);
+	int8_t transition = quadrature_table[index];
+	
+	// Both pins changed at once, so the direction is unknown and the transition is rejected
+	if (transition == PMOD_ENC_INVALID)
+	{
+		transition_error_count++;
+		return 0;
+	}
+	
+	transition_accumulator = transition_accumulator + transition;
+	
+	if (transition_accumulator >= detent_scale)
+	{
+		transition_accumulator = transition_accumulator - detent_scale;
+		return 1;
+	}
+	else if (transition_accumulator <= -detent_scale)
+	{
+		transition_accumulator = transition_accumulator + detent_scale;
+		return -1;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+void PMOD_ENC_Set_Detent_Scale(uint8_t transitions_per_step)
+{
+	if (transitions_per_step < 1)
+	{
+		transitions_per_step = 1;
+	}
+	else if (transitions_per_step > 4)
+	{
+		transitions_per_step = 4;
+	}
+	
+	detent_scale = (int8_t)transitions_per_step;
+	transition_accumulator = 0;
+}
+
+uint32_t PMOD_ENC_Get_Error_Count(void)
+{
+	return transition_error_count;
+}
+
 // Two functions return the status of the button and the switch on the PMOD ENC module
 uint8_t PMOD_ENC_Button_Read(uint8_t state)
 {
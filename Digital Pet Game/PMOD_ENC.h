@@ -24,6 +24,7 @@
  */
 
 #include "TM4C123GH6PM.h"
+#include "Clock.h"
 
 #define PMOD_ENC_PIN_A_MASK     0x01
 #define PMOD_ENC_PIN_B_MASK     0x02
@@ -31,6 +32,27 @@
 #define PMOD_ENC_SWITCH_MASK    0x08
 #define PMOD_ENC_ALL_PINS_MASK  0x0F
 
+// Pins that are debounced by the input tick instead of being handled on every edge (BTN and SWT)
+#define PMOD_ENC_DEBOUNCE_MASK  (PMOD_ENC_BUTTON_MASK | PMOD_ENC_SWITCH_MASK)
+
+// Period of the input tick in microseconds while the button or switch is active
+#define PMOD_ENC_TICK_US        1000
+
+// Wide Timer 2 counts at the system clock frequency while capturing encoder edges
+#define PMOD_ENC_CAPTURE_CLOCK_HZ       CLOCK_SYSTEM_HZ
+
+// Edges closer together than this are treated as bounce by the velocity estimator (50 us)
+#define PMOD_ENC_CAPTURE_MIN_PERIOD     (PMOD_ENC_CAPTURE_CLOCK_HZ / 20000)
+
+// Edges further apart than this restart the velocity estimator (100 ms)
+#define PMOD_ENC_CAPTURE_MAX_PERIOD     (PMOD_ENC_CAPTURE_CLOCK_HZ / 10)
+
+// Spin speed (detents per second) that corresponds to one extra step per detent
+#define PMOD_ENC_ACCEL_DETENTS_PER_SEC  8
+
+// Default number of quadrature transitions per detent (one full A/B cycle)
+#define PMOD_ENC_DEFAULT_DETENT_SCALE  4
+
 /**
  * @brief Initializes the PMOD ENC module using Port D.
  *
@@ -48,11 +70,127 @@
  */
 void PMOD_ENC_Init(void);
 
+// Declare pointer to the user-defined task executed on PMOD ENC pin changes
+extern void (*PMOD_ENC_Edge_Task)(void);
+
+/**
+ * @brief Enables edge-triggered interrupts for the PMOD ENC module pins.
+ *
+ * This function configures PD0 - PD3 to generate a GPIO Port D interrupt on both edges,
+ * so the encoder costs no CPU time while it is idle and transitions faster than 1 ms are not missed.
+ * The provided task function is executed on every Pin 1 (A) or Pin 2 (B) edge and should read PMOD_ENC_Get_State.
+ *
+ * An edge on the button (PD2) or switch (PD3) masks their interrupts and starts the input tick, which runs
+ * every PMOD_ENC_TICK_US using Timer 0A in one-shot mode. Each tick samples all of Port D into a vertical counter
+ * debounce engine (Debounce.h) and feeds the debounced button state to the gesture recognizer (Gesture.h),
+ * which reports press, release, click, double-click, long-press and hold-repeat events.
+ * The tick stops and the interrupts are unmasked once all pins have settled and no gesture is in progress.
+ *
+ * Port D remains clocked in sleep and deep-sleep mode, so an encoder edge can wake the
+ * microcontroller from WFI. GPIO Port D and Timer 0A have the same preemption priority in Interrupts.h,
+ * so the task is never preempted by itself.
+ *
+ * @note PMOD_ENC_Init and Timebase_Init must be called before this function. Timer 0A is used
+ * by this function and must not be used for anything else.
+ *
+ * @param task A pointer to the user-defined function to be executed on encoder pin changes.
+ *
+ * @return None
+ */
+void PMOD_ENC_Interrupt_Init(void(*task)(void));
+
+/**
+ * @brief The interrupt service routine (ISR) for GPIO Port D.
+ *
+ * This function acknowledges the PD0 - PD3 edge interrupts, starts the input tick if the
+ * button or switch has changed, and executes the user-defined task if the encoder has moved.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void GPIOD_Handler(void);
+
+/**
+ * @brief Returns the debounced state of the PMOD ENC module pins.
+ *
+ * The button (PD2) and switch (PD3) bits are only valid after PMOD_ENC_Interrupt_Init.
+ *
+ * @param None
+ *
+ * @return The debounced state of PD0 - PD3.
+ */
+uint8_t PMOD_ENC_Get_Debounced_State(void);
+
+/**
+ * @brief Timestamps the encoder edges in hardware using Wide Timer 2 input capture.
+ *
+ * This function routes Pin 1 (A) (PD0) to WT2CCP0 and Pin 2 (B) (PD1) to WT2CCP1 and configures
+ * Wide Timer 2A and 2B as free-running 32-bit up-counters in edge-time mode on both edges.
+ * Each edge is timestamped by the hardware at the system clock resolution, independent of the
+ * interrupt latency. The timestamps feed a velocity estimator (see PMOD_ENC_Get_Velocity).
+ *
+ * The PD0 and PD1 GPIO interrupts are disabled, and the Wide Timer 2A/2B capture interrupts execute
+ * the task registered with PMOD_ENC_Interrupt_Init instead. The pin levels can still be read from
+ * the GPIO DATA register, so PMOD_ENC_Get_State is unchanged.
+ *
+ * @note PMOD_ENC_Interrupt_Init must be called before this function.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PMOD_ENC_Capture_Init(void);
+
+/**
+ * @brief Returns the estimated spin speed of the PMOD ENC module.
+ *
+ * The speed is computed from the filtered time between captured edges. It drops to 0
+ * once no edge has been captured for PMOD_ENC_CAPTURE_MAX_PERIOD.
+ *
+ * @param None
+ *
+ * @return The spin speed in detents per second (always positive).
+ */
+uint32_t PMOD_ENC_Get_Velocity(void);
+
+/**
+ * @brief Scales a number of steps by the current spin speed of the PMOD ENC module.
+ *
+ * Slow rotation returns the steps unchanged. Faster rotation multiplies the steps by
+ * (speed / PMOD_ENC_ACCEL_DETENTS_PER_SEC), so menus and numeric inputs move proportionally to the spin speed.
+ *
+ * @param steps The number of steps returned by PMOD_ENC_Decode_Rotation.
+ *
+ * @return The accelerated number of steps.
+ */
+int PMOD_ENC_Accelerate(int steps);
+
+/**
+ * @brief The interrupt service routine (ISR) for Wide Timer 2A (Pin 1 (A) edges).
+ *
+ * @param None
+ *
+ * @return None
+ */
+void WTIMER2A_Handler(void);
+
+/**
+ * @brief The interrupt service routine (ISR) for Wide Timer 2B (Pin 2 (B) edges).
+ *
+ * @param None
+ *
+ * @return None
+ */
+void WTIMER2B_Handler(void);
+
 /**
  * @brief Gets the current state of the PMOD ENC module.
  *
  * This function reads the current state of the PMOD encoder module from the GPIO pins
  * and returns the state as a byte where each bit represents the state of a pin.
+ * While recording, every change is appended to the input log. While replaying,
+ * the state comes from the log instead of the pins.
  *
  * @param None
  *
@@ -60,6 +198,93 @@ void PMOD_ENC_Init(void);
  */
 uint8_t PMOD_ENC_Get_State(void);
 
+/**
+ * @brief Starts recording every change of PD0 - PD3 seen by PMOD_ENC_Get_State.
+ *
+ * The changes are stored with their time in the format described in Input_Log.h. When the buffer
+ * is full, recording stops and the lost changes are counted (PMOD_ENC_Record_Get_Dropped).
+ *
+ * @note Timebase_Init must be called before this function.
+ *
+ * @param buffer The buffer that stores the log.
+ * @param size The size of the buffer in bytes.
+ *
+ * @return None
+ */
+void PMOD_ENC_Record_Start(uint8_t *buffer, uint32_t size);
+
+/**
+ * @brief Stops recording.
+ *
+ * @param None
+ *
+ * @return The length of the recorded log in bytes.
+ */
+uint32_t PMOD_ENC_Record_Stop(void);
+
+/**
+ * @brief Returns the number of changes that were not recorded because the buffer was full.
+ *
+ * @param None
+ *
+ * @return The number of dropped changes since PMOD_ENC_Record_Start.
+ */
+uint32_t PMOD_ENC_Record_Get_Dropped(void);
+
+/**
+ * @brief Returns the number of recorded changes whose time may have wrapped.
+ *
+ * This only happens if PMOD_ENC_Replay_Tick was not called for INPUT_LOG_WRAP_US (Input_Log.h).
+ *
+ * @param None
+ *
+ * @return The number of changes with a wrapped time since PMOD_ENC_Record_Start.
+ */
+uint32_t PMOD_ENC_Record_Get_Wrapped(void);
+
+/**
+ * @brief Starts replaying a recorded log.
+ *
+ * While replaying, the pins are ignored and PMOD_ENC_Get_State returns the recorded state.
+ * Each recorded change is delivered by PMOD_ENC_Replay_Tick through the same paths as the
+ * GPIO Port D and Wide Timer 2 interrupts, at the recorded time relative to the start of the replay.
+ * Replaying stops and the live pins are used again at the end of the log.
+ *
+ * @param buffer The log data, starting with the header.
+ * @param length The length of the log data in bytes.
+ *
+ * @return 1 if the replay was started, 0 if the log header is invalid.
+ */
+uint8_t PMOD_ENC_Replay_Start(const uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief Indicates whether a recorded log is being replayed.
+ *
+ * @param None
+ *
+ * @return 1 while replaying, 0 otherwise.
+ */
+uint8_t PMOD_ENC_Is_Replaying(void);
+
+/**
+ * @brief Delivers the recorded changes that are due.
+ *
+ * This function must be called periodically (for example, every 1 ms) from an interrupt with the same
+ * preemption priority as GPIO Port D (Interrupts.h), so that the user-defined task is never preempted by itself.
+ * Changes are delivered in order at the first call at or after their recorded time, not at their recorded
+ * phase, so the replay is only as fine as the period of the calls. Every encoder edge is delivered on its
+ * own, so the decoded rotation is the same, but contact bounces delivered in the same call can be debounced
+ * differently, and the gestures can move by up to one period.
+ *
+ * While recording, this function also adds the time records that keep the delta times of the log from
+ * wrapping (Input_Log_Update_Time).
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PMOD_ENC_Replay_Tick(void);
+
 /**
  * @brief Determines the rotation direction of the PMOD ENC module.
  *
@@ -74,6 +299,48 @@ uint8_t PMOD_ENC_Get_State(void);
  */
 int PMOD_ENC_Get_Rotation(uint8_t state, uint8_t last_state);
 
+/**
+ * @brief Decodes the rotation of the PMOD ENC module using the full quadrature state.
+ *
+ * This function looks up the transition from last_state to state in a 16-entry table, so every
+ * valid transition of Pin 1 (A) and Pin 2 (B) is counted (4x the resolution of PMOD_ENC_Get_Rotation).
+ * Transitions where both pins change at once are illegal; they are rejected and counted as errors.
+ * Bounce on a single pin produces a transition followed by its reverse, which cancels out.
+ * Valid transitions are accumulated and a step is reported once per detent (see PMOD_ENC_Set_Detent_Scale).
+ *
+ * Estimated cost in the 1 kHz Timer 0A path (80 MHz system clock):
+ *  - PMOD_ENC_Get_Rotation:     ~10 cycles per call (two bit tests and a branch)
+ *  - PMOD_ENC_Decode_Rotation:  ~18 cycles per call (one table lookup and an accumulator update)
+ * Both are below 0.05 % of the CPU at 1 kHz.
+ *
+ * @param state The current state of the PMOD ENC module pins.
+ * @param last_state The previous state of the PMOD ENC module pins.
+ *
+ * @return Returns "1" for one detent clockwise, -1 for one detent counter-clockwise, and 0 otherwise.
+ */
+int PMOD_ENC_Decode_Rotation(uint8_t state, uint8_t last_state);
+
+/**
+ * @brief Sets the number of valid quadrature transitions reported as one step.
+ *
+ * A value of 4 reports one step per full A/B cycle (one detent of the PMOD ENC module).
+ * A value of 1 reports every transition (4x resolution). The value is limited to 1 - 4.
+ *
+ * @param transitions_per_step The number of transitions per step.
+ *
+ * @return None
+ */
+void PMOD_ENC_Set_Detent_Scale(uint8_t transitions_per_step);
+
+/**
+ * @brief Returns the number of illegal transitions rejected by PMOD_ENC_Decode_Rotation.
+ *
+ * @param None
+ *
+ * @return The number of illegal transitions since power-up.
+ */
+uint32_t PMOD_ENC_Get_Error_Count(void);
+
 /**
  * @brief Reads the button state of the PMOD ENC module.
  *
@@ -1,87 +1,115 @@
 /**
  * @file PWM_PF1.c
  *
- * @brief Software PWM driver for PF1 LED.
+ * @brief Heartbeat waveform generator for the PF1 LED.
  *
- * This driver generates a PWM signal on PF1 using SysTick delays.
- * Duty cycle can be updated at runtime to change LED brightness.
+ * This driver plays a "lub-dub" heartbeat envelope on PF1. The envelope is stored in a
+ * gamma-corrected lookup table that is computed by the compiler from integer constant
+ * expressions, so no floating point or table generation is needed at runtime.
+ *
+ * Timer 0B advances a 16-bit phase accumulator every 1 ms, from a handler that is bound to its
+ * vector at compile time (HAL_BIND_TIMER_0B, HAL.h) and runs from SRAM (Interrupts.h). The beat rate (phase step) and the amplitude follow
+ * the hunger level: a well-fed pet has a slow, strong heartbeat and a hungry pet has a fast,
+ * weak heartbeat. The resulting brightness is sent to the
+ * BCM_LED driver, which must be initialized with the PF1 channel (BCM_LED_MASK_RED).
  *
  * @author Anna Bagdishyan and Mario Perez
  */
 
 #include "TM4C123GH6PM.h"
-#include "SysTick_Delay.h"
+#include "Interrupts.h"
+#include "HAL.h"
 #include "Timer_0B_Interrupt.h"
+#include "BCM_LED.h"
+#include "PWM_PF1.h"
 
-// PF1 PWM configuration
-static uint8_t PF1_Duty_Cycle = 50;  // default 50%
-static uint16_t PF1_Period_ms = 20;  // 20 ms period
-static uint8_t PWM_Counter = 0;
+// Parabolic pulse centered at sample c with a half-width of w samples and a peak of p
+#define HEARTBEAT_PULSE(i, c, w, p) \
+	((((i) - (c)) * ((i) - (c)) < (w) * (w)) ? ((p) * ((w) * (w) - ((i) - (c)) * ((i) - (c))) / ((w) * (w))) : 0)
 
-// update duty cycle
-void PF1_PWM_Update_Duty_Cycle(uint8_t led_state)
+// Linear "lub-dub" envelope: a strong first pulse followed by a weaker second pulse
+#define HEARTBEAT_ENVELOPE(i) (HEARTBEAT_PULSE(i, 6, 6, 255) + HEARTBEAT_PULSE(i, 20, 5, 170))
+
+#define HEARTBEAT_SAMPLE(i) HEARTBEAT_GAMMA(HEARTBEAT_ENVELOPE(i))
+#define HEARTBEAT_ROW(i) \
+	HEARTBEAT_SAMPLE(i),     HEARTBEAT_SAMPLE(i + 1), HEARTBEAT_SAMPLE(i + 2), HEARTBEAT_SAMPLE(i + 3), \
+	HEARTBEAT_SAMPLE(i + 4), HEARTBEAT_SAMPLE(i + 5), HEARTBEAT_SAMPLE(i + 6), HEARTBEAT_SAMPLE(i + 7)
+
+// Gamma-corrected heartbeat envelope, one entry per 1/64 of a beat
+static const uint8_t heartbeat_table[HEARTBEAT_TABLE_SIZE] =
+{
+	HEARTBEAT_ROW(0),  HEARTBEAT_ROW(8),  HEARTBEAT_ROW(16), HEARTBEAT_ROW(24),
+	HEARTBEAT_ROW(32), HEARTBEAT_ROW(40), HEARTBEAT_ROW(48), HEARTBEAT_ROW(56)
+};
+
+// Number of set bits in a 4-bit hunger LED state
+static const uint8_t lit_led_count[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+// Default curve: a well-fed pet beats at 60 bpm and a starving pet at 150 bpm
+static const Heartbeat_Curve heartbeat_default_curve =
 {
-  uint8_t count = 0;
-	if (led_state & 0x01) {
-		count++;
-	}
-	if (led_state & 0x02) {
-		count++;
-	}
-	if (led_state & 0x04) {
-		count++;
-	}
-	if (led_state & 0x08) {
-		count++;
-	}
-	
-	switch(count)
 	{
-		case 4:
-			PF1_Duty_Cycle = 100;
-			break;
-		case 3:
-			PF1_Duty_Cycle = 50;
-			break;
-		case 2:
-			PF1_Duty_Cycle = 25;
-			break;
-		case 1:
-			PF1_Duty_Cycle = 10;
-			break;
-		default:
-			PF1_Duty_Cycle = 0;
-			break;
+		0,
+		HEARTBEAT_PHASE_STEP(150),
+		HEARTBEAT_PHASE_STEP(110),
+		HEARTBEAT_PHASE_STEP(85),
+		HEARTBEAT_PHASE_STEP(60)
+	},
+	{
+		0,
+		HEARTBEAT_GAMMA(96),
+		HEARTBEAT_GAMMA(160),
+		HEARTBEAT_GAMMA(208),
+		HEARTBEAT_GAMMA(255)
 	}
+};
+
+// Curve used by PF1_PWM_Update_Duty_Cycle
+static const Heartbeat_Curve *heartbeat_curve = &heartbeat_default_curve;
+
+// Heartbeat state updated by the Timer 0B handler
+static volatile uint16_t Heartbeat_Phase = 0;
+static volatile uint16_t Heartbeat_Phase_Step = 0;
+static volatile uint8_t Heartbeat_Amplitude = 0;
+
+// update beat rate and amplitude
+void PF1_PWM_Update_Duty_Cycle(uint8_t led_state)
+{
+	uint8_t count = lit_led_count[led_state & 0x0F];
+
+	Heartbeat_Phase_Step = heartbeat_curve->phase_step[count];
+	Heartbeat_Amplitude = heartbeat_curve->amplitude[count];
 }
 
-void PF1_PWM_Timer_Handler(void) 
+void PF1_PWM_Set_Curve(const Heartbeat_Curve *curve)
 {
-	if (PWM_Counter < ((PF1_Period_ms * PF1_Duty_Cycle) / 100))
+	if (curve == 0)
 	{
-		GPIOF->DATA |= 0x02;
+		curve = &heartbeat_default_curve;
 	}
-	else
-	{
-		GPIOF->DATA &= ~0x02;
-	}
-	PWM_Counter++;
+	heartbeat_curve = curve;
+}
+
+INTERRUPTS_RAMFUNC void PF1_PWM_Timer_Handler(void)
+{
+	HAL_Timer_Clear(HAL_TIMER_0B);
 	
-	if (PWM_Counter >= PF1_Period_ms)
-	{
-		PWM_Counter = 0;
-	}
+	// advance the phase and look up the envelope sample for the current position in the beat
+	Heartbeat_Phase = Heartbeat_Phase + Heartbeat_Phase_Step;
+	uint8_t sample = heartbeat_table[Heartbeat_Phase >> (16 - HEARTBEAT_TABLE_BITS)];
+
+	BCM_LED_Set_Level(BCM_LED_CHANNEL_PF1, (uint8_t)((sample * Heartbeat_Amplitude) >> 8));
 }
 
+#if HAL_BIND_TIMER_0B
+HAL_BIND(TIMER0B_Handler, PF1_PWM_Timer_Handler);
+#endif
+
 void PF1_PWM_Init(void)
 {
-    // enable clock to Port F
-    SYSCTL->RCGCGPIO |= 0x20;
+	Heartbeat_Phase = 0;
+	Heartbeat_Phase_Step = 0;
+	Heartbeat_Amplitude = 0;
 
-    // set PF1 as output
-    GPIOF->DIR |= 0x02;
-    // enable digital functionality
-    GPIOF->DEN |= 0x02;
-	
-   Timer_0B_Interrupt_Init(&PF1_PWM_Timer_Handler);
-}
\ No newline at end of file
+	Timer_0B_Interrupt_Init(&PF1_PWM_Timer_Handler);
+}
@@ -1,26 +1,63 @@
 /**
- * @file PWM_PF1.c
+ * @file PWM_PF1.h
  *
  * @brief Header file for the PWM_PF1 driver
  *
+ * The PF1 LED shows a "lub-dub" heartbeat played from a gamma-corrected lookup table.
+ * The beat rate and amplitude follow the hunger LED state through a heartbeat curve,
+ * which can be selected per difficulty level.
+ *
  * @author Anna Bagdishyan and Mario Perez
  */
- 
+
 #include "TM4C123GH6PM.h"
 
+// The heartbeat table has 2^HEARTBEAT_TABLE_BITS samples per beat
+#define HEARTBEAT_TABLE_BITS 6
+#define HEARTBEAT_TABLE_SIZE (1 << HEARTBEAT_TABLE_BITS)
+
+// Gamma correction (gamma ~2.2) approximated by (0.75 * x^2 + 0.25 * x^3) on a 0 to 255 scale
+#define HEARTBEAT_GAMMA(x) ((3 * 255 * (x) * (x) + (x) * (x) * (x)) / (4 * 255 * 255))
+
+// Phase step per 1 ms tick for a 16-bit phase accumulator at the given beats per minute
+#define HEARTBEAT_PHASE_STEP(bpm) ((uint16_t)((65536UL * (bpm)) / 60000UL))
+
+// Beat rate and gamma-corrected amplitude indexed by the number of lit hunger LEDs (0 - 4).
+// Both can be computed at compile time with HEARTBEAT_PHASE_STEP and HEARTBEAT_GAMMA.
+typedef struct Heartbeat_Curve
+{
+	uint16_t phase_step[5];
+	uint8_t amplitude[5];
+} Heartbeat_Curve;
+
 /**
-* @brief Initializes PF1 for software PWM using Timer 0B
+* @brief Initializes the heartbeat generator on PF1 using Timer 0B
+*
+* The PF1 LED is driven by the BCM_LED driver, so BCM_LED_Init must be called
+* with BCM_LED_MASK_RED before this function.
 */
 void PF1_PWM_Init(void);
 
 /**
-* @brief Updates the duty cycle based on the current hunger LED state*
+* @brief Updates the beat rate and amplitude based on the current hunger LED state
 *
 * @param led_state (PB0-PB3)
 */
 void PF1_PWM_Update_Duty_Cycle(uint8_t led_state);
 
 /**
-* @brief Timer interrupt handler used for generated PWM
+* @brief Selects the heartbeat curve used by PF1_PWM_Update_Duty_Cycle
+*
+* The new curve takes effect at the next call to PF1_PWM_Update_Duty_Cycle.
+*
+* @param curve A pointer to the heartbeat curve, or 0 to select the default curve (60 to 150 bpm)
+*/
+void PF1_PWM_Set_Curve(const Heartbeat_Curve *curve);
+
+/**
+* @brief Timer interrupt handler that advances the heartbeat phase every 1 ms
+*
+* It runs straight from the Timer 0B vector (HAL_BIND_TIMER_0B, HAL.h) and clears the Timer 0B
+* interrupt itself.
 */
-void PF1_PWM_Timer_Handler(void);
\ No newline at end of file
+void PF1_PWM_Timer_Handler(void);
\ No newline at end of file
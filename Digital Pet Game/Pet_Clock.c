@@ -0,0 +1,64 @@
+/**
+ * @file Pet_Clock.c
+ *
+ * @brief Source code for the pet clock.
+ *
+ * This file contains the function definitions for the pet clock. The RTC count is split into whole
+ * days and the time of day: every whole day adds PET_CLOCK_DAY_MS, and the time of day is made of
+ * the morning and the evening at the night speed and the day between them at full speed.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Pet_Clock.h"
+#include "RTC.h"
+
+#define PET_CLOCK_NIGHT_START_MS  (PET_CLOCK_NIGHT_START_S * 1000UL)
+#define PET_CLOCK_NIGHT_END_MS    (PET_CLOCK_NIGHT_END_S * 1000UL)
+
+// Two decimal digits of __TIME__ ("hh:mm:ss")
+#define BUILD_DIGITS(index) ((uint32_t)(__TIME__[index] - '0') * 10 + (uint32_t)(__TIME__[(index) + 1] - '0'))
+#define BUILD_TIME_OF_DAY_S (BUILD_DIGITS(0) * 3600 + BUILD_DIGITS(3) * 60 + BUILD_DIGITS(6))
+
+// Returns the pet clock since midnight for a time of day, from 0 to PET_CLOCK_DAY_MS
+static uint32_t Pet_Clock_Time_Of_Day(uint32_t time_ms)
+{
+	uint32_t morning_ms = (time_ms < PET_CLOCK_NIGHT_END_MS) ? time_ms : PET_CLOCK_NIGHT_END_MS;
+	uint32_t evening_ms = (time_ms > PET_CLOCK_NIGHT_START_MS) ? (time_ms - PET_CLOCK_NIGHT_START_MS) : 0;
+	uint32_t day_ms = time_ms - morning_ms - evening_ms;
+	
+	return ((morning_ms + evening_ms) >> PET_CLOCK_NIGHT_SHIFT) + day_ms;
+}
+
+uint8_t Pet_Clock_Init(void)
+{
+	return RTC_Init(BUILD_TIME_OF_DAY_S);
+}
+
+uint32_t Pet_Clock_From_RTC(uint32_t seconds, uint32_t subseconds)
+{
+	uint32_t days = seconds / 86400;
+	uint32_t time_ms = (seconds % 86400) * 1000 + ((subseconds * 1000) / RTC_SUBSECONDS_PER_SECOND);
+	
+	// The product wraps around like the pet clock itself
+	return days * PET_CLOCK_DAY_MS + Pet_Clock_Time_Of_Day(time_ms);
+}
+
+uint32_t Pet_Clock_Get_Ms(void)
+{
+	uint32_t seconds;
+	uint32_t subseconds;
+	
+	RTC_Read(&seconds, &subseconds);
+	return Pet_Clock_From_RTC(seconds, subseconds);
+}
+
+uint8_t Pet_Clock_Is_Night(void)
+{
+	uint32_t seconds;
+	uint32_t subseconds;
+	
+	RTC_Read(&seconds, &subseconds);
+	seconds = seconds % 86400;
+	return (seconds >= PET_CLOCK_NIGHT_START_S || seconds < PET_CLOCK_NIGHT_END_S) ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file Pet_Clock.h
+ *
+ * @brief Header file for the pet clock.
+ *
+ * The pet clock is the time of the pet simulation (Pet_Sim.h), in milliseconds. It is derived from
+ * the RTC of the Hibernation module (RTC.h), so it keeps running while the board is off and is
+ * never stored: after a reset, the time the board was off is the difference between the pet clock
+ * now and the pet clock saved with the game.
+ *
+ * The pet sleeps at night: from PET_CLOCK_NIGHT_START_S to PET_CLOCK_NIGHT_END_S, the pet clock
+ * runs 2^PET_CLOCK_NIGHT_SHIFT times slower, so the pet gets hungry and the survival time counts
+ * down more slowly. The pet clock is a closed-form function of the RTC count, so a week off the
+ * board takes the same time to compute as a millisecond.
+ *
+ * The RTC is set to the build time of day when it has to be started, so the day and night of the
+ * pet follow the local time until VBAT is removed.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+// Time of day at which the pet falls asleep and wakes up, in seconds since midnight
+#define PET_CLOCK_NIGHT_START_S   (22 * 3600)
+#define PET_CLOCK_NIGHT_END_S     (7 * 3600)
+
+// The pet clock runs 2^PET_CLOCK_NIGHT_SHIFT times slower at night
+#define PET_CLOCK_NIGHT_SHIFT     2
+
+// Pet clock milliseconds in one day: the night at the reduced speed and the day at full speed
+#define PET_CLOCK_DAY_MS \
+	(((PET_CLOCK_NIGHT_END_S + 86400UL - PET_CLOCK_NIGHT_START_S) * 1000UL >> PET_CLOCK_NIGHT_SHIFT) + \
+	(PET_CLOCK_NIGHT_START_S - PET_CLOCK_NIGHT_END_S) * 1000UL)
+
+/**
+ * @brief Starts the RTC at the build time of day if it was not already running.
+ *
+ * @param None
+ *
+ * @return 1 if the RTC kept running while the board was off, so the time since a saved game is
+ * known, or 0 if it was started now.
+ */
+uint8_t Pet_Clock_Init(void);
+
+/**
+ * @brief Returns the pet clock now.
+ *
+ * @param None
+ *
+ * @return The pet clock in milliseconds. It wraps around after about 49 pet days, and differences
+ * are taken with unsigned arithmetic like the other timestamps.
+ */
+uint32_t Pet_Clock_Get_Ms(void);
+
+/**
+ * @brief Checks if the pet is asleep.
+ *
+ * @param None
+ *
+ * @return 1 at night, 0 during the day.
+ */
+uint8_t Pet_Clock_Is_Night(void);
+
+/**
+ * @brief Converts an RTC count to the pet clock.
+ *
+ * @param seconds The RTC count in seconds.
+ * @param subseconds The RTC count in 1/32768 seconds within the second.
+ *
+ * @return The pet clock in milliseconds.
+ */
+uint32_t Pet_Clock_From_RTC(uint32_t seconds, uint32_t subseconds);
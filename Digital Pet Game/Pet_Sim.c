@@ -0,0 +1,228 @@
+/**
+ * @file Pet_Sim.c
+ *
+ * @brief Source code for the pet simulation engine.
+ *
+ * This file contains the function definitions for the structure-of-arrays pet simulation.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Pet_Sim.h"
+#include "Pet_Stats.h"
+
+// Starting stats and the limits kept by every stats tick (the pet always keeps some energy)
+#define PET_SIM_STATS_START     PET_STATS_PACK(PET_STAT_MAX, 192, 192, 192)
+#define PET_SIM_STATS_FLOOR     PET_STATS_PACK(0, 0, 16, 0)
+#define PET_SIM_STATS_CEILING   PET_STATS_PACK(PET_STAT_MAX, PET_STAT_MAX, PET_STAT_MAX, PET_STAT_MAX)
+
+// Stats changed by the actions:
+//  - feed: eating is messy, so hygiene drops
+//  - play: happiness rises and energy drops
+//  - wash: hygiene rises and happiness drops
+#define PET_SIM_FEED_COST       PET_STATS_PACK(0, 0, 0, 8)
+#define PET_SIM_PLAY_GAIN       PET_STATS_PACK(0, 64, 0, 0)
+#define PET_SIM_PLAY_COST       PET_STATS_PACK(0, 0, 32, 0)
+#define PET_SIM_WASH_GAIN       PET_STATS_PACK(0, 0, 0, 128)
+#define PET_SIM_WASH_COST       PET_STATS_PACK(0, 16, 0, 0)
+
+void Pet_Sim_Init(Pet_Sim_Type *sim, uint32_t count, Hunger_Type *hunger, uint32_t *words, uint8_t *status)
+{
+	sim->count = count;
+	sim->hunger = hunger;
+	
+	// Each hot array is a contiguous block of count words
+	sim->empty_ms = words;
+	sim->survive_ms = words + count;
+	sim->stats = words + 2 * count;
+	sim->stats_decay = words + 3 * count;
+	sim->stats_tick_ms = words + 4 * count;
+	sim->status = status;
+	
+	for (uint32_t pet = 0; pet < count; pet++)
+	{
+		sim->status[pet] = PET_SIM_IDLE;
+	}
+}
+
+void Pet_Sim_Start(Pet_Sim_Type *sim, uint32_t pet, uint32_t decay_ms, uint32_t survival_ms, uint32_t stats_decay, uint32_t now_ms)
+{
+	Hunger_Init(&sim->hunger[pet], decay_ms, now_ms);
+	
+	sim->empty_ms[pet] = now_ms + Hunger_Get_Time_Left(&sim->hunger[pet], now_ms);
+	sim->survive_ms[pet] = now_ms + survival_ms;
+	sim->stats[pet] = PET_SIM_STATS_START;
+	sim->stats_decay[pet] = stats_decay;
+	sim->stats_tick_ms[pet] = now_ms;
+	sim->status[pet] = PET_SIM_PLAYING;
+}
+
+uint32_t Pet_Sim_Step(Pet_Sim_Type *sim, uint32_t now_ms)
+{
+	uint32_t count = sim->count;
+	uint32_t *stats = sim->stats;
+	const uint32_t *stats_decay = sim->stats_decay;
+	uint32_t *stats_tick_ms = sim->stats_tick_ms;
+	const uint32_t *empty_ms = sim->empty_ms;
+	const uint32_t *survive_ms = sim->survive_ms;
+	uint8_t *status = sim->status;
+	
+	// Apply every stats tick that is due at once. The stats only decay between their limits, so
+	// n ticks are one update with n times the decay, and a step after a long time off costs the
+	// same as any other step.
+	for (uint32_t pet = 0; pet < count; pet++)
+	{
+		uint32_t ticks = (now_ms - stats_tick_ms[pet]) / PET_SIM_STATS_TICK_MS;
+		ticks = (status[pet] == PET_SIM_PLAYING) ? ticks : 0;
+		uint32_t updated = Pet_Stats_Update(stats[pet], Pet_Stats_Scale(stats_decay[pet], ticks), 0, PET_SIM_STATS_FLOOR, PET_SIM_STATS_CEILING);
+		
+		stats[pet] = (ticks != 0) ? updated : stats[pet];
+		stats_tick_ms[pet] += ticks * PET_SIM_STATS_TICK_MS;
+	}
+	
+	// A pet loses once its hunger bar is empty, unless it had already survived when the bar
+	// emptied (both can pass in one step after a long time off), otherwise it wins once it has survived
+	uint32_t playing_count = 0;
+	for (uint32_t pet = 0; pet < count; pet++)
+	{
+		uint8_t lost = ((int32_t)(now_ms - empty_ms[pet]) >= 0) & ((int32_t)(empty_ms[pet] - survive_ms[pet]) <= 0);
+		uint8_t won = (int32_t)(now_ms - survive_ms[pet]) >= 0;
+		uint8_t next = lost ? PET_SIM_LOST : (won ? PET_SIM_WON : PET_SIM_PLAYING);
+		
+		status[pet] = (status[pet] == PET_SIM_PLAYING) ? next : status[pet];
+		playing_count += (status[pet] == PET_SIM_PLAYING);
+	}
+	
+	return playing_count;
+}
+
+uint8_t Pet_Sim_Feed(Pet_Sim_Type *sim, uint32_t pet, uint32_t amount_q16, uint32_t now_ms)
+{
+	Hunger_Type *hunger = &sim->hunger[pet];
+	
+	// Feeding is only allowed while at least part of a hunger LED is left
+	if (sim->status[pet] != PET_SIM_PLAYING || Hunger_Get(hunger, now_ms) == 0)
+	{
+		return 0;
+	}
+	
+	Hunger_Add(hunger, amount_q16, now_ms);
+	sim->empty_ms[pet] = now_ms + Hunger_Get_Time_Left(hunger, now_ms);
+	sim->stats[pet] = Pet_Stats_Sub(sim->stats[pet], PET_SIM_FEED_COST);
+	
+	return 1;
+}
+
+void Pet_Sim_Play(Pet_Sim_Type *sim, uint32_t pet)
+{
+	if (sim->status[pet] == PET_SIM_PLAYING)
+	{
+		sim->stats[pet] = Pet_Stats_Sub(Pet_Stats_Add(sim->stats[pet], PET_SIM_PLAY_GAIN), PET_SIM_PLAY_COST);
+	}
+}
+
+void Pet_Sim_Wash(Pet_Sim_Type *sim, uint32_t pet)
+{
+	if (sim->status[pet] == PET_SIM_PLAYING)
+	{
+		sim->stats[pet] = Pet_Stats_Sub(Pet_Stats_Add(sim->stats[pet], PET_SIM_WASH_GAIN), PET_SIM_WASH_COST);
+	}
+}
+
+void Pet_Sim_Pause(Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms)
+{
+	if (sim->status[pet] == PET_SIM_PLAYING)
+	{
+		// The hunger model keeps the time of the pause as its last update
+		Hunger_Pause(&sim->hunger[pet], now_ms);
+		sim->status[pet] = PET_SIM_PAUSED;
+	}
+}
+
+void Pet_Sim_Resume(Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms)
+{
+	if (sim->status[pet] == PET_SIM_PAUSED)
+	{
+		Hunger_Type *hunger = &sim->hunger[pet];
+		uint32_t paused_ms = now_ms - hunger->last_update_ms;
+		
+		// Every deadline moves by the time spent paused
+		Hunger_Resume(hunger, now_ms);
+		sim->empty_ms[pet] = now_ms + Hunger_Get_Time_Left(hunger, now_ms);
+		sim->survive_ms[pet] += paused_ms;
+		sim->stats_tick_ms[pet] += paused_ms;
+		sim->status[pet] = PET_SIM_PLAYING;
+	}
+}
+
+void Pet_Sim_Stop(Pet_Sim_Type *sim, uint32_t pet)
+{
+	sim->status[pet] = PET_SIM_IDLE;
+}
+
+// Returns the time at which the deadlines of a pet stopped, or now if it is not paused
+static uint32_t Pet_Sim_Clock(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms)
+{
+	return (sim->status[pet] == PET_SIM_PAUSED) ? sim->hunger[pet].last_update_ms : now_ms;
+}
+
+uint8_t Pet_Sim_Get_Status(const Pet_Sim_Type *sim, uint32_t pet)
+{
+	return sim->status[pet];
+}
+
+uint32_t Pet_Sim_Get_Hunger(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms)
+{
+	return Hunger_Get(&sim->hunger[pet], now_ms);
+}
+
+uint32_t Pet_Sim_Get_Hunger_Time_Left(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms)
+{
+	now_ms = Pet_Sim_Clock(sim, pet, now_ms);
+	int32_t time_left_ms = (int32_t)(sim->empty_ms[pet] - now_ms);
+	
+	return (time_left_ms > 0) ? (uint32_t)time_left_ms : 0;
+}
+
+uint32_t Pet_Sim_Get_Survival_Time_Left(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms)
+{
+	now_ms = Pet_Sim_Clock(sim, pet, now_ms);
+	int32_t time_left_ms = (int32_t)(sim->survive_ms[pet] - now_ms);
+	
+	return (time_left_ms > 0) ? (uint32_t)time_left_ms : 0;
+}
+
+uint32_t Pet_Sim_Get_Stats(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms)
+{
+	// HUNGER_FULL is 4.0 in Q16 (2^18), so this scales the hunger level to 0 - 255
+	uint32_t hunger_stat = (Hunger_Get(&sim->hunger[pet], now_ms) * PET_STAT_MAX) >> 18;
+	
+	return Pet_Stats_Set(sim->stats[pet], PET_STAT_HUNGER, (uint8_t)hunger_stat);
+}
+
+void Pet_Sim_Save(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms, Pet_Sim_Snapshot *snapshot)
+{
+	const Hunger_Type *hunger = &sim->hunger[pet];
+	
+	snapshot->hunger_q16 = Hunger_Get(hunger, now_ms);
+	snapshot->decay_ms = hunger->decay_ms;
+	snapshot->survival_left_ms = Pet_Sim_Get_Survival_Time_Left(sim, pet, now_ms);
+	snapshot->stats = sim->stats[pet];
+	snapshot->stats_decay = sim->stats_decay[pet];
+	snapshot->stats_tick_elapsed_ms = Pet_Sim_Clock(sim, pet, now_ms) - sim->stats_tick_ms[pet];
+}
+
+void Pet_Sim_Load(Pet_Sim_Type *sim, uint32_t pet, const Pet_Sim_Snapshot *snapshot, uint32_t now_ms)
+{
+	Hunger_Type *hunger = &sim->hunger[pet];
+	
+	Hunger_Init(hunger, snapshot->decay_ms, now_ms);
+	hunger->level_q16 = snapshot->hunger_q16;
+	
+	sim->empty_ms[pet] = now_ms + Hunger_Get_Time_Left(hunger, now_ms);
+	sim->survive_ms[pet] = now_ms + snapshot->survival_left_ms;
+	sim->stats[pet] = snapshot->stats;
+	sim->stats_decay[pet] = snapshot->stats_decay;
+	sim->stats_tick_ms[pet] = now_ms - snapshot->stats_tick_elapsed_ms;
+	sim->status[pet] = PET_SIM_PLAYING;
+}
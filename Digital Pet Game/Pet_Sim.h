@@ -0,0 +1,262 @@
+/**
+ * @file Pet_Sim.h
+ *
+ * @brief Header file for the pet simulation engine.
+ *
+ * This engine holds the game state of N pets in structure-of-arrays form and advances all
+ * of them with one call to Pet_Sim_Step. The firmware uses it with N = 1 and the host tools
+ * use it with millions of pets, so both run exactly the same game rules:
+ *  - Hunger follows the closed-form Q16 model in Hunger.h. The time at which the hunger bar
+ *    empties is computed whenever the pet is fed, so the lose check is a single comparison.
+ *  - The pet wins once it has survived for the survival time of its level.
+ *  - Happiness, energy and hygiene (Pet_Stats.h) decay once every PET_SIM_STATS_TICK_MS.
+ *    The ticks that are due are applied at once, so a step after hours off the board costs
+ *    the same as any other step.
+ *  - Feeding, playing and washing change the hunger model and the stats.
+ *  - A paused pet keeps its hunger level, stats and survival time left until it is resumed.
+ *  - The game of a pet can be saved as a snapshot that does not depend on the clock, and
+ *    loaded again after a reset.
+ *
+ * The per-pet data is split into hot arrays, which Pet_Sim_Step reads on every call, and the
+ * cold hunger models, which are only touched when a pet is fed or its hunger level is read.
+ * Pet_Sim_Step only uses comparisons, masks and packed stat updates on the hot arrays, so its
+ * loops can be vectorized by the compiler.
+ *
+ * The caller provides the storage, so the engine never allocates memory:
+ *  - hunger: an array of count Hunger_Type models
+ *  - words: an array of (count * PET_SIM_WORDS_PER_PET) words for the hot arrays
+ *  - status: an array of count bytes
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Hunger.h"
+
+// Time between two pet stats ticks
+#define PET_SIM_STATS_TICK_MS   1000
+
+// Number of 32-bit words of hot data per pet
+#define PET_SIM_WORDS_PER_PET   5
+
+// Pet status values
+#define PET_SIM_IDLE            0
+#define PET_SIM_PLAYING         1
+#define PET_SIM_WON             2
+#define PET_SIM_LOST            3
+#define PET_SIM_PAUSED          4
+
+typedef struct
+{
+	uint32_t count;
+	
+	// Cold data: the hunger model of each pet
+	Hunger_Type *hunger;
+	
+	// Hot data: times at which the hunger bar empties and at which the pet has survived
+	uint32_t *empty_ms;
+	uint32_t *survive_ms;
+	
+	// Hot data: packed stats, their decay per tick and the time of the last tick
+	uint32_t *stats;
+	uint32_t *stats_decay;
+	uint32_t *stats_tick_ms;
+	
+	// Hot data: PET_SIM_IDLE, PET_SIM_PLAYING, PET_SIM_WON or PET_SIM_LOST
+	uint8_t *status;
+} Pet_Sim_Type;
+
+// Game of one pet with every deadline stored as a time left, so it can be loaded with another clock
+typedef struct
+{
+	uint32_t hunger_q16;
+	uint32_t decay_ms;
+	uint32_t survival_left_ms;
+	uint32_t stats;
+	uint32_t stats_decay;
+	
+	// Time since the last stats tick
+	uint32_t stats_tick_elapsed_ms;
+} Pet_Sim_Snapshot;
+
+/**
+ * @brief Initializes the engine with caller-provided storage. All pets start idle.
+ *
+ * @param sim A pointer to the engine.
+ * @param count The number of pets.
+ * @param hunger An array of count hunger models.
+ * @param words An array of (count * PET_SIM_WORDS_PER_PET) words.
+ * @param status An array of count bytes.
+ *
+ * @return None
+ */
+void Pet_Sim_Init(Pet_Sim_Type *sim, uint32_t count, Hunger_Type *hunger, uint32_t *words, uint8_t *status);
+
+/**
+ * @brief Starts a new game for one pet with a full hunger bar and the starting stats.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param decay_ms The time in milliseconds for one hunger LED to drain.
+ * @param survival_ms The time in milliseconds that the pet must survive to win.
+ * @param stats_decay The packed stats lost per tick (see PET_STATS_PACK).
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Pet_Sim_Start(Pet_Sim_Type *sim, uint32_t pet, uint32_t decay_ms, uint32_t survival_ms, uint32_t stats_decay, uint32_t now_ms);
+
+/**
+ * @brief Advances every pet to the given time.
+ *
+ * Stat ticks that are due are applied first, then pets whose hunger bar is empty lose and
+ * pets that have survived win. If both deadlines have passed, the earlier one decides, so a long
+ * step gives the same result as many short ones. Pets that are not playing are not changed.
+ *
+ * @param sim A pointer to the engine.
+ * @param now_ms The current time in milliseconds. It must not go backwards.
+ *
+ * @return The number of pets still playing.
+ */
+uint32_t Pet_Sim_Step(Pet_Sim_Type *sim, uint32_t now_ms);
+
+/**
+ * @brief Feeds one pet if it is playing and its hunger bar is not empty.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param amount_q16 The Q16 hunger level to restore (for example, 4 * HUNGER_ONE_LED).
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return 1 if the pet was fed, or 0 if feeding was not allowed.
+ */
+uint8_t Pet_Sim_Feed(Pet_Sim_Type *sim, uint32_t pet, uint32_t amount_q16, uint32_t now_ms);
+
+/**
+ * @brief Plays with one pet if it is playing: happiness rises and energy drops.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ *
+ * @return None
+ */
+void Pet_Sim_Play(Pet_Sim_Type *sim, uint32_t pet);
+
+/**
+ * @brief Washes one pet if it is playing: hygiene rises and happiness drops.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ *
+ * @return None
+ */
+void Pet_Sim_Wash(Pet_Sim_Type *sim, uint32_t pet);
+
+/**
+ * @brief Pauses one pet if it is playing. Pet_Sim_Step does not change a paused pet.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Pet_Sim_Pause(Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms);
+
+/**
+ * @brief Resumes one paused pet. The time spent paused does not count toward any deadline.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Pet_Sim_Resume(Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms);
+
+/**
+ * @brief Ends the game of one pet, whatever its status, and makes it idle.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ *
+ * @return None
+ */
+void Pet_Sim_Stop(Pet_Sim_Type *sim, uint32_t pet);
+
+/**
+ * @brief Returns the status of one pet.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ *
+ * @return PET_SIM_IDLE, PET_SIM_PLAYING, PET_SIM_WON or PET_SIM_LOST.
+ */
+uint8_t Pet_Sim_Get_Status(const Pet_Sim_Type *sim, uint32_t pet);
+
+/**
+ * @brief Returns the hunger level of one pet.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return The Q16 hunger level from 0 to HUNGER_FULL.
+ */
+uint32_t Pet_Sim_Get_Hunger(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms);
+
+/**
+ * @brief Returns the time left until the hunger bar of one pet is empty.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return The time left in milliseconds, or 0 if the hunger bar is empty.
+ */
+uint32_t Pet_Sim_Get_Hunger_Time_Left(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms);
+
+/**
+ * @brief Returns the time left until one pet has survived.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return The time left in milliseconds, or 0 once the survival time has passed.
+ */
+uint32_t Pet_Sim_Get_Survival_Time_Left(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms);
+
+/**
+ * @brief Returns the packed stats of one pet, with the hunger stat taken from its hunger model.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return The packed stats (see Pet_Stats.h).
+ */
+uint32_t Pet_Sim_Get_Stats(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms);
+
+/**
+ * @brief Saves the game of one playing or paused pet. A paused pet is saved as it was when paused.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param now_ms The current time in milliseconds.
+ * @param snapshot A pointer to the snapshot that is filled in.
+ *
+ * @return None
+ */
+void Pet_Sim_Save(const Pet_Sim_Type *sim, uint32_t pet, uint32_t now_ms, Pet_Sim_Snapshot *snapshot);
+
+/**
+ * @brief Continues a saved game for one pet from the given time. The pet is playing.
+ *
+ * @param sim A pointer to the engine.
+ * @param pet The pet index.
+ * @param snapshot A pointer to the saved game.
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Pet_Sim_Load(Pet_Sim_Type *sim, uint32_t pet, const Pet_Sim_Snapshot *snapshot, uint32_t now_ms);
@@ -0,0 +1,106 @@
+/**
+ * @file Pet_Stats.c
+ *
+ * @brief Source code for the packed pet stats.
+ *
+ * This file contains the function definitions for the packed pet stats. The Cortex-M4 SIMD
+ * instructions are used when the compiler reports the DSP extension (__ARM_FEATURE_DSP).
+ * Otherwise, the lanes are computed with portable SIMD-within-a-register arithmetic, which gives
+ * the same results for the host tools but is slower than scalar code.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Pet_Stats.h"
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "TM4C123GH6PM.h"
+#define PET_STATS_USE_DSP 1
+#else
+#define PET_STATS_USE_DSP 0
+#endif
+
+// Bit 7 of every lane
+#define LANE_HIGH_BITS 0x80808080UL
+
+// Expands bit 7 of each lane to the whole lane (0x80 - 0x01 = 0x7F never borrows from the next lane)
+#define LANE_MASK(high_bits) ((high_bits) | ((high_bits) - ((high_bits) >> 7)))
+
+uint8_t Pet_Stats_Get(Pet_Stats stats, uint8_t stat)
+{
+	return (uint8_t)(stats >> ((stat & 0x03) * 8));
+}
+
+Pet_Stats Pet_Stats_Set(Pet_Stats stats, uint8_t stat, uint8_t value)
+{
+	uint32_t shift = (stat & 0x03) * 8;
+	
+	return (stats & ~(0xFFUL << shift)) | ((uint32_t)value << shift);
+}
+
+#if PET_STATS_USE_DSP
+
+Pet_Stats Pet_Stats_Add(Pet_Stats stats, Pet_Stats amount)
+{
+	return __UQADD8(stats, amount);
+}
+
+Pet_Stats Pet_Stats_Sub(Pet_Stats stats, Pet_Stats amount)
+{
+	return __UQSUB8(stats, amount);
+}
+
+#else
+
+// Adds each lane without carrying into the next lane, then sets the lanes that carried out to 255
+Pet_Stats Pet_Stats_Add(Pet_Stats stats, Pet_Stats amount)
+{
+	uint32_t low_sum = (stats & ~LANE_HIGH_BITS) + (amount & ~LANE_HIGH_BITS);
+	uint32_t sum = low_sum ^ ((stats ^ amount) & LANE_HIGH_BITS);
+	uint32_t carry = ((stats & amount) | ((stats | amount) & low_sum)) & LANE_HIGH_BITS;
+	
+	return sum | LANE_MASK(carry);
+}
+
+// Subtracts each lane without borrowing from the next lane, then clears the lanes that borrowed
+Pet_Stats Pet_Stats_Sub(Pet_Stats stats, Pet_Stats amount)
+{
+	uint32_t low_difference = (stats | LANE_HIGH_BITS) - (amount & ~LANE_HIGH_BITS);
+	uint32_t difference = low_difference ^ ((stats ^ ~amount) & LANE_HIGH_BITS);
+	uint32_t borrow = ((~stats & amount) | (~(stats ^ amount) & difference)) & LANE_HIGH_BITS;
+	
+	return difference & ~LANE_MASK(borrow);
+}
+
+#endif
+
+// Multiplies the two lanes held in bits 7 to 0 and 23 to 16. With a factor of at most 255, each
+// product fits in its 16-bit half, and a product above 255 sets every bit of its lane.
+static uint32_t Pet_Stats_Scale_Half(uint32_t lanes, uint32_t factor)
+{
+	uint32_t product = lanes * factor;
+	uint32_t over = (((product >> 8) & 0x00FF00FFUL) + 0x00FF00FFUL) & 0x01000100UL;
+	
+	return (product | ((over >> 8) * 0xFF)) & 0x00FF00FFUL;
+}
+
+// A stat that is not 0 saturates for any factor of 255 or more, so the factor is limited to 255
+Pet_Stats Pet_Stats_Scale(Pet_Stats stats, uint32_t factor)
+{
+	factor = (factor > PET_STAT_MAX) ? PET_STAT_MAX : factor;
+	
+	return Pet_Stats_Scale_Half(stats & 0x00FF00FFUL, factor) | (Pet_Stats_Scale_Half((stats >> 8) & 0x00FF00FFUL, factor) << 8);
+}
+
+// max(x, floor) = x + (floor -sat x) and min(x, ceiling) = x - (x -sat ceiling).
+// Neither the addition nor the subtraction can carry or borrow between lanes.
+Pet_Stats Pet_Stats_Clamp(Pet_Stats stats, Pet_Stats floor, Pet_Stats ceiling)
+{
+	stats = stats + Pet_Stats_Sub(floor, stats);
+	return stats - Pet_Stats_Sub(stats, ceiling);
+}
+
+Pet_Stats Pet_Stats_Update(Pet_Stats stats, Pet_Stats decay, Pet_Stats gain, Pet_Stats floor, Pet_Stats ceiling)
+{
+	return Pet_Stats_Clamp(Pet_Stats_Add(Pet_Stats_Sub(stats, decay), gain), floor, ceiling);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Pet_Stats.h
+ *
+ * @brief Header file for the packed pet stats.
+ *
+ * The pet has four 8-bit stats packed into one 32-bit word, one stat per byte lane:
+ *  - Bits 7 to 0:    Hunger     (255 = full, follows the hunger model in Hunger.h)
+ *  - Bits 15 to 8:   Happiness
+ *  - Bits 23 to 16:  Energy
+ *  - Bits 31 to 24:  Hygiene
+ *
+ * All four stats are updated at once with the Cortex-M4 packed saturating instructions:
+ * UQADD8 and UQSUB8 add and subtract each lane with saturation at 255 and 0. Clamping uses
+ * the same instructions, since max(x, floor) = x + (floor - x saturated at 0) and
+ * min(x, ceiling) = x - (x - ceiling saturated at 0), and neither step can carry between lanes.
+ * A complete update (decay, gain and clamp) is 6 data-processing instructions. This count is
+ * read from the code, not measured: the packed update has not been timed on the Cortex-M4, so
+ * it is not known to be faster there than four scalar stats.
+ *
+ * When the DSP extension is not available (for example, on the host), a portable
+ * implementation of UQADD8 and UQSUB8 produces identical results. It only exists so that the
+ * host tools can check the packed update, and it is not a performance path: on the host it is
+ * several times slower than a scalar struct (Host/Pet_Stats_Bench.c).
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+// Byte lane of each stat
+#define PET_STAT_HUNGER     0
+#define PET_STAT_HAPPINESS  1
+#define PET_STAT_ENERGY     2
+#define PET_STAT_HYGIENE    3
+
+#define PET_STAT_MAX        255
+
+// Packs four 8-bit stats into one 32-bit word
+#define PET_STATS_PACK(hunger, happiness, energy, hygiene) \
+	((uint32_t)(hunger) | ((uint32_t)(happiness) << 8) | ((uint32_t)(energy) << 16) | ((uint32_t)(hygiene) << 24))
+
+typedef uint32_t Pet_Stats;
+
+/**
+ * @brief Returns one stat.
+ *
+ * @param stats The packed stats.
+ * @param stat The stat lane (PET_STAT_HUNGER - PET_STAT_HYGIENE).
+ *
+ * @return The stat value from 0 to 255.
+ */
+uint8_t Pet_Stats_Get(Pet_Stats stats, uint8_t stat);
+
+/**
+ * @brief Replaces one stat.
+ *
+ * @param stats The packed stats.
+ * @param stat The stat lane (PET_STAT_HUNGER - PET_STAT_HYGIENE).
+ * @param value The new stat value from 0 to 255.
+ *
+ * @return The packed stats with the stat replaced.
+ */
+Pet_Stats Pet_Stats_Set(Pet_Stats stats, uint8_t stat, uint8_t value);
+
+/**
+ * @brief Adds two sets of stats lane by lane, saturating at 255 (UQADD8).
+ *
+ * @param stats The packed stats.
+ * @param amount The packed amount to add to each stat.
+ *
+ * @return The packed sums.
+ */
+Pet_Stats Pet_Stats_Add(Pet_Stats stats, Pet_Stats amount);
+
+/**
+ * @brief Subtracts two sets of stats lane by lane, saturating at 0 (UQSUB8).
+ *
+ * @param stats The packed stats.
+ * @param amount The packed amount to subtract from each stat.
+ *
+ * @return The packed differences.
+ */
+Pet_Stats Pet_Stats_Sub(Pet_Stats stats, Pet_Stats amount);
+
+/**
+ * @brief Multiplies each stat by the same factor, saturating at 255.
+ *
+ * This gives the decay of several ticks at once: since each stat only goes down between its
+ * limits, n ticks of decay d are a single Pet_Stats_Update with the decay n * d.
+ *
+ * @param stats The packed stats.
+ * @param factor The factor applied to each stat.
+ *
+ * @return The packed products.
+ */
+Pet_Stats Pet_Stats_Scale(Pet_Stats stats, uint32_t factor);
+
+/**
+ * @brief Clamps each stat between a lower and an upper limit.
+ *
+ * Each stat is raised to its lower limit first and then lowered to its upper limit.
+ *
+ * @param stats The packed stats.
+ * @param floor The packed lower limit of each stat.
+ * @param ceiling The packed upper limit of each stat.
+ *
+ * @return The packed clamped stats.
+ */
+Pet_Stats Pet_Stats_Clamp(Pet_Stats stats, Pet_Stats floor, Pet_Stats ceiling);
+
+/**
+ * @brief Applies one update tick: decay, then gain, then clamp.
+ *
+ * @param stats The packed stats.
+ * @param decay The packed amount lost by each stat per tick.
+ * @param gain The packed amount gained by each stat per tick.
+ * @param floor The packed lower limit of each stat.
+ * @param ceiling The packed upper limit of each stat.
+ *
+ * @return The packed stats after the tick.
+ */
+Pet_Stats Pet_Stats_Update(Pet_Stats stats, Pet_Stats decay, Pet_Stats gain, Pet_Stats floor, Pet_Stats ceiling);
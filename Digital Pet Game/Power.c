@@ -0,0 +1,135 @@
+/**
+ * @file Power.c
+ *
+ * @brief Source code for the clock profiles of the game.
+ *
+ * This file contains the function definitions for the clock profiles. The two 16 MHz sources
+ * make the switches simple: the system runs from the crystal at 16 MHz while the PLL locks,
+ * so the frequency only changes at the single register write that selects the PLL or the
+ * PIOSC, which is done with interrupts disabled together with the timer updates.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Power.h"
+#include "Clock.h"
+#include "Timebase.h"
+
+// Every general-purpose timer of the game counts at 1 MHz in both profiles
+#define POWER_TIMER_TICK_HZ 1000000
+
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_TICK_VALID_AT(CLOCK_SYSTEM_HZ, POWER_TIMER_TICK_HZ), burst_timer_tick);
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_TICK_VALID_AT(CLOCK_PIOSC_HZ, POWER_TIMER_TICK_HZ), idle_timer_tick);
+CLOCK_STATIC_ASSERT((TIMEBASE_UNIT_HZ % CLOCK_PIOSC_HZ) == 0, idle_timebase_units);
+
+static uint8_t current_profile = POWER_PROFILE_BURST;
+
+// Time spent in each profile up to profile_start_us, and number of switches
+static uint64_t profile_time_us[POWER_PROFILE_COUNT];
+static uint32_t profile_start_us = 0;
+static uint32_t switch_count = 0;
+
+// Updates the drivers that count the system clock, right after it has changed to clock_hz
+static void Power_Update_Drivers(uint32_t clock_hz)
+{
+	uint32_t prescale = CLOCK_TIMER_PRESCALE_AT(clock_hz, POWER_TIMER_TICK_HZ);
+	
+	// A timer module can only be accessed while its clock is enabled (R0 to R2 bits of RCGCTIMER)
+	if (SYSCTL->RCGCTIMER & 0x01)
+	{
+		TIMER0->TAPR = prescale;
+		TIMER0->TBPR = prescale;
+	}
+	if (SYSCTL->RCGCTIMER & 0x02)
+	{
+		TIMER1->TAPR = prescale;
+	}
+	if (SYSCTL->RCGCTIMER & 0x04)
+	{
+		TIMER2->TAPR = prescale;
+	}
+	
+	Timebase_Set_Clock(clock_hz);
+}
+
+// Adds the time since the last call to the selected profile
+static void Power_Account(void)
+{
+	uint32_t now_us = Timebase_Get_Us();
+	
+	profile_time_us[current_profile] += now_us - profile_start_us;
+	profile_start_us = now_us;
+}
+
+void Power_Init(void)
+{
+	current_profile = POWER_PROFILE_BURST;
+	profile_time_us[POWER_PROFILE_BURST] = 0;
+	profile_time_us[POWER_PROFILE_IDLE] = 0;
+	profile_start_us = Timebase_Get_Us();
+	switch_count = 0;
+}
+
+void Power_Set_Profile(uint8_t profile)
+{
+	if (profile == current_profile)
+	{
+		return;
+	}
+	
+	Power_Account();
+	
+	if (profile == POWER_PROFILE_BURST)
+	{
+		// The PLL locks with the system at 16 MHz from the crystal, which the timers do not notice
+		Clock_Start_PLL();
+		
+		__disable_irq();
+		Clock_Select_PLL();
+		Power_Update_Drivers(CLOCK_SYSTEM_HZ);
+		__enable_irq();
+	}
+	else
+	{
+		__disable_irq();
+		Clock_Select_PIOSC();
+		Power_Update_Drivers(CLOCK_PIOSC_HZ);
+		__enable_irq();
+	}
+	
+	current_profile = profile;
+	switch_count++;
+}
+
+uint8_t Power_Get_Profile(void)
+{
+	return current_profile;
+}
+
+void Power_Wait_Ms(uint32_t delay_ms, uint8_t profile)
+{
+	uint32_t start_ms = Timebase_Get_Ms();
+	
+	Power_Set_Profile(profile);
+	while ((Timebase_Get_Ms() - start_ms) < delay_ms)
+	{
+		__WFI();
+	}
+	Power_Set_Profile(POWER_PROFILE_BURST);
+}
+
+uint32_t Power_Get_Time_Ms(uint8_t profile)
+{
+	uint64_t time_us = profile_time_us[profile];
+	
+	if (profile == current_profile)
+	{
+		time_us += Timebase_Get_Us() - profile_start_us;
+	}
+	return (uint32_t)(time_us / 1000);
+}
+
+uint32_t Power_Get_Switch_Count(void)
+{
+	return switch_count;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file Power.h
+ *
+ * @brief Header file for the clock profiles of the game.
+ *
+ * The system clock is switched between two profiles:
+ *  - POWER_PROFILE_BURST: the PLL at CLOCK_SYSTEM_HZ, for the work of the main loop
+ *    (LCD updates, animations, input events and saving)
+ *  - POWER_PROFILE_IDLE: the PIOSC at CLOCK_PIOSC_HZ with the PLL powered down, while the
+ *    main loop waits for its next period
+ *
+ * The drivers that count the system clock are updated in the same critical section as the clock
+ * switch, so no interrupt ever runs with a timer counting at the wrong rate:
+ *  - General-purpose Timers 0A, 0B, 1A and 2A, which all count at 1 MHz: their prescalers are
+ *    rewritten. A prescaler takes effect from the next timer tick, so the BCM slot and the heartbeat
+ *    sample in progress are off by at most 1 us, and the PWM heartbeat does not glitch.
+ *  - Timebase (Wide Timer 0): the time counted so far is kept (Timebase_Set_Clock)
+ *
+ * SysTick (PIOSC / 4) and SSI2 (PIOSC) do not depend on the system clock and are not changed. The
+ * survival countdown runs from the pet clock (Pet_Clock.h), so it loses no time either. The PMOD ENC
+ * capture (Wide Timer 2) is not rescaled: its knob velocity is only used in the menu, where the
+ * main loop stays in the burst profile.
+ *
+ * The time spent in each profile and the number of profile switches are counted with the Timebase,
+ * and can be read with Power_Get_Time_Ms and Power_Get_Switch_Count.
+ *
+ * @note Clock_Init and Timebase_Init must be called before Power_Init.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+#define POWER_PROFILE_BURST     0
+#define POWER_PROFILE_IDLE      1
+#define POWER_PROFILE_COUNT     2
+
+/**
+ * @brief Starts counting the time spent in each profile, in the burst profile.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Power_Init(void);
+
+/**
+ * @brief Switches the system clock to a profile and updates the drivers that count it.
+ *
+ * Switching to the burst profile waits for the PLL to lock, while the system keeps running at
+ * 16 MHz from the crystal. Nothing is done if the profile is already selected.
+ *
+ * @param profile POWER_PROFILE_BURST or POWER_PROFILE_IDLE
+ *
+ * @return None
+ */
+void Power_Set_Profile(uint8_t profile);
+
+/**
+ * @brief Returns the selected profile.
+ *
+ * @param None
+ *
+ * @return POWER_PROFILE_BURST or POWER_PROFILE_IDLE
+ */
+uint8_t Power_Get_Profile(void);
+
+/**
+ * @brief Waits in a profile, then returns to the burst profile.
+ *
+ * The CPU sleeps in WFI between interrupts. The 1 ms interrupt of Timer 1A wakes it up at least
+ * once every millisecond, so the wait ends at most 1 ms late.
+ *
+ * @param delay_ms The time to wait in milliseconds.
+ *
+ * @param profile The profile to wait in.
+ *
+ * @return None
+ */
+void Power_Wait_Ms(uint32_t delay_ms, uint8_t profile);
+
+/**
+ * @brief Returns the time spent in a profile since Power_Init was called.
+ *
+ * @param profile POWER_PROFILE_BURST or POWER_PROFILE_IDLE
+ *
+ * @return The time in milliseconds, including the time in the profile selected now.
+ */
+uint32_t Power_Get_Time_Ms(uint8_t profile);
+
+/**
+ * @brief Returns the number of profile switches since Power_Init was called.
+ *
+ * @param None
+ *
+ * @return The number of switches.
+ */
+uint32_t Power_Get_Switch_Count(void);
@@ -0,0 +1,69 @@
+/**
+ * @file RTC.c
+ *
+ * @brief Source code for the Hibernation module real-time clock driver.
+ *
+ * This file contains the function definitions for the RTC driver. The RTC is loaded through RTCLD
+ * and enabled through HIBCTL, with a wait for the WRC bit of HIBCTL before every write.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "RTC.h"
+
+// HIBCTL: RTCEN (Bit 0) enables the RTC, CLK32EN (Bit 6) enables the 32.768 kHz oscillator and
+// WRC (Bit 31) is set when the module is ready for the next register write
+#define HIB_CTL_RTCEN       0x00000001
+#define HIB_CTL_CLK32EN     0x00000040
+#define HIB_CTL_WRC         0x80000000
+
+// HIBRTCSS: RTCSSC (Bits 14 to 0) counts the subseconds
+#define HIB_RTCSS_COUNT     0x7FFF
+
+// Waits until the previous register write has been completed
+static void RTC_Wait_Write(void)
+{
+	while (!(HIB->CTL & HIB_CTL_WRC));
+}
+
+uint8_t RTC_Init(uint32_t seconds)
+{
+	// Enable the clock to the Hibernation module by setting the R0 bit (Bit 0) in the RCGCHIB register
+	SYSCTL->RCGCHIB |= 0x01;
+	
+	// The module needs a few clock cycles after its clock is enabled
+	for (volatile int delay = 0; delay < 6; delay++);
+	
+	// The RTC kept counting from VBAT since it was started
+	if (HIB->CTL & HIB_CTL_RTCEN)
+	{
+		return 1;
+	}
+	
+	// WRC stays clear after the first write until the crystal oscillator is running
+	HIB->CTL = HIB_CTL_CLK32EN;
+	RTC_Wait_Write();
+	HIB->RTCLD = seconds;
+	RTC_Wait_Write();
+	HIB->CTL = HIB_CTL_CLK32EN | HIB_CTL_RTCEN;
+	RTC_Wait_Write();
+	
+	return 0;
+}
+
+void RTC_Read(uint32_t *seconds, uint32_t *subseconds)
+{
+	uint32_t before;
+	uint32_t after;
+	uint32_t count;
+	
+	do
+	{
+		before = HIB->RTCC;
+		count = HIB->RTCSS & HIB_RTCSS_COUNT;
+		after = HIB->RTCC;
+	} while (before != after);
+	
+	*seconds = after;
+	*subseconds = count;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file RTC.h
+ *
+ * @brief Header file for the Hibernation module real-time clock driver.
+ *
+ * The RTC of the Hibernation module counts seconds in RTCC and 1/32768 seconds in RTCSS from the
+ * 32.768 kHz crystal. It is powered from VBAT, so once it is started it keeps counting through
+ * resets, reprogramming and hibernation, and only stops when VBAT is removed.
+ *
+ * Every write to a Hibernation module register takes about three cycles of the 32.768 kHz clock
+ * (about 92 us), and the next register must not be written until the WRC bit of HIBCTL is set.
+ * Reads do not wait.
+ *
+ * @note On the LaunchPad, VBAT is connected to the 3.3 V supply, so the RTC keeps its time through
+ * a reset but not when the board is unplugged. A coin cell on VBAT keeps it running while unplugged.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+// Number of RTCSS counts per second
+#define RTC_SUBSECONDS_PER_SECOND 32768
+
+/**
+ * @brief Enables the Hibernation module and starts the RTC if it is not already running.
+ *
+ * If the RTC was already running, its count is kept. Otherwise, the 32.768 kHz oscillator is
+ * enabled and the RTC starts counting from the given number of seconds. The first register
+ * write waits until the crystal oscillator is running.
+ *
+ * @param seconds The count of the RTC in seconds if it has to be started.
+ *
+ * @return 1 if the RTC was already running and kept its count, or 0 if it was started.
+ */
+uint8_t RTC_Init(uint32_t seconds);
+
+/**
+ * @brief Reads the RTC.
+ *
+ * RTCC is read before and after RTCSS until both reads match, so the seconds and the
+ * subseconds are consistent even if the seconds change between the reads.
+ *
+ * @param seconds A pointer to the count in seconds.
+ * @param subseconds A pointer to the count in 1/32768 seconds within the second (0 - 32767).
+ *
+ * @return None
+ */
+void RTC_Read(uint32_t *seconds, uint32_t *subseconds);
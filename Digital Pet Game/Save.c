@@ -0,0 +1,193 @@
+/**
+ * @file Save.c
+ *
+ * @brief Source code for the saved game records kept in the on-chip EEPROM.
+ *
+ * This file contains the function definitions for the saved game records. The CRC-32 is the
+ * usual reflected 0xEDB88320 polynomial, computed four bits at a time with a 16-entry table.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <string.h>
+
+#include "Save.h"
+
+// Header, sequence number and CRC words of a record
+#define SAVE_OVERHEAD_WORDS 3
+
+static const uint32_t crc_table[16] =
+{
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static uint8_t save_ready = 0;
+static uint32_t save_size = 0;
+static uint32_t record_header = 0;
+static uint32_t record_words = 0;
+
+// Block of the newest record and the sequence number of the next record
+static uint32_t newest_block = SAVE_BLOCK_COUNT - 1;
+static uint32_t next_sequence = 1;
+
+// Last checkpoint, not yet written
+static uint32_t checkpoint[EEPROM_BLOCK_WORDS - SAVE_OVERHEAD_WORDS];
+static uint8_t checkpoint_waiting = 0;
+
+// Record being written and the number of its words written so far
+static uint32_t record[EEPROM_BLOCK_WORDS];
+static uint32_t record_address = 0;
+static uint32_t record_written = 0;
+static uint8_t record_in_progress = 0;
+static uint32_t record_start_ms = 0;
+static uint32_t record_count = 0;
+
+// CRC-32 of the words in little-endian byte order
+static uint32_t Save_CRC(const uint32_t *words, uint32_t count)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	
+	for (uint32_t i = 0; i < count; i++)
+	{
+		crc = crc ^ words[i];
+		for (int nibble = 0; nibble < 8; nibble++)
+		{
+			crc = (crc >> 4) ^ crc_table[crc & 0x0F];
+		}
+	}
+	return ~crc;
+}
+
+uint8_t Save_Init(uint8_t version, uint32_t size)
+{
+	save_size = size;
+	record_words = (size + 3) / 4;
+	record_header = ((uint32_t)SAVE_MAGIC << 16) | ((uint32_t)version << 8) | record_words;
+	save_ready = (size <= SAVE_MAX_SIZE) && EEPROM_Init();
+	
+	newest_block = SAVE_BLOCK_COUNT - 1;
+	next_sequence = 1;
+	checkpoint_waiting = 0;
+	record_in_progress = 0;
+	record_count = 0;
+	
+	return save_ready;
+}
+
+uint8_t Save_Restore(void *payload)
+{
+	uint32_t sequence[SAVE_BLOCK_COUNT];
+	uint32_t words[EEPROM_BLOCK_WORDS];
+	uint32_t candidates = 0;
+	
+	if (!save_ready)
+	{
+		return 0;
+	}
+	
+	// Only the blocks with the header of this format can hold a record (one bit per block)
+	for (uint32_t block = 0; block < SAVE_BLOCK_COUNT; block++)
+	{
+		uint32_t address = (SAVE_FIRST_BLOCK + block) * EEPROM_BLOCK_WORDS;
+		
+		if (EEPROM_Read(address) == record_header)
+		{
+			sequence[block] = EEPROM_Read(address + 1);
+			candidates |= 1UL << block;
+			
+			// The next record must be newer than any record found, even a damaged one
+			if ((int32_t)(sequence[block] - next_sequence) >= 0)
+			{
+				next_sequence = sequence[block] + 1;
+			}
+		}
+	}
+	
+	// Check the newest candidates until one has a valid CRC
+	while (candidates != 0)
+	{
+		uint32_t newest = 0;
+		
+		for (uint32_t block = 0; block < SAVE_BLOCK_COUNT; block++)
+		{
+			if ((candidates & (1UL << block)) && (!(candidates & (1UL << newest)) ||
+				(int32_t)(sequence[block] - sequence[newest]) > 0))
+			{
+				newest = block;
+			}
+		}
+		
+		uint32_t address = (SAVE_FIRST_BLOCK + newest) * EEPROM_BLOCK_WORDS;
+		for (uint32_t i = 0; i < record_words + SAVE_OVERHEAD_WORDS; i++)
+		{
+			words[i] = EEPROM_Read(address + i);
+		}
+		
+		if (Save_CRC(words, record_words + 2) == words[record_words + 2])
+		{
+			memcpy(payload, &words[2], save_size);
+			newest_block = newest;
+			return 1;
+		}
+		candidates &= ~(1UL << newest);
+	}
+	
+	return 0;
+}
+
+void Save_Checkpoint(const void *payload)
+{
+	if (save_ready)
+	{
+		memcpy(checkpoint, payload, save_size);
+		checkpoint_waiting = 1;
+	}
+}
+
+void Save_Task(uint32_t now_ms)
+{
+	if (!save_ready || EEPROM_Is_Busy())
+	{
+		return;
+	}
+	
+	if (!record_in_progress)
+	{
+		if (!checkpoint_waiting || (record_count > 0 && (now_ms - record_start_ms) < SAVE_INTERVAL_MS))
+		{
+			return;
+		}
+		
+		// Build the record of the last checkpoint in the block after the newest record
+		newest_block = (newest_block + 1) % SAVE_BLOCK_COUNT;
+		record_address = (SAVE_FIRST_BLOCK + newest_block) * EEPROM_BLOCK_WORDS;
+		record[0] = record_header;
+		record[1] = next_sequence++;
+		memcpy(&record[2], checkpoint, record_words * 4);
+		record[record_words + 2] = Save_CRC(record, record_words + 2);
+		
+		checkpoint_waiting = 0;
+		record_in_progress = 1;
+		record_written = 0;
+		record_start_ms = now_ms;
+	}
+	
+	// Write the payload and the CRC first, then the header, then the sequence number
+	uint32_t total = record_words + SAVE_OVERHEAD_WORDS;
+	uint32_t offset = (record_written + 2) % total;
+	
+	EEPROM_Write(record_address + offset, record[offset]);
+	record_written++;
+	
+	if (record_written == total)
+	{
+		record_in_progress = 0;
+		record_count++;
+	}
+}
+
+uint32_t Save_Get_Record_Count(void)
+{
+	return record_count;
+}
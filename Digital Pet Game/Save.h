@@ -0,0 +1,90 @@
+/**
+ * @file Save.h
+ *
+ * @brief Header file for the saved game records kept in the on-chip EEPROM.
+ *
+ * The saved game is a caller-defined structure of up to SAVE_MAX_SIZE bytes. Each checkpoint writes
+ * it as a new record in the next EEPROM block, so the records rotate through SAVE_BLOCK_COUNT blocks
+ * and every word is written once per SAVE_BLOCK_COUNT checkpoints. Record format (words):
+ *  - 0: Bits 31 to 16 = SAVE_MAGIC, Bits 15 to 8 = format version, Bits 7 to 0 = payload words
+ *  - 1: Sequence number, which grows by one per record
+ *  - 2 to (n + 1): Payload
+ *  - n + 2: CRC-32 of words 0 to (n + 1)
+ *
+ * Save_Restore reads the header and sequence number of every block, then checks the CRC of the
+ * newest records until one is valid. A restore with a valid newest record reads
+ * 2 * SAVE_BLOCK_COUNT + 10 words, which is far below a millisecond even at a microsecond per read.
+ * A record with another version or size is ignored.
+ *
+ * Save_Checkpoint only copies the structure. Save_Task writes the record one word per call, so a
+ * checkpoint never waits for the EEPROM, and starts a record at most once per SAVE_INTERVAL_MS.
+ * A checkpoint taken while a record is being written replaces any checkpoint still waiting.
+ * The header and sequence number are written last, so a record cut short by a power loss is
+ * never taken for the newest record: its CRC fails and the previous record is restored.
+ *
+ * With a checkpoint every SAVE_INTERVAL_MS, a word is written at most once every
+ * SAVE_BLOCK_COUNT * SAVE_INTERVAL_MS (64 s), which is 500,000 writes in more than a year of play.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "EEPROM.h"
+
+// Blocks used by the records
+#define SAVE_FIRST_BLOCK    0
+#define SAVE_BLOCK_COUNT    32
+
+// Largest saved structure: a block minus the header, the sequence number and the CRC
+#define SAVE_MAX_SIZE       ((EEPROM_BLOCK_WORDS - 3) * 4)
+
+// Minimum time between the start of two records
+#define SAVE_INTERVAL_MS    2000
+
+#define SAVE_MAGIC          0x5045
+
+/**
+ * @brief Enables the EEPROM and sets the format of the saved structure.
+ *
+ * @param version The format version, which must change whenever the structure changes.
+ * @param size The size of the structure in bytes, up to SAVE_MAX_SIZE.
+ *
+ * @return 1 if the EEPROM is ready, or 0 if it failed (the game is then never saved).
+ */
+uint8_t Save_Init(uint8_t version, uint32_t size);
+
+/**
+ * @brief Copies the newest valid record into the structure. Must be called once before Save_Task.
+ *
+ * @param payload The structure that receives the record.
+ *
+ * @return 1 if a record was restored, or 0 if there is no valid record of this version and size.
+ */
+uint8_t Save_Restore(void *payload);
+
+/**
+ * @brief Takes a checkpoint of the structure, which Save_Task writes later.
+ *
+ * @param payload The structure to save.
+ *
+ * @return None
+ */
+void Save_Checkpoint(const void *payload);
+
+/**
+ * @brief Writes the next word of the record in progress, and starts the record of the last
+ * checkpoint when SAVE_INTERVAL_MS has passed since the previous one. Never waits.
+ *
+ * @param now_ms The current time in milliseconds.
+ *
+ * @return None
+ */
+void Save_Task(uint32_t now_ms);
+
+/**
+ * @brief Returns the number of records written since Save_Init.
+ *
+ * @param None
+ *
+ * @return The number of records written.
+ */
+uint32_t Save_Get_Record_Count(void);
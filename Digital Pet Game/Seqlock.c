@@ -0,0 +1,81 @@
+/**
+ * @file Seqlock.c
+ *
+ * @brief Source code for the sequence lock.
+ *
+ * This file contains the function definitions for the sequence lock. The memory barriers
+ * keep the compiler and the processor from moving the accesses to the shared structure
+ * across the accesses to the sequence number.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Seqlock.h"
+
+void Seqlock_Init(Seqlock_Type *lock)
+{
+	lock->sequence = 0;
+	lock->read_count = 0;
+	lock->retry_count = 0;
+}
+
+void Seqlock_Write_Begin(Seqlock_Type *lock)
+{
+	lock->sequence = lock->sequence + 1;
+	__DMB();
+}
+
+void Seqlock_Write_End(Seqlock_Type *lock)
+{
+	__DMB();
+	lock->sequence = lock->sequence + 1;
+}
+
+uint32_t Seqlock_Read_Begin(const Seqlock_Type *lock)
+{
+	uint32_t sequence = lock->sequence;
+
+	__DMB();
+	return sequence;
+}
+
+uint8_t Seqlock_Read_Retry(Seqlock_Type *lock, uint32_t sequence)
+{
+	__DMB();
+
+	// An odd sequence number means that the copy started inside a write
+	if ((sequence & 1) || lock->sequence != sequence)
+	{
+		lock->retry_count++;
+		return 1;
+	}
+
+	lock->read_count++;
+	return 0;
+}
+
+void Seqlock_Read(Seqlock_Type *lock, void *copy, const void *shared, uint32_t size)
+{
+	uint8_t *destination = copy;
+	const uint8_t *source = shared;
+	uint32_t sequence;
+
+	do
+	{
+		sequence = Seqlock_Read_Begin(lock);
+		for (uint32_t i = 0; i < size; i++)
+		{
+			destination[i] = source[i];
+		}
+	} while (Seqlock_Read_Retry(lock, sequence));
+}
+
+uint32_t Seqlock_Get_Read_Count(const Seqlock_Type *lock)
+{
+	return lock->read_count;
+}
+
+uint32_t Seqlock_Get_Retry_Count(const Seqlock_Type *lock)
+{
+	return lock->retry_count;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file Seqlock.h
+ *
+ * @brief Header file for the sequence lock used to share state between an interrupt and the main loop.
+ *
+ * A sequence lock lets an interrupt handler publish a structure that the main loop reads as a
+ * consistent copy, without disabling interrupts on either side:
+ *  - The writer makes the sequence number odd with Seqlock_Write_Begin, updates the fields and
+ *    makes it even again with Seqlock_Write_End.
+ *  - The reader copies the structure between Seqlock_Read_Begin and Seqlock_Read_Retry, and copies
+ *    it again if the sequence number was odd or changed in between, which means that the writer
+ *    interrupted the copy. Seqlock_Read does both steps.
+ *
+ * The writer never waits, so the writer must be the interrupt and the reader the code that it can
+ * interrupt. A reader that interrupts a writer would retry forever. There must be a single writer,
+ * or writers at the same interrupt priority, which cannot interrupt each other.
+ *
+ * Every read and every retry is counted, so the contention caused by the interrupt load can be
+ * read with Seqlock_Get_Read_Count and Seqlock_Get_Retry_Count or with the debugger.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+
+typedef struct
+{
+	// Odd while a write is in progress
+	volatile uint32_t sequence;
+
+	// Number of consistent copies taken and number of copies that had to be taken again
+	uint32_t read_count;
+	uint32_t retry_count;
+} Seqlock_Type;
+
+/**
+ * @brief Initializes a sequence lock with no write in progress and clears its counters.
+ *
+ * @param lock A pointer to the sequence lock.
+ *
+ * @return None
+ */
+void Seqlock_Init(Seqlock_Type *lock);
+
+/**
+ * @brief Starts an update of the shared structure. Called by the writer only.
+ *
+ * @param lock A pointer to the sequence lock.
+ *
+ * @return None
+ */
+void Seqlock_Write_Begin(Seqlock_Type *lock);
+
+/**
+ * @brief Publishes the update of the shared structure. Called by the writer only.
+ *
+ * @param lock A pointer to the sequence lock.
+ *
+ * @return None
+ */
+void Seqlock_Write_End(Seqlock_Type *lock);
+
+/**
+ * @brief Starts a copy of the shared structure.
+ *
+ * @param lock A pointer to the sequence lock.
+ *
+ * @return The sequence number to pass to Seqlock_Read_Retry.
+ */
+uint32_t Seqlock_Read_Begin(const Seqlock_Type *lock);
+
+/**
+ * @brief Checks if a copy started by Seqlock_Read_Begin must be taken again.
+ *
+ * @param lock A pointer to the sequence lock.
+ * @param sequence The sequence number returned by Seqlock_Read_Begin.
+ *
+ * @return 1 if the copy may be torn and must be taken again, 0 if it is consistent.
+ */
+uint8_t Seqlock_Read_Retry(Seqlock_Type *lock, uint32_t sequence);
+
+/**
+ * @brief Copies the shared structure until the copy is consistent.
+ *
+ * @param lock A pointer to the sequence lock.
+ * @param copy The destination of the copy.
+ * @param shared The shared structure.
+ * @param size The size of the shared structure in bytes.
+ *
+ * @return None
+ */
+void Seqlock_Read(Seqlock_Type *lock, void *copy, const void *shared, uint32_t size);
+
+/**
+ * @brief Returns the number of consistent copies taken.
+ *
+ * @param lock A pointer to the sequence lock.
+ *
+ * @return The number of consistent copies.
+ */
+uint32_t Seqlock_Get_Read_Count(const Seqlock_Type *lock);
+
+/**
+ * @brief Returns the number of copies that were interrupted by a write and taken again.
+ *
+ * @param lock A pointer to the sequence lock.
+ *
+ * @return The number of retries.
+ */
+uint32_t Seqlock_Get_Retry_Count(const Seqlock_Type *lock);
@@ -6,12 +6,19 @@
  * This file contains the function definitions for the Seven_Segment_Display driver.
  * It interfaces with the Seven-Segment Display module on the EduBase board.
  *
- * @note Assumes that a 16 MHz clock is used.
+ * @note SSI2 is clocked from the 16 MHz PIOSC, and its divisor is derived in Clock.h.
  *
  * @author Aaron Nanas
  */
  
 #include "Seven_Segment_Display.h"
+#include "Clock.h"
+#include "HAL.h"
+
+// SCLK frequency of SSI2
+#define SEVEN_SEGMENT_SCLK_HZ 1000000
+
+CLOCK_STATIC_ASSERT(CLOCK_SSI_DIVISOR_VALID(CLOCK_PIOSC_HZ, SEVEN_SEGMENT_SCLK_HZ), ssi2_divisor);
 
 // Values used to represent hexadecimal numbers on the Seven-Segment Display module
 const uint8_t number_pattern[16] =
@@ -100,7 +107,7 @@ void Seven_Segment_Display_Init(void)
 	// in the CR0 register can be cleared to 0 to configure the SCLK frequency to 1 MHz
 	// SSInClk = PIOSC Frequency / (CPSDVSR * (1 + SCR))
 	// SSInClk = 16 MHz / (16 * (1 + 0)) = 1 MHz
-	SSI2->CPSR = 16;
+	SSI2->CPSR = CLOCK_SSI_DIVISOR(CLOCK_PIOSC_HZ, SEVEN_SEGMENT_SCLK_HZ);
 	SSI2->CR0 &= ~0xFF00;
 	
 	// Configure the SSI2 module to capture data on the first clock edge transition
@@ -129,20 +136,15 @@ void Seven_Segment_Display_Init(void)
 
 void SSI2_Write(uint8_t data)
 {
-	// Assert the slave select pin by clearing Bit 7
-	// of the DATA register for Port C
-	GPIOC->DATA &= ~0x80;
+	// Assert the slave select pin (PC7)
+	HAL_GPIO_Clear(HAL_PIN_SEVEN_SEGMENT_CS);
 
-	// Write the data to the SSI Data Register (SSIDR)
-	SSI2->DR = data;
+	// Write the data to the SSI Data Register (SSIDR) and wait until
+	// the transmission is done
+	HAL_SSI_Write(HAL_SSI_SEVEN_SEGMENT, data);
 
-	// Wait until data transmission is done by checking
-	// the BSY bit of the SSI Status Register (SSISR)
-	while (SSI2->SR & 0x10);
-
-	// Deassert the slave select pin by setting Bit 7
-	// of the DATA register for Port C
-	GPIOC->DATA |= 0x80;
+	// Deassert the slave select pin (PC7)
+	HAL_GPIO_Set(HAL_PIN_SEVEN_SEGMENT_CS);
 }
 
 int Count_Digits(int value)
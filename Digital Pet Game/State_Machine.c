@@ -0,0 +1,203 @@
+/**
+ * @file State_Machine.c
+ *
+ * @brief Source code for the table-driven hierarchical state machine engine.
+ *
+ * This file contains the function definitions for the state machine engine.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "State_Machine.h"
+
+// Fills path with the given state and its ancestors below the top state, and returns their number
+static uint8_t State_Machine_Path(const State_Machine_Type *machine, uint8_t state, uint8_t path[STATE_MACHINE_MAX_DEPTH])
+{
+	uint8_t depth = 0;
+
+	while (state != STATE_MACHINE_TOP && depth < STATE_MACHINE_MAX_DEPTH)
+	{
+		path[depth++] = state;
+		state = machine->states[state].parent;
+	}
+	return depth;
+}
+
+// Runs the entry actions of the initial children of a state until a leaf is reached
+static uint8_t State_Machine_Enter_Initial(State_Machine_Type *machine, uint8_t state)
+{
+	while (machine->states[state].initial != STATE_MACHINE_LEAF)
+	{
+		state = machine->states[state].initial;
+		if (machine->states[state].entry)
+		{
+			machine->states[state].entry();
+		}
+	}
+	return state;
+}
+
+static void State_Machine_Transition_To(State_Machine_Type *machine, const State_Machine_Transition *transition)
+{
+	uint8_t target_path[STATE_MACHINE_MAX_DEPTH];
+	uint8_t target_depth = State_Machine_Path(machine, transition->target, target_path);
+	uint8_t state = machine->current;
+	uint8_t common = target_depth;
+
+	// Exit up to the closest state that is a strict ancestor of the target.
+	// target_path[0] is the target itself, so it is always exited and entered again.
+	while (state != STATE_MACHINE_TOP)
+	{
+		for (uint8_t i = 1; i < target_depth; i++)
+		{
+			if (target_path[i] == state)
+			{
+				common = i;
+				break;
+			}
+		}
+		if (common != target_depth)
+		{
+			break;
+		}
+
+		if (machine->states[state].exit)
+		{
+			machine->states[state].exit();
+		}
+		state = machine->states[state].parent;
+	}
+
+	if (transition->action)
+	{
+		transition->action();
+	}
+
+	// Enter from below the common ancestor down to the target
+	while (common > 0)
+	{
+		common--;
+		if (machine->states[target_path[common]].entry)
+		{
+			machine->states[target_path[common]].entry();
+		}
+	}
+	machine->current = State_Machine_Enter_Initial(machine, transition->target);
+}
+
+void State_Machine_Init(State_Machine_Type *machine, const State_Machine_State *states, uint8_t state_count,
+	const State_Machine_Transition *transitions, uint8_t event_count, uint16_t *dispatch, uint32_t (*clock_us)(void))
+{
+	machine->states = states;
+	machine->transitions = transitions;
+	machine->state_count = state_count;
+	machine->event_count = event_count;
+	machine->dispatch = dispatch;
+	machine->current = STATE_MACHINE_TOP;
+	machine->clock_us = clock_us;
+	machine->trace_count = 0;
+
+	// Each state handles an event itself or inherits the handler of its closest ancestor
+	for (uint8_t state = 0; state < state_count; state++)
+	{
+		for (uint8_t event = 0; event < event_count; event++)
+		{
+			uint8_t handler = state;
+
+			while (handler != STATE_MACHINE_TOP && transitions[handler * event_count + event].target == STATE_MACHINE_TOP)
+			{
+				handler = states[handler].parent;
+			}
+
+			dispatch[state * event_count + event] = (handler == STATE_MACHINE_TOP) ?
+				STATE_MACHINE_UNHANDLED : (uint16_t)(handler * event_count + event);
+		}
+	}
+}
+
+void State_Machine_Start(State_Machine_Type *machine, uint8_t state)
+{
+	State_Machine_Transition start = {0, 0};
+
+	start.target = state;
+	State_Machine_Transition_To(machine, &start);
+}
+
+uint8_t State_Machine_Dispatch(State_Machine_Type *machine, uint8_t event)
+{
+	if (event >= machine->event_count)
+	{
+		return 0;
+	}
+
+	uint16_t cell = machine->dispatch[machine->current * machine->event_count + event];
+	if (cell == STATE_MACHINE_UNHANDLED)
+	{
+		return 0;
+	}
+
+	const State_Machine_Transition *transition = &machine->transitions[cell];
+	State_Machine_Trace_Entry *entry = &machine->trace[machine->trace_count & (STATE_MACHINE_TRACE_SIZE - 1)];
+	uint32_t start_us = machine->clock_us ? machine->clock_us() : 0;
+
+	entry->event = event;
+	entry->source = machine->current;
+
+	if (transition->target == STATE_MACHINE_INTERNAL)
+	{
+		if (transition->action)
+		{
+			transition->action();
+		}
+	}
+	else
+	{
+		State_Machine_Transition_To(machine, transition);
+	}
+
+	entry->target = machine->current;
+	entry->time_us = start_us;
+	entry->duration_us = machine->clock_us ? machine->clock_us() - start_us : 0;
+	machine->trace_count++;
+
+	return 1;
+}
+
+void State_Machine_Update(State_Machine_Type *machine)
+{
+	if (machine->states[machine->current].update)
+	{
+		machine->states[machine->current].update();
+	}
+}
+
+uint8_t State_Machine_Get_State(const State_Machine_Type *machine)
+{
+	return machine->current;
+}
+
+uint8_t State_Machine_Is_In(const State_Machine_Type *machine, uint8_t state)
+{
+	uint8_t current = machine->current;
+
+	while (current != STATE_MACHINE_TOP)
+	{
+		if (current == state)
+		{
+			return 1;
+		}
+		current = machine->states[current].parent;
+	}
+	return 0;
+}
+
+uint8_t State_Machine_Get_Trace(const State_Machine_Type *machine, uint32_t age, State_Machine_Trace_Entry *entry)
+{
+	if (age >= machine->trace_count || age >= STATE_MACHINE_TRACE_SIZE)
+	{
+		return 0;
+	}
+
+	*entry = machine->trace[(machine->trace_count - 1 - age) & (STATE_MACHINE_TRACE_SIZE - 1)];
+	return 1;
+}
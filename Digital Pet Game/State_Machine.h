@@ -0,0 +1,186 @@
+/**
+ * @file State_Machine.h
+ *
+ * @brief Header file for the table-driven hierarchical state machine engine.
+ *
+ * A state machine is described by two constant tables:
+ *  - The state table lists the parent, the initial child, the entry and exit actions and the update
+ *    activity of each state.
+ *    State 0 (STATE_MACHINE_TOP) is the top state. It is the parent of the top-level states and
+ *    handles no event.
+ *  - The transition table has one cell per state and event with the target state and an optional action.
+ *    A cell with the target STATE_MACHINE_TOP does not handle the event, so the event is passed to the
+ *    parent state. A cell with the target STATE_MACHINE_INTERNAL runs its action without leaving the state.
+ *
+ * The machine is always in a leaf state. A transition to a composite state continues into its initial
+ * child until a leaf is reached. The exit actions run from the current leaf up to the closest common
+ * ancestor of the source and the target, then the transition action runs, then the entry actions run
+ * from below that ancestor down to the new leaf. A transition to the current state or to one of its
+ * ancestors leaves and enters that state again.
+ *
+ * State_Machine_Init resolves the inherited transitions of every state once, so State_Machine_Dispatch
+ * finds the handler of an event with a single table lookup. Entry, exit and transition actions must not
+ * call State_Machine_Dispatch, but the update activity of a leaf state may, for example to report a timeout.
+ *
+ * Every handled event is recorded in a trace ring buffer with its time and the time taken by the
+ * exit, transition and entry actions, which can be read with State_Machine_Get_Trace or the debugger.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include <stdint.h>
+
+// The top state, and the target of the transition table cells that do not handle their event
+#define STATE_MACHINE_TOP           0
+
+// Target of an internal transition, which only runs its action
+#define STATE_MACHINE_INTERNAL      0xFF
+
+// Initial child of a leaf state
+#define STATE_MACHINE_LEAF          0
+
+// Deepest supported nesting of states below the top state
+#define STATE_MACHINE_MAX_DEPTH     4
+
+// Number of handled events kept in the trace (power of two)
+#define STATE_MACHINE_TRACE_SIZE    32
+
+// Value of a resolved dispatch table entry for an event that no state handles
+#define STATE_MACHINE_UNHANDLED     0xFFFF
+
+typedef struct
+{
+	const char *name;
+
+	// Parent state, or STATE_MACHINE_TOP for a top-level state
+	uint8_t parent;
+
+	// Child entered when this state is the target of a transition, or STATE_MACHINE_LEAF
+	uint8_t initial;
+
+	// Actions run when the state is entered and exited, or 0
+	void (*entry)(void);
+	void (*exit)(void);
+
+	// Activity run by State_Machine_Update while the state is the current leaf, or 0
+	void (*update)(void);
+} State_Machine_State;
+
+typedef struct
+{
+	// Target state, STATE_MACHINE_INTERNAL, or STATE_MACHINE_TOP if the event is passed to the parent state
+	uint8_t target;
+
+	// Action run between the exit and the entry actions, or 0
+	void (*action)(void);
+} State_Machine_Transition;
+
+typedef struct
+{
+	// Time of the event and time taken by the actions, in microseconds
+	uint32_t time_us;
+	uint32_t duration_us;
+
+	uint8_t event;
+
+	// Leaf states before and after the event
+	uint8_t source;
+	uint8_t target;
+} State_Machine_Trace_Entry;
+
+typedef struct
+{
+	const State_Machine_State *states;
+	const State_Machine_Transition *transitions;
+	uint8_t state_count;
+	uint8_t event_count;
+
+	// Index of the transition table cell that handles each state and event (caller storage)
+	uint16_t *dispatch;
+
+	// Current leaf state
+	uint8_t current;
+
+	// Microsecond clock used by the trace, or 0 to record no time
+	uint32_t (*clock_us)(void);
+
+	State_Machine_Trace_Entry trace[STATE_MACHINE_TRACE_SIZE];
+	uint32_t trace_count;
+} State_Machine_Type;
+
+/**
+ * @brief Initializes a state machine and resolves the handler of every state and event.
+ *
+ * The machine is in the top state until State_Machine_Start is called.
+ *
+ * @param machine A pointer to the state machine.
+ * @param states The state table, starting with the top state.
+ * @param state_count The number of states, including the top state.
+ * @param transitions The transition table, with event_count cells per state.
+ * @param event_count The number of events.
+ * @param dispatch An array of (state_count * event_count) entries filled in by this function.
+ * @param clock_us A function that returns the time in microseconds, or 0.
+ *
+ * @return None
+ */
+void State_Machine_Init(State_Machine_Type *machine, const State_Machine_State *states, uint8_t state_count,
+	const State_Machine_Transition *transitions, uint8_t event_count, uint16_t *dispatch, uint32_t (*clock_us)(void));
+
+/**
+ * @brief Enters the given state, running the entry actions from the top state down to the leaf.
+ *
+ * @param machine A pointer to the state machine.
+ * @param state The state to enter.
+ *
+ * @return None
+ */
+void State_Machine_Start(State_Machine_Type *machine, uint8_t state);
+
+/**
+ * @brief Sends an event to the current state.
+ *
+ * @param machine A pointer to the state machine.
+ * @param event The event.
+ *
+ * @return 1 if a state handled the event, 0 if it was ignored.
+ */
+uint8_t State_Machine_Dispatch(State_Machine_Type *machine, uint8_t event);
+
+/**
+ * @brief Runs the update activity of the current leaf state.
+ *
+ * @param machine A pointer to the state machine.
+ *
+ * @return None
+ */
+void State_Machine_Update(State_Machine_Type *machine);
+
+/**
+ * @brief Returns the current leaf state.
+ *
+ * @param machine A pointer to the state machine.
+ *
+ * @return The current leaf state.
+ */
+uint8_t State_Machine_Get_State(const State_Machine_Type *machine);
+
+/**
+ * @brief Checks if the current leaf state is the given state or one of its children.
+ *
+ * @param machine A pointer to the state machine.
+ * @param state The state to check.
+ *
+ * @return 1 if the machine is in the given state, 0 otherwise.
+ */
+uint8_t State_Machine_Is_In(const State_Machine_Type *machine, uint8_t state);
+
+/**
+ * @brief Reads an entry of the trace.
+ *
+ * @param machine A pointer to the state machine.
+ * @param age The age of the entry, 0 for the most recent handled event.
+ * @param entry A pointer to the entry that is filled in.
+ *
+ * @return 1 if the entry was read, 0 if the trace does not hold an entry of that age.
+ */
+uint8_t State_Machine_Get_Trace(const State_Machine_Type *machine, uint32_t age, State_Machine_Trace_Entry *entry);
@@ -0,0 +1,280 @@
+/**
+ * @file Stats_Log.c
+ *
+ * @brief Source code for the lifetime game statistics log kept in the flash memory.
+ *
+ * This file contains the function definitions for the statistics log. The CRC-8 of an entry uses
+ * the polynomial 0x07 over Bits 31 to 8 of its first word and over its other words, most
+ * significant byte first, computed four bits at a time with a 16-entry table.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Stats_Log.h"
+
+#define STATS_LOG_HALF_SIZE     (STATS_LOG_SIZE / 2)
+#define STATS_LOG_HEADER_SIZE   8
+
+// "SLOG"
+#define STATS_LOG_MAGIC         0x534C4F47
+
+// Entry types (Bits 31 to 28 of the first word) and their length in words
+#define STATS_LOG_GAME          1
+#define STATS_LOG_SUMMARY       2
+#define STATS_LOG_GAME_WORDS    2
+#define STATS_LOG_SUMMARY_WORDS 5
+
+#define STATS_LOG_MAX_FEEDS     1023
+
+static const uint8_t crc_table[16] =
+{
+	0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D
+};
+
+// Totals of every level, rebuilt from the log at reset
+static Stats_Log_Level totals[STATS_LOG_LEVELS];
+
+static uint8_t log_ready = 0;
+static uint32_t active_base = STATS_LOG_BASE;
+static uint32_t active_generation = 0;
+
+// Address of the next entry in the active half
+static uint32_t end_address = STATS_LOG_BASE + STATS_LOG_HEADER_SIZE;
+
+static uint8_t Stats_Log_CRC(const uint32_t *entry, uint32_t words)
+{
+	uint8_t crc = 0;
+	
+	for (uint32_t i = 0; i < words; i++)
+	{
+		for (int shift = 24; shift >= ((i == 0) ? 8 : 0); shift -= 8)
+		{
+			crc = crc ^ (uint8_t)(entry[i] >> shift);
+			crc = (uint8_t)(crc << 4) ^ crc_table[crc >> 4];
+			crc = (uint8_t)(crc << 4) ^ crc_table[crc >> 4];
+		}
+	}
+	return crc;
+}
+
+static uint16_t Stats_Log_Add_16(uint16_t total, uint32_t amount)
+{
+	return (total + amount > 0xFFFF) ? 0xFFFF : (uint16_t)(total + amount);
+}
+
+// Adds a valid entry to the totals of its level
+static void Stats_Log_Add_Entry(const uint32_t *entry)
+{
+	Stats_Log_Level *level = &totals[(entry[0] >> 24) & 0x07];
+	
+	if ((entry[0] >> 28) == STATS_LOG_GAME)
+	{
+		uint32_t result = (entry[0] >> 22) & 0x03;
+		uint32_t feeds = (entry[0] >> 12) & STATS_LOG_MAX_FEEDS;
+		uint16_t survival_s = (uint16_t)(entry[1] >> 16);
+		
+		level->games = Stats_Log_Add_16(level->games, 1);
+		level->wins = Stats_Log_Add_16(level->wins, result == STATS_LOG_WON);
+		level->losses = Stats_Log_Add_16(level->losses, result == STATS_LOG_LOST);
+		level->best_survival_s = (survival_s > level->best_survival_s) ? survival_s : level->best_survival_s;
+		level->feeds += feeds;
+		level->reaction_sum_ms += feeds * (entry[1] & 0xFFFF);
+	}
+	else
+	{
+		level->games = Stats_Log_Add_16(level->games, entry[1] >> 16);
+		level->wins = Stats_Log_Add_16(level->wins, entry[1] & 0xFFFF);
+		level->losses = Stats_Log_Add_16(level->losses, entry[2] >> 16);
+		level->best_survival_s = ((entry[2] & 0xFFFF) > level->best_survival_s) ?
+			(uint16_t)(entry[2] & 0xFFFF) : level->best_survival_s;
+		level->feeds += entry[3];
+		level->reaction_sum_ms += entry[4];
+	}
+}
+
+// Programs an entry at the end of the active half. The end moves past the entry even if
+// programming fails, so a damaged entry is skipped by the scan.
+static uint8_t Stats_Log_Write(uint32_t *entry, uint32_t words)
+{
+	uint8_t ok = 1;
+	
+	entry[0] = (entry[0] & 0xFFFFFF00) | Stats_Log_CRC(entry, words);
+	for (uint32_t i = 0; i < words; i++)
+	{
+		ok = Flash_Program(end_address, entry[i]) && ok;
+		end_address += 4;
+	}
+	return ok;
+}
+
+static uint8_t Stats_Log_Erase_Half(uint32_t base)
+{
+	uint8_t ok = 1;
+	
+	for (uint32_t page = 0; page < STATS_LOG_HALF_SIZE; page += FLASH_PAGE_SIZE)
+	{
+		ok = Flash_Erase_Page(base + page) && ok;
+	}
+	return ok;
+}
+
+// Starts the given half with a header: the generation number first, then the magic word,
+// so the half is only valid once both are programmed
+static uint8_t Stats_Log_Start_Half(uint32_t base, uint32_t generation)
+{
+	if (!Flash_Program(base + 4, generation) || !Flash_Program(base, STATS_LOG_MAGIC))
+	{
+		return 0;
+	}
+	active_base = base;
+	active_generation = generation;
+	return 1;
+}
+
+// Reads the entries of the active half into the totals and finds the end of the log
+static void Stats_Log_Scan(void)
+{
+	uint32_t limit = active_base + STATS_LOG_HALF_SIZE;
+	uint32_t entry[STATS_LOG_SUMMARY_WORDS];
+	uint32_t address = active_base + STATS_LOG_HEADER_SIZE;
+	
+	for (int i = 0; i < STATS_LOG_LEVELS; i++)
+	{
+		totals[i] = (Stats_Log_Level){0};
+	}
+	
+	while (address < limit)
+	{
+		entry[0] = Flash_Read(address);
+		if (entry[0] == 0xFFFFFFFF)
+		{
+			break;
+		}
+		
+		uint32_t type = entry[0] >> 28;
+		uint32_t words = (type == STATS_LOG_GAME) ? STATS_LOG_GAME_WORDS :
+			((type == STATS_LOG_SUMMARY) ? STATS_LOG_SUMMARY_WORDS : 0);
+		
+		// An unknown entry hides where the next one starts, so the half is taken as full
+		if (words == 0 || address + words * 4 > limit)
+		{
+			address = limit;
+			break;
+		}
+		
+		for (uint32_t i = 1; i < words; i++)
+		{
+			entry[i] = Flash_Read(address + i * 4);
+		}
+		if (Stats_Log_CRC(entry, words) == (entry[0] & 0xFF))
+		{
+			Stats_Log_Add_Entry(entry);
+		}
+		address += words * 4;
+	}
+	end_address = address;
+}
+
+// Moves the totals to a summary in the other half and erases the active half
+static uint8_t Stats_Log_Compact(void)
+{
+	uint32_t old_base = active_base;
+	uint32_t new_base = (active_base == STATS_LOG_BASE) ? (STATS_LOG_BASE + STATS_LOG_HALF_SIZE) : STATS_LOG_BASE;
+	uint32_t entry[STATS_LOG_SUMMARY_WORDS];
+	
+	if (!Stats_Log_Erase_Half(new_base))
+	{
+		return 0;
+	}
+	
+	end_address = new_base + STATS_LOG_HEADER_SIZE;
+	for (uint32_t level = 0; level < STATS_LOG_LEVELS; level++)
+	{
+		if (totals[level].games > 0)
+		{
+			entry[0] = ((uint32_t)STATS_LOG_SUMMARY << 28) | (level << 24);
+			entry[1] = ((uint32_t)totals[level].games << 16) | totals[level].wins;
+			entry[2] = ((uint32_t)totals[level].losses << 16) | totals[level].best_survival_s;
+			entry[3] = totals[level].feeds;
+			entry[4] = totals[level].reaction_sum_ms;
+			if (!Stats_Log_Write(entry, STATS_LOG_SUMMARY_WORDS))
+			{
+				return 0;
+			}
+		}
+	}
+	
+	if (!Stats_Log_Start_Half(new_base, active_generation + 1))
+	{
+		return 0;
+	}
+	return Stats_Log_Erase_Half(old_base);
+}
+
+uint8_t Stats_Log_Init(void)
+{
+	uint8_t found = 0;
+	
+	// The valid half with the newest generation is the active half
+	for (uint32_t base = STATS_LOG_BASE; base < STATS_LOG_BASE + STATS_LOG_SIZE; base += STATS_LOG_HALF_SIZE)
+	{
+		uint32_t generation = Flash_Read(base + 4);
+		
+		if (Flash_Read(base) == STATS_LOG_MAGIC && (!found || (int32_t)(generation - active_generation) > 0))
+		{
+			active_base = base;
+			active_generation = generation;
+			found = 1;
+		}
+	}
+	
+	if (!found)
+	{
+		log_ready = Stats_Log_Erase_Half(STATS_LOG_BASE) && Stats_Log_Start_Half(STATS_LOG_BASE, 1);
+	}
+	else
+	{
+		log_ready = 1;
+	}
+	
+	Stats_Log_Scan();
+	return log_ready;
+}
+
+uint8_t Stats_Log_Append(const Stats_Log_Game *game)
+{
+	uint32_t entry[STATS_LOG_GAME_WORDS];
+	uint32_t feeds = (game->feeds > STATS_LOG_MAX_FEEDS) ? STATS_LOG_MAX_FEEDS : game->feeds;
+	
+	if (!log_ready || game->level >= STATS_LOG_LEVELS)
+	{
+		return 0;
+	}
+	
+	if (end_address + STATS_LOG_GAME_WORDS * 4 > active_base + STATS_LOG_HALF_SIZE && !Stats_Log_Compact())
+	{
+		return 0;
+	}
+	
+	entry[0] = ((uint32_t)STATS_LOG_GAME << 28) | ((uint32_t)game->level << 24) |
+		((uint32_t)(game->result & 0x03) << 22) | (feeds << 12);
+	entry[1] = ((uint32_t)game->survival_s << 16) | game->reaction_ms;
+	
+	uint8_t ok = Stats_Log_Write(entry, STATS_LOG_GAME_WORDS);
+	Stats_Log_Add_Entry(entry);
+	return ok;
+}
+
+const Stats_Log_Level *Stats_Log_Get_Level(uint8_t level)
+{
+	return (level < STATS_LOG_LEVELS) ? &totals[level] : 0;
+}
+
+uint32_t Stats_Log_Get_Average_Reaction(uint8_t level)
+{
+	if (level >= STATS_LOG_LEVELS || totals[level].feeds == 0)
+	{
+		return 0;
+	}
+	return totals[level].reaction_sum_ms / totals[level].feeds;
+}
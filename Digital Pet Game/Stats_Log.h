@@ -0,0 +1,104 @@
+/**
+ * @file Stats_Log.h
+ *
+ * @brief Header file for the lifetime game statistics log kept in the flash memory.
+ *
+ * Every finished game is appended as one entry to a log in a flash region reserved at the end of
+ * the flash memory (STATS_LOG_BASE), which the project does not link code into. The totals of each
+ * level are kept in RAM, so reading them never scans the log:
+ *  - Stats_Log_Init rebuilds the totals by scanning the log once at reset.
+ *  - Stats_Log_Append programs the entry and adds it to the totals.
+ *
+ * The region is split into two halves. The active half starts with a header (magic word and
+ * generation number) followed by the entries. When the active half is full, the log is compacted:
+ * the other half is erased, one summary entry with the totals of each level is written to it, its
+ * header is written last, and the old half is erased. A reset during a compaction therefore finds
+ * either the old half or the new one complete.
+ *
+ * Entry format (words), where each first word holds a CRC-8 of the entry in Bits 7 to 0:
+ *  - Game (2 words): type 1, level, result and feeds, then the survival time in seconds and the
+ *    average feed reaction time in milliseconds
+ *  - Summary (5 words): type 2 and level, then the games and wins, the losses and the best
+ *    survival time, the feeds, and the sum of the feed reaction times
+ *
+ * A half holds 255 entries of 2 words. A game programs 2 words and never erases anything, and a
+ * compaction erases the 4 pages once every 235 to 255 games, so the flash endurance of 100,000
+ * erase cycles lasts for more than 20 million games.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Flash.h"
+
+// Reserved flash region: the last 4 KB (4 pages), in two halves
+#define STATS_LOG_BASE          0x3F000
+#define STATS_LOG_SIZE          0x1000
+
+// Number of levels with totals (level numbers are 0 to STATS_LOG_LEVELS - 1)
+#define STATS_LOG_LEVELS        8
+
+// Game results
+#define STATS_LOG_WON           0
+#define STATS_LOG_LOST          1
+#define STATS_LOG_QUIT          2
+
+typedef struct
+{
+	uint8_t level;
+	uint8_t result;
+	
+	// Number of feeds timed by the reaction time (up to 1023), and their average reaction time
+	uint16_t feeds;
+	uint16_t reaction_ms;
+	
+	// Time the pet was kept alive, without the time spent paused
+	uint16_t survival_s;
+} Stats_Log_Game;
+
+typedef struct
+{
+	uint16_t games;
+	uint16_t wins;
+	uint16_t losses;
+	uint16_t best_survival_s;
+	uint32_t feeds;
+	uint32_t reaction_sum_ms;
+} Stats_Log_Level;
+
+/**
+ * @brief Finds the active half of the log and rebuilds the totals of every level.
+ * An empty or damaged region is erased and a new log is started.
+ *
+ * @param None
+ *
+ * @return 1 if the log is ready, or 0 if the flash memory could not be written.
+ */
+uint8_t Stats_Log_Init(void);
+
+/**
+ * @brief Appends a finished game to the log and adds it to the totals of its level.
+ * Compacts the log first if the active half is full.
+ *
+ * @param game A pointer to the finished game.
+ *
+ * @return 1 if the game was appended, or 0 if the flash memory could not be written.
+ */
+uint8_t Stats_Log_Append(const Stats_Log_Game *game);
+
+/**
+ * @brief Returns the totals of one level.
+ *
+ * @param level The level number.
+ *
+ * @return A pointer to the totals, or 0 if the level number is out of range.
+ */
+const Stats_Log_Level *Stats_Log_Get_Level(uint8_t level);
+
+/**
+ * @brief Returns the average feed reaction time of one level.
+ *
+ * @param level The level number.
+ *
+ * @return The average reaction time in milliseconds, or 0 if no feed was timed.
+ */
+uint32_t Stats_Log_Get_Average_Reaction(uint8_t level);
@@ -11,41 +11,60 @@
  * as the clock source. The PIOSC provides 16 MHz which is then divided by 4. 
  * The timer is used for creating delays in either microseconds or milliseconds.
  *
+ * The timer only runs during a delay. Otherwise its interrupt every 1 us would take a large
+ * part of the CPU time, and all of it with the system clock at the PIOSC frequency (Power.h).
+ *
  * @author Aaron Nanas
  */
 
 #include "SysTick_Delay.h"
+#include "Clock.h"
+
+// SysTick counts PIOSC / 4 and interrupts every 1 us
+CLOCK_STATIC_ASSERT((CLOCK_SYSTICK_HZ % 1000000) == 0, systick_whole_us);
 
 // Global variable used to keep track of elapsed time in microseconds
-static uint32_t us_elapsed = 0;
+static volatile uint32_t us_elapsed = 0;
 
 // Global variable used to keep track of elapsed time in milliseconds
-static uint32_t ms_elapsed = 0;
+static volatile uint32_t ms_elapsed = 0;
 
 // Global flag used to indicate if milliseconds delay is active
-static uint8_t ms_active = 0;
+static volatile uint8_t ms_active = 0;
 
 void SysTick_Delay_Init(void)
 {	
 	// Set the SysTick timer reload value for 1 us intervals
 	// Each clock cycle is (1 / 4 MHz) = 0.25 us
-	SysTick->LOAD = (4 - 1);
+	SysTick->LOAD = (CLOCK_SYSTICK_HZ / 1000000) - 1;
 	
-	// Clear the VAL register by writing any value to it
+	// Keep the SysTick timer stopped until a delay starts it, with the
+	// Peripheral Internal Oscillator (PIOSC) as the clock source (CLK_SRC = 0)
+	SysTick->CTRL = 0x00;
+}
+
+// Restarts the SysTick timer and its interrupt from a full 1 us interval
+static void SysTick_Start(void)
+{
 	SysTick->VAL = 0;
-	
-	// Enable the SysTick timer and its interrupt
-	// with the Peripheral Internal Oscillator (PIOSC) as the clock source
 	SysTick->CTRL |= 0x03;
 }
 
+static void SysTick_Stop(void)
+{
+	SysTick->CTRL &= ~0x03;
+}
+
 void SysTick_Delay1us(uint32_t delay_in_us)
 {
 	// Reset the global variable, us_elapsed
 	us_elapsed = 0;
+	SysTick_Start();
 	
 	// Wait until ms_value reaches the specified delay_in_ms
 	while (delay_in_us > us_elapsed);
+	
+	SysTick_Stop();
 }
 
 void SysTick_Delay1ms(uint32_t delay_in_ms)
@@ -56,11 +75,13 @@ void SysTick_Delay1ms(uint32_t delay_in_ms)
 	
 	// Set the ms_active global flag
 	ms_active = 0x01;
+	SysTick_Start();
 	
 	// Wait until ms_elapsed reaches the specified delay_in_ms
 	while (delay_in_ms > ms_elapsed);
 	
-	// Reset the ms_active global flag
+	// Stop the timer and reset the ms_active global flag
+	SysTick_Stop();
 	ms_active = 0x00;
 }
 
@@ -11,6 +11,9 @@
  * as the clock source. The PIOSC provides 16 MHz which is then divided by 4. 
  * The timer is used for creating delays in either microseconds or milliseconds.
  *
+ * The timer only runs during a delay. Otherwise its interrupt every 1 us would take a large
+ * part of the CPU time, and all of it with the system clock at the PIOSC frequency (Power.h).
+ *
  * @author Aaron Nanas
  */
  
@@ -22,7 +25,7 @@
  * This function configures the SysTick timer and its interrupt with a specified reload value to 
  * generate interrupts every 1 us. It uses the Peripheral Internal Oscillator (PIOSC) as the clock source.
  * The PIOSC provides 16 MHz which is then divided by 4. The timer is used for creating delays in either 
- * microseconds or milliseconds.
+ * microseconds or milliseconds, and it is started by each delay function.
  *
  * @param None
  *
@@ -33,8 +36,8 @@ void SysTick_Delay_Init(void);
 /**
  * @brief The SysTick_Delay1us function provides a blocking delay in microseconds using the SysTick timer.
  *
- * This function resets the global variable, us_elapsed, to zero and waits until us_elapsed reaches 
- * the specified delay_in_us.
+ * This function resets the global variable, us_elapsed, to zero, starts the timer and waits until
+ * us_elapsed reaches the specified delay_in_us. The timer is stopped after the delay.
  *
  * @param delay_in_us The delay time in microseconds.
  *
@@ -46,8 +49,8 @@ void SysTick_Delay1us(uint32_t delay_in_us);
  * @brief The SysTick_Delay1ms function provides a blocking delay in milliseconds using the SysTick timer.
  *
  * This function clears the global variables, us_elapsed and ms_elapsed, to zero and sets ms_active flag to 0x01 
- * indicating that milliseconds delay is active. It then waits until ms_elapsed reaches the specified delay_in_ms.
- * After the delay, it clears ms_active flag back to 0x00.
+ * indicating that milliseconds delay is active. It then starts the timer and waits until ms_elapsed reaches the
+ * specified delay_in_ms. After the delay, it stops the timer and clears ms_active flag back to 0x00.
  *
  * @param delay_in_ms The delay time in milliseconds.
  *
@@ -0,0 +1,95 @@
+/**
+ * @file Timebase.c
+ *
+ * @brief Source code for the Timebase driver.
+ *
+ * This file contains the function definitions for the Timebase driver.
+ * It uses Wide Timer 0 as a free-running 64-bit up-counter clocked by the system clock.
+ *
+ * @note The system clock frequency is taken from Clock.h.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "Timebase.h"
+
+// The time is kept in units of TIMEBASE_UNIT_HZ, which must be a whole number of units per
+// microsecond and of units per system clock cycle
+CLOCK_STATIC_ASSERT((TIMEBASE_UNIT_HZ % 1000000) == 0, timebase_whole_us);
+CLOCK_STATIC_ASSERT((TIMEBASE_UNIT_HZ % TIMEBASE_CLOCK_HZ) == 0, timebase_whole_units);
+
+// Time in units at the count of the last clock change, and units per cycle since then
+static uint64_t base_units = 0;
+static uint64_t base_ticks = 0;
+static uint32_t units_per_tick = TIMEBASE_UNIT_HZ / TIMEBASE_CLOCK_HZ;
+
+static uint64_t Timebase_Get_Units(void)
+{
+	return base_units + (Timebase_Get_Ticks() - base_ticks) * units_per_tick;
+}
+
+void Timebase_Init(void)
+{
+	base_units = 0;
+	base_ticks = 0;
+	units_per_tick = TIMEBASE_UNIT_HZ / TIMEBASE_CLOCK_HZ;
+	
+	// Enable the clock to Wide Timer 0 by setting the R0 bit (Bit 0) in the RCGCWTIMER register
+	SYSCTL->RCGCWTIMER |= 0x01;
+	
+	// Keep Wide Timer 0 clocked in sleep mode so that no time is lost while the CPU waits in WFI
+	SYSCTL->SCGCWTIMER |= 0x01;
+	
+	// Clear the TAEN bit (Bit 0) of the GPTMCTL register to disable Wide Timer 0
+	WTIMER0->CTL &= ~0x01;
+	
+	// 0x0 = Select the 64-bit timer configuration (Timer A and Timer B concatenated)
+	WTIMER0->CFG = 0x00;
+	
+	// 0x2 = Periodic Timer Mode, and set the TACDIR bit (Bit 4) to count up
+	WTIMER0->TAMR = 0x12;
+	
+	// Count over the full 64-bit range: TAILR holds the lower and TBILR the upper 32 bits
+	WTIMER0->TBILR = 0xFFFFFFFF;
+	WTIMER0->TAILR = 0xFFFFFFFF;
+	
+	// No interrupts are used
+	WTIMER0->IMR = 0x00;
+	
+	// Set the TAEN bit (Bit 0) in the GPTMCTL register to enable Wide Timer 0
+	WTIMER0->CTL |= 0x01;
+}
+
+uint64_t Timebase_Get_Ticks(void)
+{
+	uint32_t upper;
+	uint32_t lower;
+	
+	// Read again if the lower half overflowed into the upper half between the reads
+	do
+	{
+		upper = WTIMER0->TBV;
+		lower = WTIMER0->TAV;
+	} while (upper != WTIMER0->TBV);
+	
+	return ((uint64_t)upper << 32) | lower;
+}
+
+void Timebase_Set_Clock(uint32_t clock_hz)
+{
+	uint64_t ticks = Timebase_Get_Ticks();
+	
+	base_units = base_units + (ticks - base_ticks) * units_per_tick;
+	base_ticks = ticks;
+	units_per_tick = TIMEBASE_UNIT_HZ / clock_hz;
+}
+
+uint32_t Timebase_Get_Us(void)
+{
+	return (uint32_t)(Timebase_Get_Units() / (TIMEBASE_UNIT_HZ / 1000000));
+}
+
+uint32_t Timebase_Get_Ms(void)
+{
+	return (uint32_t)(Timebase_Get_Units() / (TIMEBASE_UNIT_HZ / 1000));
+}
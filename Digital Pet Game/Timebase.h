@@ -0,0 +1,81 @@
+/**
+ * @file Timebase.h
+ *
+ * @brief Header file for the Timebase driver.
+ *
+ * This file contains the function definitions for the Timebase driver.
+ * It uses Wide Timer 0 as a free-running 64-bit up-counter clocked by the system clock,
+ * which provides a monotonic timestamp that never wraps during the lifetime of the board
+ * and needs no interrupts.
+ *
+ * The system clock can change at run time (Power.h). The time counted before a change is kept
+ * in units of the PLL output period (TIMEBASE_UNIT_HZ), which every system clock frequency
+ * divides exactly, so no fraction of a microsecond is lost when the frequency changes.
+ *
+ * @note The system clock frequency is taken from Clock.h.
+ *
+ * @author Anna Bagdishyan and Mario Perez
+ */
+
+#include "TM4C123GH6PM.h"
+#include "Clock.h"
+
+// Frequency of the Wide Timer 0 count after Timebase_Init (system clock)
+#define TIMEBASE_CLOCK_HZ CLOCK_SYSTEM_HZ
+
+// Unit of the time kept across system clock changes (PLL output)
+#define TIMEBASE_UNIT_HZ CLOCK_PLL_HZ
+
+/**
+ * @brief Initializes Wide Timer 0 as a free-running 64-bit up-counter.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Timebase_Init(void);
+
+/**
+ * @brief Returns the number of system clock cycles since Timebase_Init was called.
+ *
+ * The two 32-bit halves are read until the upper half is stable, so the value is
+ * consistent even if the lower half overflows between the reads. The cycles are counted
+ * at the system clock frequency of the time, so after a call to Timebase_Set_Clock they
+ * no longer convert to time with a single frequency.
+ *
+ * @param None
+ *
+ * @return The 64-bit timestamp in system clock cycles.
+ */
+uint64_t Timebase_Get_Ticks(void);
+
+/**
+ * @brief Tells the Timebase that the system clock has just changed frequency.
+ *
+ * The time counted so far is kept, and the cycles counted from now on are converted at the
+ * new frequency. It must be called with interrupts disabled right after the system clock
+ * changes, so that no time is read in between.
+ *
+ * @param clock_hz The new system clock frequency, which must divide TIMEBASE_UNIT_HZ.
+ *
+ * @return None
+ */
+void Timebase_Set_Clock(uint32_t clock_hz);
+
+/**
+ * @brief Returns the number of microseconds since Timebase_Init was called.
+ *
+ * @param None
+ *
+ * @return The timestamp in microseconds (wraps after about 71 minutes).
+ */
+uint32_t Timebase_Get_Us(void);
+
+/**
+ * @brief Returns the number of milliseconds since Timebase_Init was called.
+ *
+ * @param None
+ *
+ * @return The timestamp in milliseconds (wraps after about 49 days).
+ */
+uint32_t Timebase_Get_Ms(void);
@@ -9,7 +9,7 @@
  * @note Timer 0A has been configured to generate periodic interrupts every 1 ms
  * for the Timers lab.
  *
- * @note This driver assumes that the system clock's frequency is 50 MHz.
+ * @note The prescale value is derived from the system clock frequency in Clock.h.
  * 
  * @note Refer to Table 2-9 (Interrupts) on pages 104 - 106 from the TM4C123G Microcontroller Datasheet
  * to view the Vector Number, Interrupt Request (IRQ) Number, and the Vector Address
@@ -19,6 +19,12 @@
  */
 
 #include "Timer_0A_Interrupt.h"
+#include "Clock.h"
+#include "HAL.h"
+
+// Timer 0A counts at 1 MHz and its periodic interval is 1 ms
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_TICK_VALID(1000000), timer_0a_tick);
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_PERIOD_VALID(1000), timer_0a_period);
 
 // Declare pointer to the user-defined task
 void (*Timer_0A_Task)(void);
@@ -48,10 +54,10 @@ void Timer_0A_Interrupt_Init(void(*task)(void))
 	// GPTMTAPR register before setting the prescale value
 	TIMER0->TAPR &= ~0x000000FF;
 	
-	// Set the prescale value to 50 by setting the bits of the
+	// Set the prescale value by setting the bits of the
 	// TAPSR field (Bits 7 to 0) in the GPTMTAPR register
-	// New timer clock frequency = (50 MHz / 50) = 1 MHz
-	TIMER0->TAPR = 50;
+	// New timer clock frequency = (CLOCK_SYSTEM_HZ / (prescale value + 1)) = 1 MHz
+	TIMER0->TAPR = CLOCK_TIMER_PRESCALE(1000000);
 	
 	// Set the timer interval load value by writing to the
 	// TAILR field (Bits 31 to 0) in the GPTMTAILR register
@@ -67,28 +73,71 @@ void Timer_0A_Interrupt_Init(void(*task)(void))
 	// in the GPTMIMR register
 	TIMER0->IMR |= 0x01;
 	
-	// Set the priority level to 1 for the Timer 0A interrupt
-	// In the Interrupt 16-19 Priority (PRI4) register,
-	// the INTD field (Bits 31 to 29) corresponds to Interrupt Request (IRQ) 19
-	// Timer 0A has an IRQ of 19
-	NVIC->IPR[4] = (NVIC->IPR[4] & 0x00FFFFFF) | (1 << 29);
-	
-	// Enable IRQ 19 for Timer 0A by setting Bit 19 in the ISER[0] register
-	NVIC->ISER[0] |= (1 << 19);
+	// The priority of IRQ 19 is set and the IRQ is enabled by Interrupts_Init (Interrupts.h)
 	
 	// Set the TAEN bit (Bit 0) in the GPTMCTL register to enable Timer 0A
 	TIMER0->CTL |= 0x01;
 }
 
+void Timer_0A_One_Shot_Init(void(*task)(void), uint16_t period_us)
+{
+	// Store the user-defined task function for use during interrupt handling
+	Timer_0A_Task = task;
+	
+	// Set the R0 bit (Bit 0) in the RCGCTIMER register
+	// to enable the clock for Timer 0A
+	SYSCTL->RCGCTIMER |=  0x01;
+	
+	// Clear the TAEN bit (Bit 0) of the GPTMCTL register
+	// to disable Timer 0A
+	TIMER0->CTL &= ~0x01;
+	
+	// Set the bits of the GPTMCFG field (Bits 2 to 0) in the GPTMCFG register
+	// 0x4 = Select the 16-bit timer configuration
+	TIMER0->CFG |= 0x04;
+	
+	// Set the bits of the TAMR field (Bits 1 to 0) in the GPTMTAMR register
+	// 0x1 = One-Shot Timer Mode
+	TIMER0->TAMR = (TIMER0->TAMR & ~0x03) | 0x01;
+	
+	// Set the prescale value by setting the bits of the
+	// TAPSR field (Bits 7 to 0) in the GPTMTAPR register
+	// New timer clock frequency = (CLOCK_SYSTEM_HZ / (prescale value + 1)) = 1 MHz
+	TIMER0->TAPR &= ~0x000000FF;
+	TIMER0->TAPR = CLOCK_TIMER_PRESCALE(1000000);
+	
+	// Set the time-out period in microseconds
+	TIMER0->TAILR = (period_us - 1);
+	
+	// Clear the time-out flag and enable the Timer 0A time-out interrupt
+	TIMER0->ICR |= 0x01;
+	TIMER0->IMR |= 0x01;
+	
+	// The priority of IRQ 19 is set and the IRQ is enabled by Interrupts_Init (Interrupts.h)
+}
+
+void Timer_0A_One_Shot_Start(void)
+{
+	// Writing the load value reloads the counter, which restarts a period in progress
+	TIMER0->TAILR = TIMER0->TAILR;
+	
+	// Set the TAEN bit (Bit 0) in the GPTMCTL register to start Timer 0A.
+	// The TAEN bit is cleared by hardware at the time-out.
+	TIMER0->CTL |= 0x01;
+}
+
+// With HAL_BIND_TIMER_0A set, the vector runs the task bound to it at compile time instead
+#if !HAL_BIND_TIMER_0A
 void TIMER0A_Handler(void)
 {
 	// Read the Timer 0A time-out interrupt flag
-	if (TIMER0->MIS & 0x01)
+	if (HAL_Timer_Pending(HAL_TIMER_0A))
 	{
 		// Execute the user-defined function
 		(*Timer_0A_Task)();
 		
 		// Acknowledge the Timer 0A interrupt and clear it
-		TIMER0->ICR |= 0x01;
+		HAL_Timer_Clear(HAL_TIMER_0A);
 	}
 }
+#endif
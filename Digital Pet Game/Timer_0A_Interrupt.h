@@ -9,7 +9,7 @@
  * @note Timer 0A has been configured to generate periodic interrupts every 1 ms
  * for the Timers lab.
  *
- * @note This driver assumes that the system clock's frequency is 50 MHz.
+ * @note The prescale value is derived from the system clock frequency in Clock.h.
  * 
  * @note Refer to Table 2-9 (Interrupts) on pages 104 - 106 from the TM4C123G Microcontroller Datasheet
  * to view the Vector Number, Interrupt Request (IRQ) Number, and the Vector Address
@@ -27,9 +27,9 @@ extern void (*Timer_0A_Task)(void);
  * @brief Initializes the Timer 0A peripheral to generate periodic interrupts.
  *
  * This function initializes the Timer 1A peripheral to generate periodic interrupts for executing a user-defined task.
- * It configures Timer 0A with a 1 ms interval using the 50MHz system clock source.
+ * It configures Timer 0A with a 1 ms interval, using a prescale derived from CLOCK_SYSTEM_HZ (Clock.h).
  * The provided task function will be executed whenever Timer 0A generates an interrupt.
- * The priority level is set to 1.
+ * The priority level is set by Interrupts_Init (Interrupts.h).
  *
  * @param task A pointer to the user-defined function to be executed upon Timer 0A interrupt.
  *
@@ -37,12 +37,40 @@ extern void (*Timer_0A_Task)(void);
  */
 void Timer_0A_Interrupt_Init(void(*task)(void));
 
+/**
+ * @brief Initializes the Timer 0A peripheral as a one-shot timer.
+ *
+ * This function configures Timer 0A in one-shot mode with a 1 us resolution using the system clock source.
+ * The timer does not run until Timer_0A_One_Shot_Start is called, and it stops by itself after the time-out,
+ * so it does not generate any interrupts while it is idle.
+ * The provided task function will be executed once per Timer_0A_One_Shot_Start call.
+ * The priority level is set by Interrupts_Init (Interrupts.h).
+ *
+ * @param task A pointer to the user-defined function to be executed upon Timer 0A interrupt.
+ * @param period_us The time-out period in microseconds (1 - 65535).
+ *
+ * @return None
+ */
+void Timer_0A_One_Shot_Init(void(*task)(void), uint16_t period_us);
+
+/**
+ * @brief Starts (or restarts) the Timer 0A one-shot period.
+ *
+ * If the timer is already running, the period is restarted from the beginning.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Timer_0A_One_Shot_Start(void);
+
 /**
  * @brief The interrupt service routine (ISR) for Timer 0A.
  *
  * This function is the interrupt service routine (ISR) for the Timer 0A peripheral.
  * It checks the Timer 0A time-out interrupt flag and executes the user-defined task function if the flag is set.
  * After executing the task function, it acknowledges the Timer 0A interrupt and clears it.
+ * With HAL_BIND_TIMER_0A set (HAL.h), the PMOD ENC driver defines this handler as its tick task instead.
  *
  * @param None
  *
@@ -10,6 +10,12 @@
 */
 
 #include "Timer_0B_Interrupt.h"
+#include "Clock.h"
+#include "HAL.h"
+
+// Timer 0B counts at 1 MHz and its periodic interval is 1 ms
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_TICK_VALID(1000000), timer_0b_tick);
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_PERIOD_VALID(1000), timer_0b_period);
 
 // Declare a pointer to the user-defined task
 void (*Timer_0B_Task)(void);
@@ -29,7 +35,7 @@ void Timer_0B_Interrupt_Init(void(*task)(void))
 
     TIMER0->TBPR &= ~0x000000FF;
 
-    TIMER0->TBPR = 50;
+    TIMER0->TBPR = CLOCK_TIMER_PRESCALE(1000000);
 
     TIMER0->TBILR = (1000 - 1);
 
@@ -37,18 +43,19 @@ void Timer_0B_Interrupt_Init(void(*task)(void))
 
     TIMER0->IMR |= 0x100;
 
-		NVIC->IPR[5] = (NVIC->IPR[5] & 0x000000E0) | (1 << 7); 
-
-    NVIC->ISER[0] |= (1 << 20);
+    // The priority of IRQ 20 is set and the IRQ is enabled by Interrupts_Init (Interrupts.h)
 
     TIMER0->CTL |= 0x100;
 }
 
+// With HAL_BIND_TIMER_0B set, the vector runs the task bound to it at compile time instead
+#if !HAL_BIND_TIMER_0B
 void TIMER0B_Handler(void)
 {
-	if (TIMER0->MIS & 0x0100)
+	if (HAL_Timer_Pending(HAL_TIMER_0B))
 	{
 		(*Timer_0B_Task)();
-		TIMER0->ICR |= 0x100;
+		HAL_Timer_Clear(HAL_TIMER_0B);
 	}
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -22,9 +22,9 @@ extern void (*Timer_0B_Task)(void);
 * @brief Initializes the Timer 0B peripheral to generate periodic interrupts.
 *
 * This function initializes the Timer 0B peripheral to generate periodic interrupts for executing a user-defined task.
-* It configures Timer 0B with a 1 ms interval using the 5OMHz system clock source.
+* It configures Timer 0B with a 1 ms interval, using a prescale derived from CLOCK_SYSTEM_HZ (Clock.h).
 * The provided task function will be executed whenever Timer 0B generates an interrupt.
-* The priority level is set to 1.
+* The priority level is set by Interrupts_Init (Interrupts.h).
 *
 * @param task A pointer to the user-defined function to be executed upon Timer 0B interrupt.
 *
@@ -38,6 +38,7 @@ void Timer_0B_Interrupt_Init(void(*task)(void));
 * This function is the interrupt service routine (ISR) for the Timer 0B peripheral.
 * It checks the Timer 0B time-out interrupt flag and executes the user-defined task function if the flag is set.
 * After executing the task function, it acknowledges the Timer 0B interrupt and clears it.
+* With HAL_BIND_TIMER_0B set (HAL.h), the PWM_PF1 driver defines this handler as its heartbeat task instead.
 *
 * @param None
 *
@@ -7,7 +7,7 @@
 * It uses the Timer 1A module to generate periodic interrupts.
 *
 * @note Timer 1A has been configured to generate periodic interrupts every 1 ms
-* for the Timers lab. This driver assumes that the system clock's frequency is 50 MHz.
+* for the Timers lab. The prescale value is derived from the system clock frequency in Clock.h.
 *
 * Refer to Table 2-9 (Interrupts) on pages 104 - 106 from the TM4C123G Microcontroller Datasheet
 * to view the Vector Number, Interrupt Request (IRO) Number, and the Vector Address
@@ -17,6 +17,13 @@
 */
 
 #include "Timer_1A_Interrupt.h"
+#include "Clock.h"
+#include "Interrupts.h"
+#include "HAL.h"
+
+// Timer 1A counts at 1 MHz and its periodic interval is 1 ms
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_TICK_VALID(1000000), timer_1a_tick);
+CLOCK_STATIC_ASSERT(CLOCK_TIMER_PERIOD_VALID(1000), timer_1a_period);
 
 // Declare a pointer to the user-defined task
 void (*Timer_1A_Task)(void);
@@ -44,10 +51,10 @@ void Timer_1A_Interrupt_Init(void(*task)(void))
     // GPTMTAPR register before setting the prescale value
     TIMER1->TAPR &= ~0x000000FF;
 
-    // Set the prescale value to 50 by setting the bits of the
+    // Set the prescale value by setting the bits of the
     // TAPSR field (Bits 7 to 0) in the GPTMTAPR register
-    // New timer clock frequency = (50 MHz / 50) = 1 MHz
-    TIMER1->TAPR = 50;
+    // New timer clock frequency = (CLOCK_SYSTEM_HZ / (prescale value + 1)) = 1 MHz
+    TIMER1->TAPR = CLOCK_TIMER_PRESCALE(1000000);
 
     // Set the timer interval load value by writing to the
     // TAILR field (Bits 31 to 0) in the GPTMTAILR register
@@ -61,29 +68,29 @@ void Timer_1A_Interrupt_Init(void(*task)(void))
     // Enable the Timer 1A interrupt by setting the TATOIM bit (Bit 0) in the GPTMIMR register
     TIMER1->IMR |= 0x01;
 
-    // Set the priority level to 2 for the Timer 1A interrupt
-    // In the Interrupt 1619 Priority (PRI4) register,
-    // the INTPD field (Bits 15 to 13) (CHANGE) corresponds to Interrupt Request (IRQ) 19
-    // Timer 1A has an IRQ of 21
-		// E000 bc clearing bits 15-13, 1st 0 is bits 0-3, 2nd is 4-7, 3rd is 8-11, 4th is 12-15, go until 28-31
-    NVIC->IPR[5] = (NVIC->IPR[5] & 0x0000E000) | (1 << 13); // 5 b/c PRI5
-
-    // Enable IRQ 21 for Timer 1A by setting Bit 21 in the ISER[0] register
-    NVIC->ISER[0] |= (1 << 21);
+    // The priority of IRQ 21 is set and the IRQ is enabled by Interrupts_Init (Interrupts.h)
 
     // Set the TAEN bit (Bit 0) in the GPTMCTL register to enable Timer 1A
     TIMER1->CTL |= 0x01;
 }
 
+void Timer_1A_Interrupt_Init_Direct(void(*handler)(void))
+{
+    Timer_1A_Interrupt_Init(handler);
+
+    // Run the handler from the Timer 1A vector, without the task pointer
+    Interrupts_Set_Handler(TIMER1A_IRQn, handler);
+}
+
 void TIMER1A_Handler(void)
 {
 	// Read the Timer 1A time-out interrupt flag
-	if (TIMER1->MIS & 0x01)
+	if (HAL_Timer_Pending(HAL_TIMER_1A))
 	{
 		// Execute the user-defined function
 		(*Timer_1A_Task)();
 		
 		// Acknowledge the Timer 1A interrupt and clear it
-		TIMER1->ICR |= 0x01;
+		HAL_Timer_Clear(HAL_TIMER_1A);
 	}
 }
\ No newline at end of file
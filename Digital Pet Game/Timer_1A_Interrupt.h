@@ -7,7 +7,7 @@
 * It uses the Timer 1A module to generate periodic interrupts.
 *
 * @note Timer 1A has been configured to generate periodic interrupts every 1 ms
-* for the Timers lab. This driver assumes that the system clock's frequency is 50 MHz.
+* for the Timers lab. The prescale value is derived from the system clock frequency in Clock.h.
 *
 * Refer to Table 2-9 (Interrupts) on pages 104 - 106 from the TM4C123G Microcontroller Datasheet
 * to view the Vector Number, Interrupt Request (IRO) Number, and the Vector Address
@@ -25,9 +25,9 @@ extern void (*Timer_1A_Task)(void);
 * @brief Initializes the Timer 1A peripheral to generate periodic interrupts.
 *
 * This function initializes the Timer 1A peripheral to generate periodic interrupts for executing a user-defined task.
-* It configures Timer 1A with a 1 ms interval using the 5OMHz system clock source.
+* It configures Timer 1A with a 1 ms interval, using a prescale derived from CLOCK_SYSTEM_HZ (Clock.h).
 * The provided task function will be executed whenever Timer 1A generates an interrupt.
-* The priority level is set to 1.
+* The priority level is set by Interrupts_Init (Interrupts.h).
 *
 * @param task A pointer to the user-defined function to be executed upon Timer 1A interrupt.
 *
@@ -35,6 +35,20 @@ extern void (*Timer_1A_Task)(void);
 */
 void Timer_1A_Interrupt_Init(void(*task)(void));
 
+/**
+* @brief Initializes the Timer 1A peripheral to run a handler straight from its vector every 1 ms.
+*
+* This function calls Timer_1A_Interrupt_Init and then installs the handler in the Timer 1A vector with
+* Interrupts_Set_Handler (Interrupts.h), so no task pointer is called. The handler must clear the
+* time-out interrupt with HAL_Timer_Clear(HAL_TIMER_1A) (HAL.h). With the vector table in the flash memory, the
+* handler is executed as the task of TIMER1A_Handler instead.
+*
+* @param handler A pointer to the handler to be executed upon Timer 1A interrupt.
+*
+* @return None
+*/
+void Timer_1A_Interrupt_Init_Direct(void(*handler)(void));
+
 /**
 * @brief The interrupt service routine (ISR) for Timer 1A.
 *
@@ -5,352 +5,995 @@
  *
  * This file implements the virtual pet gameplay system, including the LCD menu,
  * difficulty selection using the PMOD rotary encoder, the LED hunger bar, heartbeat
- * LED via software PWM, and the seven-segment survival timer. Periodic timers handle
- * hunger decay and timing updates. 
+ * LED via software PWM, and the seven-segment survival timer. The hunger level and the
+ * survival time are computed from the pet clock (Pet_Clock.h) when they are displayed, so they
+ * do not depend on a periodic tick. The pet clock runs from the Hibernation module RTC and
+ * slows down at night while the pet sleeps. Animations and timeouts use the Timebase.
+ *
+ * The game flow is a hierarchical state machine (State_Machine.h) driven by the button
+ * gestures, the PMOD ENC switch and the pet simulation:
+ *
+ *   Menu            Rotate to select a level or the pet gallery, press to select
+ *   Pet Gallery     Plays the turtle animation, then returns to the menu
+ *   Game            Left when the game ends: the game outputs are turned off
+ *     Intro         Shows the survival time of the level for INTRO_MS
+ *     Active        Starts the game of the selected level
+ *       Playing     Press to feed, double-click to play, long press to wash, switch on to pause
+ *       Paused      Hunger and the survival time are frozen. Switch off to resume, long press to quit
+ *     Over          Press to return to the menu
+ *       Won         Flashes the hunger bar
+ *       Lost
+ *
+ * Returning to the menu only restores what the game changed: the menu arrow is loaded into the
+ * LCD again if a pet drawing replaced it, and the menu is redrawn with the last selected item.
+ *
+ * The selected menu item and the game in progress are saved in the EEPROM (Save.h) whenever they
+ * change, at most once every SAVE_INTERVAL_MS. After a reset, a saved game continues where it was
+ * saved, paused if the PMOD ENC switch is on, and otherwise the menu shows the saved selection.
+ * A game that was not paused keeps going while the board is off: it is loaded at the pet clock of
+ * its checkpoint and advanced to the pet clock now in a single Pet_Sim_Step.
+ *
+ * Every finished game is appended to the lifetime statistics log in the flash memory (Stats_Log.h).
+ * The game over screen shows the result and the totals of the level in turn.
+ *
+ * At reset, the LCD power-on sequence runs in the background while the other peripherals are
+ * initialized and the saved data is read. Meanwhile, the hunger bar fills up and the seven-segment
+ * display shows its test pattern. The game starts as soon as the LCD is ready.
+ *
+ * The work of each main loop period runs in the burst clock profile (PLL), and the wait until the
+ * next period in the idle profile (PIOSC with the PLL powered down), except in the menu where the
+ * knob velocity needs the PMOD ENC capture at the burst clock (Power.h).
 
  * @author Anna Bagdishyan and Mario Perez
  */
  
+#include <string.h>
+
 #include "TM4C123GH6PM.h"
+#include "Clock.h"
 #include "SysTick_Delay.h"
 #include "GPIO.h"
 #include "EduBase_LCD.h"
 #include "PMOD_ENC.h"
-#include "Timer_0A_Interrupt.h"
 #include "Timer_1A_Interrupt.h"
 #include "Timer_0B_Interrupt.h"
 #include "PWM_PF1.h"
 #include "Seven_Segment_Display.h"
 #include "Pets.h"
+#include "BCM_LED.h"
+#include "Timebase.h"
+#include "Gesture.h"
+#include "Levels.h"
+#include "Pet_Sim.h"
+#include "Pet_Stats.h"
+#include "State_Machine.h"
+#include "Seqlock.h"
+#include "Save.h"
+#include "Stats_Log.h"
+#include "Pet_Clock.h"
+#include "Power.h"
+#include "Interrupts.h"
+#include "HAL.h"
+
+
+// The main menu lists every difficulty level followed by the "DISPLAY PET" item
+#define DISPLAY_PET_LABEL "DISPLAY PET"
+
+// Time the main loop waits after the work of each period
+#define MAIN_LOOP_WAIT_MS 50
 
+// Size of the RAM buffer that records the PMOD ENC input of the current session,
+// about 1.5 to 2 hours of play (Input_Log.h)
+#define INPUT_LOG_BUFFER_SIZE 16384
 
-#define MAX_COUNT 5
+// A press less than this after a turn of the knob, or followed by a turn before it is handled, is
+// not taken as a menu selection, because pushing the knob often turns it by one detent
+#define MENU_SETTLE_MS 150
+
+// Format version of Saved_Game, which must change whenever Saved_Game changes
+#define SAVED_GAME_VERSION 2
+
+// Level of a saved game when no game is in progress
+#define SAVED_NO_GAME 0xFF
+
+// Longest time off the board that a saved game catches up on. Pet_Sim compares times as signed
+// 32-bit differences, and every level has long ended after this time anyway.
+#define CATCH_UP_MAX_MS (20UL * 24 * 3600 * 1000)
+
+// Time each page of the game over screen is shown
+#define OVER_PAGE_MS 2500
+
+// Boot splash shown until the LCD is ready: the seven-segment test pattern, and the hunger bar
+// LEDs filling up one after the other
+#define BOOT_SPLASH_NUMBER 8888
+#define BOOT_SPLASH_FILL_MS 100
+
+// Time the intro message is shown before the game starts
+#define INTRO_MS 3000
+
+// Number of hunger bar toggles and the time between them when the game is won
+#define WIN_FLASH_COUNT 12
+#define WIN_FLASH_MS 200
+
+// Pet gallery animation: number of scroll steps in each direction, time between scroll steps,
+// time the message is shown, and end marker
+#define GALLERY_RIGHT_STEPS 13
+#define GALLERY_LEFT_STEPS 14
+#define GALLERY_SCROLL_MS 300
+#define GALLERY_MESSAGE_MS 1500
+#define GALLERY_DONE 0xFFFFFFFF
+
+// Game states, in the order of the state table
+enum
+{
+	GAME_STATE_TOP = STATE_MACHINE_TOP,
+	GAME_STATE_MENU,
+	GAME_STATE_PET_GALLERY,
+	GAME_STATE_GAME,
+	GAME_STATE_INTRO,
+	GAME_STATE_ACTIVE,
+	GAME_STATE_PLAYING,
+	GAME_STATE_PAUSED,
+	GAME_STATE_OVER,
+	GAME_STATE_WON,
+	GAME_STATE_LOST,
+	GAME_STATE_COUNT
+};
 
-// LED Variables
+// Game events
+enum
+{
+	GAME_EVENT_PRESS,
+	GAME_EVENT_CLICK,
+	GAME_EVENT_DOUBLE_CLICK,
+	GAME_EVENT_LONG_PRESS,
+	GAME_EVENT_SELECT_LEVEL,
+	GAME_EVENT_SELECT_GALLERY,
+	GAME_EVENT_SWITCH_ON,
+	GAME_EVENT_SWITCH_OFF,
+	GAME_EVENT_TIMEOUT,
+	GAME_EVENT_PET_WON,
+	GAME_EVENT_PET_LOST,
+	GAME_EVENT_COUNT
+};
+
+// The game state of the pet is kept by the pet simulation engine with a single pet
+#define PET 0
+static Pet_Sim_Type pet_sim;
+static Hunger_Type pet_hunger[1];
+static uint32_t pet_words[PET_SIM_WORDS_PER_PET];
+static uint8_t pet_status[1];
+
+// Game flow state machine
+static State_Machine_Type game;
+static uint16_t game_dispatch[GAME_STATE_COUNT * GAME_EVENT_COUNT];
+
+// Hunger bar derived from the hunger model at render time
 static uint8_t led_state = 0x00;  // all LEDs off
-static int current_led = 3;       // start from LED3
-static uint32_t led_delay = 1000; // default 1 second
-static uint8_t difficulty_set = 0;
+static uint8_t last_led_fading = 0;
+static const Level_Type *current_level = 0;
+static uint8_t current_level_index = 0;
+
+// Stat digits shown on the LCD
+static uint32_t pet_stats_shown = 0xFFFFFFFF;
 
-static uint32_t ms_counter = 0;
 static uint8_t state = 0;
 static uint8_t last_state = 0;
-static uint8_t pmod_enc_btn_pressed = 0;
+static uint8_t switch_on = 0;
 static int main_menu_counter = 0;
 static int prev_main_menu_counter = -1;
 
-static uint32_t survival_time = 0;	// milliseconds stayed alive
-static uint8_t game_won = 0;
-static uint8_t game_lost = 0;
+// Input state published by the encoder edge task (PMOD_ENC_Task), which is its only writer.
+// The main loop takes a consistent copy once per iteration through a sequence lock.
+typedef struct
+{
+	int menu_selection;
+	uint32_t last_step_ms;
+} Shared_Input;
+static Shared_Input shared_input;
+static Seqlock_Type shared_input_lock;
+static Shared_Input input;
+
+// The knob only moves the menu selection while the menu is shown
+static volatile uint8_t menu_active = 0;
+
+// The pet drawings use the custom character of the menu arrow
+static uint8_t menu_arrow_loaded = 0;
+
+// Time the current timed state was entered, and the progress of its animation
+static uint32_t state_start_ms = 0;
+static uint32_t animation_step = 0;
+static uint32_t animation_next_ms = 0;
+
+// Game saved in the EEPROM: the last checkpoint, or the game restored at reset.
+// A playing game is saved with the pet clock of the checkpoint, and a paused game with 0,
+// since it does not change while it is paused.
+typedef struct
+{
+	uint8_t menu_selection;
+	uint8_t level;
+	uint8_t paused;
+	uint8_t reserved;
+	uint32_t pet_ms;
+	Pet_Sim_Snapshot pet;
+} Saved_Game;
+static Saved_Game saved_game;
+
+// Set when the RTC kept running while the board was off, so a saved game can catch up
+static uint8_t pet_clock_kept = 0;
+
+// Night shown next to the pet stats
+static uint8_t night_shown = 0xFF;
+
+// Set when the game restored at reset must be continued instead of starting a new game
+static uint8_t resume_saved_game = 0;
+
+// Time taken to find and restore the saved game at reset, which can be read with the debugger.
+// The timing variables are volatile, so an optimizing build keeps them although nothing reads them.
+static volatile uint32_t restore_time_us = 0;
+
+// Time taken to rebuild the lifetime statistics from the flash memory at reset
+static volatile uint32_t stats_rebuild_time_us = 0;
+
+// Time from Timebase_Init to the first output (the boot splash) and to the start of the game,
+// which can be read with the debugger
+static volatile uint32_t boot_first_output_us = 0;
+static volatile uint32_t boot_interactive_us = 0;
+
+// Feeds of the current game timed for the statistics: the reaction time of a feed is the time
+// since the hunger bar last lost an LED, without the time spent paused
+static uint32_t timed_feeds = 0;
+static uint32_t reaction_sum_ms = 0;
+static uint32_t led_drop_ms = 0;
+static uint8_t led_drop_pending = 0;
+
+// Result message and page shown by the game over screen
+static char *over_message = 0;
+static uint8_t over_page = 0;
+
+// Recorded PMOD ENC input, which can be read with the debugger to reproduce a session,
+// with the changes lost because it was full and the changes whose time may have wrapped
+static uint8_t input_log[INPUT_LOG_BUFFER_SIZE];
+static volatile uint32_t input_log_dropped = 0;
+static volatile uint32_t input_log_wrapped = 0;
+
+// Hunger bar value currently shown on the EduBase LEDs
+static uint8_t hunger_bar_output = 0x00;
+
+// Mood color of the RGB LED (green and blue) indexed by the number of lit hunger LEDs.
+// The red LED (PF1) shows the heartbeat.
+static const uint8_t mood_green[5] = {0, 0, 0, 120, 255};
+static const uint8_t mood_blue[5] = {0, 40, 255, 160, 0};
 
 void Display_Main_Menu(int menu_state);
 void PMOD_ENC_Task(void);
 
-void Timer_1A_Periodic_Task(void)
+// runs straight from the Timer 1A vector every 1 ms
+INTERRUPTS_RAMFUNC void Timer_1A_Periodic_Task(void)
 {
-	if (!game_won && difficulty_set && !game_lost)
-  {
-		ms_counter++;
-    if (ms_counter >= 1000)
-    {
-			ms_counter = 0;
-			if (survival_time >= 1000)
+	HAL_Timer_Clear(HAL_TIMER_1A);
+	PMOD_ENC_Replay_Tick();
+}
+
+// show the hunger bar and the matching mood color, only when the value changes
+// so that a fade in progress on the last LED is not cancelled
+static void Hunger_Bar_Output(uint8_t leds)
+{
+	if (leds != hunger_bar_output)
+	{
+		uint8_t count = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			if (leds & (1 << i))
 			{
-				survival_time -= 1000;
+				count++;
 			}
-    }
-  }
+		}
+		BCM_LED_Set_Hunger_Bar(leds);
+		BCM_LED_Set_Level(BCM_LED_CHANNEL_PF3, mood_green[count]);
+		BCM_LED_Set_Level(BCM_LED_CHANNEL_PF2, mood_blue[count]);
+		hunger_bar_output = leds;
+	}
 }
 
-// perform refill (reset leds to full) call only when needed
-static void refill_leds_if_allowed(void)
+// show happiness (J), energy (E) and hygiene (C) as digits from 0 to 9 next to the pet
+static void Display_Pet_Stats(uint32_t now_ms)
 {
-  // only refill when at least one LED is currently on
-	if (led_state != 0x00)
-  {
-    led_state = 0x0F;
-    current_led = 3;
-  }
+	Pet_Stats pet_stats = Pet_Sim_Get_Stats(&pet_sim, PET, now_ms);
+	uint32_t shown = 0;
+	
+	for (int stat = PET_STAT_HAPPINESS; stat <= PET_STAT_HYGIENE; stat++)
+	{
+		shown = shown | ((uint32_t)((Pet_Stats_Get(pet_stats, stat) * 10) >> 8) << (stat * 8));
+	}
+	
+	// the LCD is only written when a digit changes
+	if (shown != pet_stats_shown)
+	{
+		pet_stats_shown = shown;
+		
+		EduBase_LCD_Set_Cursor(11, 0);
+		EduBase_LCD_Send_Data('J');
+		EduBase_LCD_Send_Data('0' + Pet_Stats_Get(shown, PET_STAT_HAPPINESS));
+		EduBase_LCD_Send_Data(' ');
+		EduBase_LCD_Send_Data('E');
+		EduBase_LCD_Send_Data('0' + Pet_Stats_Get(shown, PET_STAT_ENERGY));
+		EduBase_LCD_Set_Cursor(11, 1);
+		EduBase_LCD_Send_Data('C');
+		EduBase_LCD_Send_Data('0' + Pet_Stats_Get(shown, PET_STAT_HYGIENE));
+	}
+	
+	// "Zz" while the pet sleeps
+	uint8_t night = Pet_Clock_Is_Night();
+	if (night != night_shown)
+	{
+		night_shown = night;
+		EduBase_LCD_Set_Cursor(14, 1);
+		EduBase_LCD_Display_String(night ? "Zz" : "  ");
+	}
 }
 
-int main(void)
+// derive the hunger bar and the heartbeat from the hunger model at the given pet clock
+// the reaction time of the next feed is timed from an LED drop with the Timebase
+static void Render_Hunger(uint32_t now_ms)
 {
-  SysTick_Delay_Init();
-  EduBase_LCD_Init();
-  EduBase_LEDs_Init();
-  RGB_LED_Init();
-  PMOD_ENC_Init();
-	Seven_Segment_Display_Init();
+	uint8_t last_led_state = led_state;
+	
+	led_state = Hunger_Get_LEDs(Pet_Sim_Get_Hunger(&pet_sim, PET, now_ms));
+	if (led_state < last_led_state)
+	{
+		led_drop_ms = Timebase_Get_Ms();
+		led_drop_pending = 1;
+	}
+	Hunger_Bar_Output(led_state);
+	PF1_PWM_Update_Duty_Cycle(led_state);
+	
+	// fade out the last LED over the time left instead of turning it off at once
+	if (led_state == 0x01 && Pet_Sim_Get_Status(&pet_sim, PET) == PET_SIM_PLAYING)
+	{
+		if (!last_led_fading)
+		{
+			uint32_t time_left_ms = Pet_Sim_Get_Hunger_Time_Left(&pet_sim, PET, now_ms);
+			BCM_LED_Fade(BCM_LED_CHANNEL_PB0, BCM_LED_LEVEL_OFF, (uint16_t)(time_left_ms > 0xFFFF ? 0xFFFF : time_left_ms));
+			last_led_fading = 1;
+		}
+	}
+	else
+	{
+		last_led_fading = 0;
+	}
+}
 
-  Timer_0A_Interrupt_Init(&PMOD_ENC_Task);
-  last_state = PMOD_ENC_Get_State();
+// shows a two-line message on a cleared LCD
+static void Display_Message(char *line0, char *line1)
+{
+	EduBase_LCD_Clear_Display();
+	EduBase_LCD_Set_Cursor(0, 0);
+	EduBase_LCD_Display_String(line0);
+	if (line1)
+	{
+		EduBase_LCD_Set_Cursor(0, 1);
+		EduBase_LCD_Display_String(line1);
+	}
+}
+
+// draws the pet of the current level, which replaces the menu arrow character
+static void Display_Pet(void)
+{
+	current_level->pet_display();
+	menu_arrow_loaded = 0;
+	pet_stats_shown = 0xFFFFFFFF;
+	night_shown = 0xFF;
+}
+
+// Menu: the menu is redrawn by its update activity whenever the selection changes
+static void Menu_Entry(void)
+{
+	if (!menu_arrow_loaded)
+	{
+		EduBase_LCD_Create_Custom_Character(RIGHT_ARROW_LOCATION, right_arrow);
+		menu_arrow_loaded = 1;
+	}
+	prev_main_menu_counter = -1;
+	menu_active = 1;
+}
+
+static void Menu_Exit(void)
+{
+	menu_active = 0;
+}
+
+static void Menu_Update(void)
+{
+	if (prev_main_menu_counter != input.menu_selection)
+	{
+		EduBase_LCD_Clear_Display();
+		Display_Main_Menu(input.menu_selection);
+		prev_main_menu_counter = input.menu_selection;
+	}
+}
+
+static void Select_Level(void)
+{
+	current_level_index = (uint8_t)input.menu_selection;
+	current_level = Levels_Get(current_level_index);
+}
+
+// draws the three turtle characters starting at the given column of the first row
+static void Display_Turtle_At(uint8_t col)
+{
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		EduBase_LCD_Set_Cursor(col + i, 0);
+		EduBase_LCD_Send_Data(i);
+	}
+}
+
+// shows one step of the moonwalk animation and returns the time until the next step
+static uint32_t Pet_Gallery_Step(uint32_t step)
+{
+	if (step == 0)
+	{
+		Turtle_Display();
+		EduBase_LCD_Clear_Display();
+		Display_Turtle_At(0);
+		return GALLERY_SCROLL_MS;
+	}
+	if (step <= GALLERY_RIGHT_STEPS)
+	{
+		EduBase_LCD_Scroll_Display_Right();
+		return GALLERY_SCROLL_MS;
+	}
+	if (step == GALLERY_RIGHT_STEPS + 1)
+	{
+		Display_Message("Moonwalk!", 0);
+		return GALLERY_MESSAGE_MS;
+	}
+	if (step == GALLERY_RIGHT_STEPS + 2)
+	{
+		EduBase_LCD_Clear_Display();
+		Turtle_Display();
+		Display_Turtle_At(14);
+		return 0;
+	}
+	if (step <= GALLERY_RIGHT_STEPS + 2 + GALLERY_LEFT_STEPS)
+	{
+		EduBase_LCD_Scroll_Display_Left();
+		return GALLERY_SCROLL_MS;
+	}
+	return GALLERY_DONE;
+}
+
+// Pet gallery: the animation runs one step at a time so that the main loop keeps running
+static void Pet_Gallery_Entry(void)
+{
+	menu_arrow_loaded = 0;
+	animation_step = 0;
+	animation_next_ms = Timebase_Get_Ms();
+}
+
+static void Pet_Gallery_Update(void)
+{
+	uint32_t now_ms = Timebase_Get_Ms();
 	
-	PF1_PWM_Init();
+	if ((int32_t)(now_ms - animation_next_ms) >= 0)
+	{
+		uint32_t delay_ms = Pet_Gallery_Step(animation_step++);
+
+		if (delay_ms == GALLERY_DONE)
+		{
+			EduBase_LCD_Clear_Display();
+			State_Machine_Dispatch(&game, GAME_EVENT_TIMEOUT);
+			return;
+		}
+		animation_next_ms = now_ms + delay_ms;
+	}
+}
+
+// Game: leaving the game turns off every game output
+static void Game_Exit(void)
+{
+	Pet_Sim_Stop(&pet_sim, PET);
+	Hunger_Bar_Output(0x00);
 	PF1_PWM_Update_Duty_Cycle(0);
-	Timer_1A_Interrupt_Init(&Timer_1A_Periodic_Task);
-	EduBase_LCD_Create_Custom_Character(RIGHT_ARROW_LOCATION, right_arrow);
+	last_led_fading = 0;
+	Seven_Segment_Display(0);
+}
+
+static void Intro_Entry(void)
+{
+	Display_Message("Keep Pet Alive", "For ");
+	EduBase_LCD_Display_Integer((int)(current_level->survival_ms / 1000));
+	EduBase_LCD_Display_String(" Seconds!");
+	state_start_ms = Timebase_Get_Ms();
+}
+
+static void Intro_Update(void)
+{
+	if ((Timebase_Get_Ms() - state_start_ms) >= INTRO_MS)
+	{
+		State_Machine_Dispatch(&game, GAME_EVENT_TIMEOUT);
+	}
+}
+
+// Active: the hunger bar and the survival time start counting down once the pet is shown
+static void Active_Entry(void)
+{
+	PF1_PWM_Set_Curve(current_level->heartbeat_curve);
+	Display_Pet();
+	uint32_t now_ms = Pet_Clock_Get_Ms();
 	
-	while (1)
+	if (resume_saved_game)
+	{
+		// a game that was playing is loaded at its checkpoint and catches up on the time off
+		uint32_t off_ms = now_ms - saved_game.pet_ms;
+		uint8_t catch_up = pet_clock_kept && !saved_game.paused && off_ms <= CATCH_UP_MAX_MS;
+		
+		Pet_Sim_Load(&pet_sim, PET, &saved_game.pet, catch_up ? saved_game.pet_ms : now_ms);
+		Pet_Sim_Step(&pet_sim, now_ms);
+		resume_saved_game = 0;
+	}
+	else
+	{
+		Pet_Sim_Start(&pet_sim, PET, current_level->decay_ms, current_level->survival_ms,
+			current_level->stats_decay, now_ms);
+	}
+	
+	led_state = Hunger_Get_LEDs(Pet_Sim_Get_Hunger(&pet_sim, PET, now_ms));
+	timed_feeds = 0;
+	reaction_sum_ms = 0;
+	led_drop_pending = 0;
+}
+
+// Playing: the hunger bar and the survival time are computed from the time now,
+// so they stay exact however long the loop takes
+static void Playing_Update(void)
+{
+	uint32_t now_ms = Pet_Clock_Get_Ms();
+
+	Pet_Sim_Step(&pet_sim, now_ms);
+	Render_Hunger(now_ms);
+	Display_Pet_Stats(now_ms);
+
+	// show the survival time left in seconds, rounded up
+	Seven_Segment_Display((Pet_Sim_Get_Survival_Time_Left(&pet_sim, PET, now_ms) + 999) / 1000);
+
+	if (Pet_Sim_Get_Status(&pet_sim, PET) == PET_SIM_LOST)
+	{
+		State_Machine_Dispatch(&game, GAME_EVENT_PET_LOST);
+	}
+	else if (Pet_Sim_Get_Status(&pet_sim, PET) == PET_SIM_WON)
 	{
-		// menu display
-		if (!difficulty_set)
+		State_Machine_Dispatch(&game, GAME_EVENT_PET_WON);
+	}
+}
+
+// restore the number of LEDs given by the level, up to a full hunger bar
+// feeding is only allowed while the pet is still alive
+static void Feed(void)
+{
+	uint32_t now_ms = Pet_Clock_Get_Ms();
+
+	if (Pet_Sim_Feed(&pet_sim, PET, current_level->refill_leds * HUNGER_ONE_LED, now_ms))
+	{
+		if (led_drop_pending)
 		{
-			if (prev_main_menu_counter != main_menu_counter)
-			{
-				EduBase_LCD_Clear_Display();
-				Display_Main_Menu(main_menu_counter);
-				prev_main_menu_counter = main_menu_counter;
-			}
+			timed_feeds++;
+			reaction_sum_ms += Timebase_Get_Ms() - led_drop_ms;
+			led_drop_pending = 0;
 		}
-		if (pmod_enc_btn_pressed)
+		Render_Hunger(now_ms);
+	}
+}
+
+static void Play(void)
+{
+	Pet_Sim_Play(&pet_sim, PET);
+}
+
+static void Wash(void)
+{
+	Pet_Sim_Wash(&pet_sim, PET);
+}
+
+// Paused: the last hunger LED stops fading at its current brightness
+static void Paused_Entry(void)
+{
+	Pet_Sim_Pause(&pet_sim, PET, Pet_Clock_Get_Ms());
+	BCM_LED_Set_Level(BCM_LED_CHANNEL_PB0, BCM_LED_Get_Level(BCM_LED_CHANNEL_PB0));
+	last_led_fading = 0;
+	Display_Message("PAUSED", "Hold to quit");
+	state_start_ms = Timebase_Get_Ms();
+}
+
+static void Paused_Exit(void)
+{
+	Pet_Sim_Resume(&pet_sim, PET, Pet_Clock_Get_Ms());
+	led_drop_ms += Timebase_Get_Ms() - state_start_ms;
+}
+
+// append the finished game to the lifetime statistics of its level
+static void Record_Game(uint8_t result)
+{
+	Stats_Log_Game record;
+	uint32_t reaction_ms = timed_feeds ? (reaction_sum_ms / timed_feeds) : 0;
+	
+	record.level = current_level_index;
+	record.result = result;
+	record.feeds = (uint16_t)timed_feeds;
+	record.reaction_ms = (uint16_t)(reaction_ms > 0xFFFF ? 0xFFFF : reaction_ms);
+	record.survival_s = (uint16_t)((current_level->survival_ms -
+		Pet_Sim_Get_Survival_Time_Left(&pet_sim, PET, Pet_Clock_Get_Ms())) / 1000);
+	Stats_Log_Append(&record);
+}
+
+// quitting from the pause is recorded as a game that was neither won nor lost
+static void Quit_Game(void)
+{
+	Record_Game(STATS_LOG_QUIT);
+}
+
+// shows the wins, the games played, the best survival time and the average feed reaction
+// time of the level, from the totals kept in RAM by the statistics log
+static void Display_Level_Stats(void)
+{
+	const Stats_Log_Level *stats = Stats_Log_Get_Level(current_level_index);
+	
+	EduBase_LCD_Clear_Display();
+	EduBase_LCD_Set_Cursor(0, 0);
+	EduBase_LCD_Display_String("Won ");
+	EduBase_LCD_Display_Integer(stats->wins);
+	EduBase_LCD_Display_String("/");
+	EduBase_LCD_Display_Integer(stats->games);
+	EduBase_LCD_Set_Cursor(0, 1);
+	EduBase_LCD_Display_String("Best ");
+	EduBase_LCD_Display_Integer(stats->best_survival_s);
+	EduBase_LCD_Display_String("s R");
+	EduBase_LCD_Display_Integer((int)Stats_Log_Get_Average_Reaction(current_level_index));
+	EduBase_LCD_Display_String("ms");
+}
+
+// Over: the result and the statistics of the level are shown in turn
+static void Over_Start(char *message, uint8_t result)
+{
+	Record_Game(result);
+	over_message = message;
+	over_page = 0;
+	state_start_ms = Timebase_Get_Ms();
+	Display_Message(over_message, "Press for menu");
+}
+
+static void Over_Update(void)
+{
+	uint32_t now_ms = Timebase_Get_Ms();
+	
+	if ((now_ms - state_start_ms) >= OVER_PAGE_MS && Stats_Log_Get_Level(current_level_index))
+	{
+		over_page = !over_page;
+		state_start_ms = now_ms;
+		if (over_page)
 		{
-			pmod_enc_btn_pressed = 0;
-			if (!difficulty_set && main_menu_counter == 5)
-			{
-				Turtle_Display();
-								
-				EduBase_LCD_Clear_Display();
-				EduBase_LCD_Set_Cursor(0, 0);
-				EduBase_LCD_Send_Data(0x00);
-				EduBase_LCD_Set_Cursor(1, 0);
-				EduBase_LCD_Send_Data(0x01);
-				EduBase_LCD_Set_Cursor(2, 0);
-				EduBase_LCD_Send_Data(0x02);
-				SysTick_Delay1ms(300);
-						
-				for (int i = 0; i < 13; i++)
-				{
-					EduBase_LCD_Scroll_Display_Right();
-					SysTick_Delay1ms(300);
-				}
-							
-				EduBase_LCD_Clear_Display();
-				EduBase_LCD_Set_Cursor(0, 0);
-				EduBase_LCD_Display_String("Moonwalk!");
-				SysTick_Delay1ms(1500);
-				EduBase_LCD_Clear_Display();
-							
-				Turtle_Display();
-							
-				EduBase_LCD_Set_Cursor(14, 0);
-				EduBase_LCD_Send_Data(0x00);
-				EduBase_LCD_Set_Cursor(15, 0);
-				EduBase_LCD_Send_Data(0x01);
-				EduBase_LCD_Set_Cursor(16, 0);
-				EduBase_LCD_Send_Data(0x02);
-						
-											
-				for (int i = 0; i < 14; i++)
-				{
-					EduBase_LCD_Scroll_Display_Left();
-					SysTick_Delay1ms(300);
-				}
-								
-				EduBase_LCD_Clear_Display();
-				prev_main_menu_counter = -1;
-							
-				EduBase_LCD_Create_Custom_Character(RIGHT_ARROW_LOCATION, right_arrow);
-				continue;
-			}
-			if (!difficulty_set)
+			Display_Level_Stats();
+		}
+		else
+		{
+			Display_Message(over_message, "Press for menu");
+		}
+	}
+}
+
+static void Won_Entry(void)
+{
+	Over_Start("YOU WIN!", STATS_LOG_WON);
+	animation_step = 0;
+	animation_next_ms = Timebase_Get_Ms();
+}
+
+// flash the hunger bar WIN_FLASH_COUNT / 2 times
+static void Won_Update(void)
+{
+	uint32_t now_ms = Timebase_Get_Ms();
+
+	if (animation_step < WIN_FLASH_COUNT && (int32_t)(now_ms - animation_next_ms) >= 0)
+	{
+		animation_step++;
+		Hunger_Bar_Output((animation_step & 1) ? 0x0F : 0x00);
+		animation_next_ms = now_ms + WIN_FLASH_MS;
+	}
+	Over_Update();
+}
+
+static void Lost_Entry(void)
+{
+	Over_Start("YOU LOSE!", STATS_LOG_LOST);
+}
+
+static const State_Machine_State game_states[GAME_STATE_COUNT] =
+{
+	// name         parent             initial             entry               exit          update
+	{"Top",         GAME_STATE_TOP,    STATE_MACHINE_LEAF, 0,                  0,            0},
+	{"Menu",        GAME_STATE_TOP,    STATE_MACHINE_LEAF, &Menu_Entry,        &Menu_Exit,   &Menu_Update},
+	{"Pet Gallery", GAME_STATE_TOP,    STATE_MACHINE_LEAF, &Pet_Gallery_Entry, 0,            &Pet_Gallery_Update},
+	{"Game",        GAME_STATE_TOP,    GAME_STATE_INTRO,   0,                  &Game_Exit,   0},
+	{"Intro",       GAME_STATE_GAME,   STATE_MACHINE_LEAF, &Intro_Entry,       0,            &Intro_Update},
+	{"Active",      GAME_STATE_GAME,   GAME_STATE_PLAYING, &Active_Entry,      0,            0},
+	{"Playing",     GAME_STATE_ACTIVE, STATE_MACHINE_LEAF, 0,                  0,            &Playing_Update},
+	{"Paused",      GAME_STATE_ACTIVE, STATE_MACHINE_LEAF, &Paused_Entry,      &Paused_Exit, 0},
+	{"Over",        GAME_STATE_GAME,   GAME_STATE_LOST,    0,                  0,            0},
+	{"Won",         GAME_STATE_OVER,   STATE_MACHINE_LEAF, &Won_Entry,         0,            &Won_Update},
+	{"Lost",        GAME_STATE_OVER,   STATE_MACHINE_LEAF, &Lost_Entry,        0,            &Over_Update}
+};
+
+// Events that a state does not list are passed to its parent state
+static const State_Machine_Transition game_transitions[GAME_STATE_COUNT][GAME_EVENT_COUNT] =
+{
+	[GAME_STATE_MENU] =
+	{
+		[GAME_EVENT_SELECT_LEVEL]   = {GAME_STATE_GAME, &Select_Level},
+		[GAME_EVENT_SELECT_GALLERY] = {GAME_STATE_PET_GALLERY, 0}
+	},
+	[GAME_STATE_PET_GALLERY] =
+	{
+		[GAME_EVENT_TIMEOUT]        = {GAME_STATE_MENU, 0}
+	},
+	[GAME_STATE_INTRO] =
+	{
+		[GAME_EVENT_TIMEOUT]        = {GAME_STATE_ACTIVE, 0}
+	},
+	[GAME_STATE_ACTIVE] =
+	{
+		[GAME_EVENT_PET_WON]        = {GAME_STATE_WON, 0},
+		[GAME_EVENT_PET_LOST]       = {GAME_STATE_LOST, 0}
+	},
+	[GAME_STATE_PLAYING] =
+	{
+		[GAME_EVENT_CLICK]          = {STATE_MACHINE_INTERNAL, &Feed},
+		[GAME_EVENT_DOUBLE_CLICK]   = {STATE_MACHINE_INTERNAL, &Play},
+		[GAME_EVENT_LONG_PRESS]     = {STATE_MACHINE_INTERNAL, &Wash},
+		[GAME_EVENT_SWITCH_ON]      = {GAME_STATE_PAUSED, 0}
+	},
+	[GAME_STATE_PAUSED] =
+	{
+		[GAME_EVENT_SWITCH_OFF]     = {GAME_STATE_PLAYING, &Display_Pet},
+		[GAME_EVENT_LONG_PRESS]     = {GAME_STATE_MENU, &Quit_Game}
+	},
+	[GAME_STATE_OVER] =
+	{
+		[GAME_EVENT_PRESS]          = {GAME_STATE_MENU, 0}
+	}
+};
+
+// turn the button gestures queued by the PMOD ENC input tick and the switch into game events
+// a press is handled immediately, but feeding waits for the click, which is only sent once the
+// double-click window has passed, so that a double-click or a long press does not also feed the pet
+static void Poll_Input_Events(void)
+{
+	Gesture_Event event;
+
+	Seqlock_Read(&shared_input_lock, &input, &shared_input, sizeof(input));
+
+	while (Gesture_Get_Event(&event))
+	{
+		if (event.type == GESTURE_PRESS)
+		{
+			// in the menu, the selected item decides what a press does
+			if (State_Machine_Is_In(&game, GAME_STATE_MENU))
 			{
-				difficulty_set = 1;
-				led_state = 0x0F;
-				current_led = 3;
-				game_won = 0;
+				// the snapshot can already hold a step made after the press was debounced, which
+				// gives a negative time and a selection that was not there at the press
+				int32_t since_step_ms = (int32_t)(event.time_ms - input.last_step_ms);
 				
-				EduBase_LCD_Clear_Display();
-				EduBase_LCD_Set_Cursor(0, 0);
-				EduBase_LCD_Display_String("Keep Pet Alive");
-				EduBase_LCD_Set_Cursor(0, 1);
-				EduBase_LCD_Display_String("For 8 Seconds!");
-				SysTick_Delay1ms(3000);
-							
-				survival_time = 8000; // 8 second countdown
-				ms_counter = 0; 
-				
-				switch (main_menu_counter)
+				if (since_step_ms >= MENU_SETTLE_MS)
 				{
-					case 0x00: 
-						led_delay = 1000; // easy
-						Dog_Display();
-						break;
-					case 0x01:
-						led_delay = 500; // medium
-						Crow_Display();
-						break;
-					case 0x02:
-						led_delay = 500; // medium
-						Crow_Display();
-						break;
-					case 0x03:    // hard
-						led_delay = 250; 
-						Cat_Display();
-						break;
-					case 0x04:    // hard
-						led_delay = 250;
-						Cat_Display();									
-						break;
+					State_Machine_Dispatch(&game, (input.menu_selection == Levels_Get_Count()) ?
+						GAME_EVENT_SELECT_GALLERY : GAME_EVENT_SELECT_LEVEL);
 				}
 			}
-			else if (!game_won)
+			else
 			{
-				refill_leds_if_allowed();
+				State_Machine_Dispatch(&game, GAME_EVENT_PRESS);
 			}
 		}
-		if (difficulty_set && !game_won)
+		else if (event.type == GESTURE_CLICK)
 		{
-			EduBase_LEDs_Output(led_state);
-			// update PF1 PWM duty cycle based on current LED state
-			PF1_PWM_Update_Duty_Cycle(led_state);
-			
-			Seven_Segment_Display(survival_time / 1000);
-			if (led_state == 0x00 && !game_won && !game_lost) 
-			{		
-				game_lost = 1;
-				EduBase_LCD_Clear_Display();
-				EduBase_LCD_Set_Cursor(0, 0);
-				EduBase_LCD_Display_String("YOU LOSE!");
-			}		
-			if (survival_time == 0 && !game_lost)   // 10 seconds to win
-			{
-				game_won = 1;
-				// display player has won
-				EduBase_LCD_Clear_Display();
-				EduBase_LCD_Set_Cursor(0, 0);
-				EduBase_LCD_Display_String("YOU WIN!");
-			}
+			State_Machine_Dispatch(&game, GAME_EVENT_CLICK);
 		}
-		// winning condition met, flash leds
-		if (game_won)
+		else if (event.type == GESTURE_DOUBLE_CLICK)
 		{
-			uint8_t leds = 0x00;
-			for (int i = 0; i < 12; i++) //flashes leds 6 times
-			{
-				leds ^= 0x0F;
-				EduBase_LEDs_Output(leds);
-				SysTick_Delay1ms(200);
-			}
-			// stops leds from flashing, ends game
-			while(1);
+			State_Machine_Dispatch(&game, GAME_EVENT_DOUBLE_CLICK);
 		}
-			
-		// only runs while winning condition is not met
-		if (difficulty_set && !game_won)
+		else if (event.type == GESTURE_LONG_PRESS)
 		{
-			if (current_led >= 0)
-			{
-				EduBase_LEDs_Output(led_state);
-				SysTick_Delay1ms(led_delay);
-
-				if (pmod_enc_btn_pressed)
-				{
-						pmod_enc_btn_pressed = 0;
-						refill_leds_if_allowed();
-						EduBase_LEDs_Output(led_state);
-						continue;
-				}
-				// turn off current led
-				led_state &= ~(1 << current_led);
-				current_led--;
-				EduBase_LEDs_Output(led_state);
-				}
+			State_Machine_Dispatch(&game, GAME_EVENT_LONG_PRESS);
 		}
-		SysTick_Delay1ms(50);
+	}
+
+	uint8_t switch_state = PMOD_ENC_Switch_Read(PMOD_ENC_Get_Debounced_State()) ? 1 : 0;
+	if (switch_state != switch_on)
+	{
+		switch_on = switch_state;
+		State_Machine_Dispatch(&game, switch_on ? GAME_EVENT_SWITCH_ON : GAME_EVENT_SWITCH_OFF);
 	}
 }
 
+// take a checkpoint of the selected menu item and of the game in progress when they change
+// Save_Task writes it to the EEPROM later, so the loop never waits for the EEPROM
+static void Checkpoint_Game(void)
+{
+	Saved_Game checkpoint = {0};
+	
+	checkpoint.menu_selection = (uint8_t)input.menu_selection;
+	checkpoint.level = SAVED_NO_GAME;
+	if (State_Machine_Is_In(&game, GAME_STATE_ACTIVE))
+	{
+		uint32_t now_ms = Pet_Clock_Get_Ms();
+		
+		checkpoint.level = current_level_index;
+		checkpoint.paused = (Pet_Sim_Get_Status(&pet_sim, PET) == PET_SIM_PAUSED);
+		checkpoint.pet_ms = checkpoint.paused ? 0 : now_ms;
+		Pet_Sim_Save(&pet_sim, PET, now_ms, &checkpoint.pet);
+	}
+	
+	if (memcmp(&checkpoint, &saved_game, sizeof(checkpoint)) != 0)
+	{
+		saved_game = checkpoint;
+		Save_Checkpoint(&saved_game);
+	}
+}
+
+// restore the saved menu selection and returns the state to start in:
+// the saved game if there is one, or the menu
+static uint8_t Restore_Game(void)
+{
+	uint32_t start_us = Timebase_Get_Us();
+	uint8_t restored = Save_Init(SAVED_GAME_VERSION, sizeof(Saved_Game)) && Save_Restore(&saved_game);
+	
+	restore_time_us = Timebase_Get_Us() - start_us;
+	if (!restored || saved_game.menu_selection > Levels_Get_Count())
+	{
+		saved_game.menu_selection = 0;
+		saved_game.level = SAVED_NO_GAME;
+	}
+	
+	// the knob does not move the selection until the menu is entered, so it can be set here
+	main_menu_counter = saved_game.menu_selection;
+	shared_input.menu_selection = main_menu_counter;
+	input.menu_selection = main_menu_counter;
+	
+	if (saved_game.level < Levels_Get_Count())
+	{
+		current_level_index = saved_game.level;
+		current_level = Levels_Get(current_level_index);
+		resume_saved_game = 1;
+		return switch_on ? GAME_STATE_PAUSED : GAME_STATE_PLAYING;
+	}
+	return GAME_STATE_MENU;
+}
+
+// show the boot splash on the LEDs and the seven-segment display
+static void Boot_Splash_Start(void)
+{
+	for (uint8_t channel = BCM_LED_CHANNEL_PB0; channel <= BCM_LED_CHANNEL_PB3; channel++)
+	{
+		BCM_LED_Fade(channel, BCM_LED_LEVEL_FULL, (uint16_t)((channel + 1) * BOOT_SPLASH_FILL_MS));
+	}
+	Seven_Segment_Display(BOOT_SPLASH_NUMBER);
+	boot_first_output_us = Timebase_Get_Us();
+}
+
+int main(void)
+{
+  Clock_Init();
+  SysTick_Delay_Init();
+  Timebase_Init();
+  Power_Init();
+	Interrupts_Init();
+	EduBase_LCD_Init_Start();
+  EduBase_LEDs_Init();
+  RGB_LED_Init();
+  BCM_LED_Init(BCM_LED_MASK_ALL);
+	Seven_Segment_Display_Init();
+	Boot_Splash_Start();
+  Pet_Sim_Init(&pet_sim, 1, pet_hunger, pet_words, pet_status);
+  PMOD_ENC_Init();
+
+  PMOD_ENC_Record_Start(input_log, INPUT_LOG_BUFFER_SIZE);
+  last_state = PMOD_ENC_Get_State();
+	Seqlock_Init(&shared_input_lock);
+  PMOD_ENC_Interrupt_Init(&PMOD_ENC_Task);
+  PMOD_ENC_Capture_Init();
+	switch_on = PMOD_ENC_Switch_Read(PMOD_ENC_Get_Debounced_State()) ? 1 : 0;
+	
+	PF1_PWM_Init();
+	PF1_PWM_Update_Duty_Cycle(0);
+	Timer_1A_Interrupt_Init_Direct(&Timer_1A_Periodic_Task);
+
+	State_Machine_Init(&game, game_states, GAME_STATE_COUNT, &game_transitions[0][0], GAME_EVENT_COUNT,
+		game_dispatch, &Timebase_Get_Us);
+	uint32_t rebuild_start_us = Timebase_Get_Us();
+	Stats_Log_Init();
+	stats_rebuild_time_us = Timebase_Get_Us() - rebuild_start_us;
+	pet_clock_kept = Pet_Clock_Init();
+	
+	// finish the LCD power-on sequence, refreshing the seven-segment splash between its steps
+	while (!EduBase_LCD_Init_Step())
+	{
+		Seven_Segment_Display(BOOT_SPLASH_NUMBER);
+	}
+	BCM_LED_Set_Hunger_Bar(0x00);
+	Seven_Segment_Display(0);
+	
+	State_Machine_Start(&game, Restore_Game());
+	boot_interactive_us = Timebase_Get_Us();
+	
+	while (1)
+	{
+		Poll_Input_Events();
+		State_Machine_Update(&game);
+		Checkpoint_Game();
+		Save_Task(Timebase_Get_Ms());
+		input_log_dropped = PMOD_ENC_Record_Get_Dropped();
+		input_log_wrapped = PMOD_ENC_Record_Get_Wrapped();
+			
+		Power_Wait_Ms(MAIN_LOOP_WAIT_MS, menu_active ? POWER_PROFILE_BURST : POWER_PROFILE_IDLE);
+	}
+}
+
+// returns the label of a main menu item
+static char *Menu_Item_Label(int item)
+{
+	if (item < Levels_Get_Count())
+	{
+		return (char *)Levels_Get((uint8_t)item)->label;
+	}
+	return DISPLAY_PET_LABEL;
+}
+
 // display the current menu on LCD
+// two items are shown per page, with the arrow next to the selected item
 void Display_Main_Menu(int menu_state)
 {
-  switch(menu_state)
-  {
-		case 0x00:
-    {
-			EduBase_LCD_Set_Cursor(0,0);
-      EduBase_LCD_Send_Data(0x03);
-      EduBase_LCD_Set_Cursor(1,0);
-      EduBase_LCD_Display_String("EASY");
-      EduBase_LCD_Set_Cursor(1,1);
-			EduBase_LCD_Display_String("MEDIUM");
-      break;
-    }
-    case 0x01:
-    {
-      EduBase_LCD_Set_Cursor(0,1);
-      EduBase_LCD_Send_Data(0x03);
-      EduBase_LCD_Set_Cursor(1,0);
-      EduBase_LCD_Display_String("EASY");
-      EduBase_LCD_Set_Cursor(1,1);
-			EduBase_LCD_Display_String("MEDIUM");
-      break;
-    }
-    case 0x02:
-    {
-      EduBase_LCD_Set_Cursor(0,0);
-      EduBase_LCD_Send_Data(0x03);
-      EduBase_LCD_Set_Cursor(1,0);
-      EduBase_LCD_Display_String("MEDIUM");
-			EduBase_LCD_Set_Cursor(1,1);
-      EduBase_LCD_Display_String("HARD");
-      break;
-    }
-		case 0x03:
-    {
-      EduBase_LCD_Set_Cursor(0,1);
-      EduBase_LCD_Send_Data(0x03);
-      EduBase_LCD_Set_Cursor(1,0);
-      EduBase_LCD_Display_String("MEDIUM");
-      EduBase_LCD_Set_Cursor(1,1);
-      EduBase_LCD_Display_String("HARD");
-      break;
-    }
-		case 0x04:
-		{
-			EduBase_LCD_Set_Cursor(0,0);
-      EduBase_LCD_Send_Data(0x03);
-      EduBase_LCD_Set_Cursor(1,0);
-			EduBase_LCD_Display_String("HARD");
-      EduBase_LCD_Set_Cursor(1,1);
-      EduBase_LCD_Display_String("DISPLAY PET");
-      break;
-		}
-		case 0x05:
-		{
-			EduBase_LCD_Set_Cursor(0,1);
-      EduBase_LCD_Send_Data(0x03);
-      EduBase_LCD_Set_Cursor(1,0);
-      EduBase_LCD_Display_String("HARD");
-      EduBase_LCD_Set_Cursor(1,1);
-      EduBase_LCD_Display_String("DISPLAY PET");
-      break;
-		}				
-  }
+	int first_item = menu_state & ~1;
+	
+	for (int row = 0; row < 2 && (first_item + row) <= Levels_Get_Count(); row++)
+	{
+		EduBase_LCD_Set_Cursor(1, row);
+		EduBase_LCD_Display_String(Menu_Item_Label(first_item + row));
+	}
+	
+	EduBase_LCD_Set_Cursor(0, menu_state & 1);
+	EduBase_LCD_Send_Data(RIGHT_ARROW_LOCATION);
 }
 
-void PMOD_ENC_Task(void)
+INTERRUPTS_RAMFUNC void PMOD_ENC_Task(void)
 {
   state = PMOD_ENC_Get_State();
 	
-  // detect button press ALWAYS (even after difficulty is set)
-  if (PMOD_ENC_Button_Read(state) && !PMOD_ENC_Button_Read(last_state))
-  {
-		pmod_enc_btn_pressed = 1;
-  }
-
-  // only allow menu rotation before difficulty is set
+  // only allow menu rotation while the menu is shown
 	// PMOD ENC button can now be used otherwise
-  if (!difficulty_set)
+  if (menu_active)
   {
-		main_menu_counter = main_menu_counter + PMOD_ENC_Get_Rotation(state, last_state);
+		// move faster through the menu when the knob is spun quickly
+		int steps = PMOD_ENC_Accelerate(PMOD_ENC_Decode_Rotation(state, last_state));
+		
+		main_menu_counter = main_menu_counter + steps;
     if (main_menu_counter < 0)
 		{
       main_menu_counter = 0;
 		}
-    else if (main_menu_counter > MAX_COUNT)
+    else if (main_menu_counter > Levels_Get_Count())
 		{
-      main_menu_counter = MAX_COUNT;
+      main_menu_counter = Levels_Get_Count();
+		}
+		
+		// publish the selection and the time of the step together
+		if (steps != 0)
+		{
+			Seqlock_Write_Begin(&shared_input_lock);
+			shared_input.menu_selection = main_menu_counter;
+			shared_input.last_step_ms = Timebase_Get_Ms();
+			Seqlock_Write_End(&shared_input_lock);
 		}
   }
 	last_state = state;
-}
\ No newline at end of file
+}